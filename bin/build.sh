@@ -85,6 +85,7 @@ function cmake_cross_platform()
         -DCMAKE_EXE_LINKER_FLAGS="-fPIC" \
         -DCMAKE_MODULE_LINKER_FLAGS="-fPIC" \
         -DCMAKE_SHARED_LINKER_FLAGS="-fPIC" \
+        -DUSE_DOUBLE_PRECISION="$USE_DOUBLE_PRECISION" \
         || { echo "- ERROR: CMake for Bullet Physics failed."; exit 1; }
 }
 
@@ -42,6 +42,17 @@ function set_multicore_make()
     alias make="make -j$max_cores"
 }
 
+# Bullet and NTRT have to be built with the same precision. This is
+# USE_DOUBLE_PRECISION from build.conf, ON unless it is set to OFF.
+function set_double_precision()
+{
+    source_conf "build.conf"
+    if [ "$USE_DOUBLE_PRECISION" != "OFF" ]; then
+        USE_DOUBLE_PRECISION="ON"
+    fi
+}
+
 if [[ "$script_name" != "setup.sh" ]]; then
     set_multicore_make
+    set_double_precision
 fi
@@ -57,6 +57,20 @@ source_conf "bullet.conf"
 # Variables
 bullet_pkg=`echo $BULLET_URL|awk -F/ '{print $NF}'`  # get the package name from the url
 
+# Check that bullet was built with the precision in build.conf. Builds from
+# before the stamp was written are double precision.
+function check_bullet_precision()
+{
+    built_precision="ON"
+    if [ -f "$BULLET_BUILD_DIR/ntrt_double_precision" ]; then
+        built_precision=`cat "$BULLET_BUILD_DIR/ntrt_double_precision"`
+    fi
+    if [ "$built_precision" == "$USE_DOUBLE_PRECISION" ]; then
+        return $TRUE
+    fi
+    return $FALSE
+}
+
 # Check to see if bullet has been built already
 function check_bullet_built()
 {
@@ -157,7 +171,8 @@ function build_bullet()
     pushd "$BULLET_BUILD_DIR" > /dev/null
 
     # Perform the build
-    # If you turn double precision on, turn it on in inc.CMakeBullet.txt as well for the NTRT build
+    # The precision comes from USE_DOUBLE_PRECISION in build.conf, which
+    # bin/build.sh also passes to the NTRT build
     "$ENV_DIR/bin/cmake" . -G "Unix Makefiles" \
         -DBUILD_SHARED_LIBS=OFF \
         -DBUILD_EXTRAS=ON \
@@ -169,15 +184,17 @@ function build_bullet()
         -DCMAKE_EXE_LINKER_FLAGS="-fPIC" \
         -DCMAKE_MODULE_LINKER_FLAGS="-fPIC" \
         -DCMAKE_SHARED_LINKER_FLAGS="-fPIC" \
-        -DUSE_DOUBLE_PRECISION=ON \
+        -DUSE_DOUBLE_PRECISION="$USE_DOUBLE_PRECISION" \
         -DCMAKE_INSTALL_NAME_DIR="$BULLET_INSTALL_PREFIX" || { echo "- ERROR: CMake for Bullet Physics failed."; exit 1; }
-    #If you turn this on, turn it on in inc.CMakeBullet.txt as well for the NTRT build
     # Additional bullet options: 
     # -DFRAMEWORK=ON
     # -DBUILD_DEMOS=ON
 
     make || { echo "- ERROR: Bullet build failed. Attempting to explicitly make from directory."; make_bullet_local; }
 
+    # Remember the precision so a change in build.conf triggers a rebuild
+    echo "$USE_DOUBLE_PRECISION" > "$BULLET_BUILD_DIR/ntrt_double_precision"
+
     popd > /dev/null
 }
 
@@ -237,6 +254,14 @@ function main()
 
     ensure_install_prefix_writable $BULLET_INSTALL_PREFIX
 
+    if check_bullet_built && ! check_bullet_precision; then
+        echo "- Bullet Physics was built with USE_DOUBLE_PRECISION=$built_precision -- rebuilding."
+        build_bullet
+        install_bullet
+        env_link_bullet
+        return
+    fi
+
     if check_package_installed "$BULLET_INSTALL_PREFIX/lib/libBulletDynamics*"; then
         echo "- Bullet Physics is installed under prefix $BULLET_INSTALL_PREFIX -- skipping."
         ensure_bullet_openglsupport
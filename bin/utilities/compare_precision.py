@@ -0,0 +1,71 @@
+# Copyright 2012, United States Government, as represented by the
+# Administrator of the National Aeronautics and Space Administration.
+# All rights reserved.
+# 
+# The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+# under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+# http://www.apache.org/licenses/LICENSE-2.0.
+# 
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific language
+# governing permissions and limitations under the License.
+
+# Compare two recordings from AppPrismPrecision, normally one from a double
+# and one from a single precision build. Prints how far the rods drift
+# apart over time.
+#
+# Usage: python3 compare_precision.py double.csv single.csv
+
+import math
+import sys
+
+def readRecording(fileName):
+    precision = "unknown"
+    rods = {}
+    with open(fileName) as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("#"):
+                precision = line[1:].strip()
+                continue
+            if not line or line.startswith("time"):
+                continue
+            time, rod, x, y, z = line.split(",")
+            rods[(round(float(time), 6), int(rod))] = (float(x), float(y), float(z))
+    return precision, rods
+
+def main(argv):
+    if len(argv) != 3:
+        print("Usage: python3 %s reference.csv other.csv" % argv[0])
+        return 1
+
+    refPrecision, reference = readRecording(argv[1])
+    otherPrecision, other = readRecording(argv[2])
+    print("Reference: %s (%s), other: %s (%s)" % (argv[1], refPrecision, argv[2], otherPrecision))
+
+    times = sorted(set(key[0] for key in reference if key in other))
+    if not times:
+        print("The recordings have no samples in common")
+        return 1
+
+    print("time,max_distance,mean_distance")
+    worst = 0.0
+    for time in times:
+        distances = []
+        for key in reference:
+            if key[0] == time and key in other:
+                a = reference[key]
+                b = other[key]
+                distances.append(math.sqrt(sum((a[i] - b[i]) ** 2 for i in range(3))))
+        worst = max(worst, max(distances))
+        print("%g,%g,%g" % (time, max(distances), sum(distances) / len(distances)))
+
+    print("Largest distance between the same rod: %g" % worst)
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -29,7 +29,10 @@
 #include "tgTensionController.h"
 #include "core/tgSpringCableActuator.h"
 #include "core/tgBasicActuator.h"
+#include "core/tgSpringCable.h"
 #include "core/tgCast.h"
+// The C++ Standard Library
+#include <stdexcept>
 
 /**
  * The default value for Controller::tgImpedanceController::m_offsetTension
@@ -102,6 +105,39 @@ static inline double determineSetTension(double offset,
   return std::max(static_cast<double>(0.0), offset + displacement + velocity);
 }
 
+/**
+ * The loop of tgImpedanceController::controlBatch. The vectors of a
+ * Batch never overlap, and saying so lets the compiler vectorize without
+ * runtime checks. Same operations in the same order as controlTension
+ * and tgTensionController::control(tgBasicActuator&, ...)
+ */
+static void impedanceKernel(std::size_t n,
+                            const double* __restrict__ offsetTension,
+                            const double* __restrict__ lengthStiffness,
+                            const double* __restrict__ velStiffness,
+                            const double* __restrict__ setLength,
+                            const double* __restrict__ offsetVel,
+                            const double* __restrict__ currentLength,
+                            const double* __restrict__ velocity,
+                            const double* __restrict__ tension,
+                            const double* __restrict__ stiffness,
+                            double* __restrict__ restLength,
+                            double* __restrict__ setTension)
+{
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double tensionTarget =
+          determineSetTension(offsetTension[i],
+                lengthStiffness[i] * (currentLength[i] - setLength[i]),
+                velStiffness[i] * (velocity[i] - offsetVel[i]));
+        setTension[i] = tensionTarget;
+
+        const double diff = (tensionTarget - tension[i]) / stiffness[i];
+        const double newLength = restLength[i] - diff;
+        restLength[i] = newLength < 0.1 ? 0.1 : newLength;
+    }
+}
+
 double
 tgImpedanceController::control(tgBasicController& mLocalController, 
                                  double deltaTimeSeconds,
@@ -184,6 +220,88 @@ tgImpedanceController::controlTension(tgBasicActuator& mBasicActuator,
     return setTension;
 }
 
+std::size_t tgImpedanceController::Batch::add(const tgImpedanceController& controller)
+{
+    offsetTension.push_back(controller.getOffsetTension());
+    lengthStiffness.push_back(controller.getLengthStiffness());
+    velStiffness.push_back(controller.getVelStiffness());
+    setLength.push_back(0.0);
+    offsetVel.push_back(0.0);
+    currentLength.push_back(0.0);
+    velocity.push_back(0.0);
+    tension.push_back(0.0);
+    stiffness.push_back(0.0);
+    restLength.push_back(0.0);
+    setTension.push_back(0.0);
+    return size() - 1;
+}
+
+void tgImpedanceController::Batch::read(const std::vector<tgBasicActuator*>& actuators)
+{
+    if (actuators.size() != size())
+    {
+        throw std::invalid_argument("Batch and actuators differ in size");
+    }
+    currentLength.resize(size());
+    velocity.resize(size());
+    tension.resize(size());
+    stiffness.resize(size());
+    restLength.resize(size());
+    for (std::size_t i = 0; i < actuators.size(); i++)
+    {
+        const tgBasicActuator& actuator = *actuators[i];
+        const tgSpringCable* const pSpringCable = actuator.getSpringCable();
+        currentLength[i] = actuator.getCurrentLength();
+        velocity[i] = actuator.getVelocity();
+        tension[i] = pSpringCable->getTension();
+        stiffness[i] = pSpringCable->getCoefK();
+        restLength[i] = actuator.getRestLength();
+    }
+}
+
+void tgImpedanceController::Batch::apply(const std::vector<tgBasicActuator*>& actuators,
+                                         double deltaTimeSeconds) const
+{
+    if (actuators.size() != restLength.size())
+    {
+        throw std::invalid_argument("Batch and actuators differ in size");
+    }
+    for (std::size_t i = 0; i < actuators.size(); i++)
+    {
+        actuators[i]->setControlInput(restLength[i], deltaTimeSeconds);
+    }
+}
+
+void tgImpedanceController::controlBatch(Batch& batch, double deltaTimeSeconds)
+{
+    if (deltaTimeSeconds <= 0.0)
+    {
+        throw std::runtime_error ("Timestep must be positive.");
+    }
+
+    const std::size_t n = batch.size();
+    if (batch.lengthStiffness.size() != n || batch.velStiffness.size() != n ||
+        batch.setLength.size() != n || batch.offsetVel.size() != n ||
+        batch.currentLength.size() != n || batch.velocity.size() != n ||
+        batch.tension.size() != n || batch.stiffness.size() != n ||
+        batch.restLength.size() != n)
+    {
+        throw std::invalid_argument("Batch vectors differ in size");
+    }
+    batch.setTension.resize(n);
+    if (n == 0)
+    {
+        return;
+    }
+
+    impedanceKernel(n, &batch.offsetTension[0], &batch.lengthStiffness[0],
+                    &batch.velStiffness[0], &batch.setLength[0],
+                    &batch.offsetVel[0], &batch.currentLength[0],
+                    &batch.velocity[0], &batch.tension[0],
+                    &batch.stiffness[0], &batch.restLength[0],
+                    &batch.setTension[0]);
+}
+
 void tgImpedanceController::setOffsetTension(double offsetTension)
 {
         // Precondition
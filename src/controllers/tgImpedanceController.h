@@ -25,6 +25,10 @@
  * $Id$
  */
 
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
 // Forward references
 class tgBasicController;
 class tgBasicActuator;
@@ -92,6 +96,72 @@ class tgImpedanceController
                     double newPosition,
                     double offsetTension,
                     double offsetVel = 0);
+    /**
+     * The gains, set points and sensor readings of a group of
+     * tgBasicActuators under impedance control, one element per
+     * actuator in each vector, for controlBatch.
+     */
+    struct Batch
+    {
+        /**
+         * Append an actuator with controller's gains
+         * @return the index of the new actuator
+         */
+        std::size_t add(const tgImpedanceController& controller);
+
+        std::size_t size() const
+        {
+            return offsetTension.size();
+        }
+
+        /**
+         * Fill in the sensor readings and rest lengths
+         * @param[in] actuators in the same order as the batch
+         */
+        void read(const std::vector<tgBasicActuator*>& actuators);
+
+        /**
+         * Command each actuator to its target rest length, as the
+         * scalar control does
+         */
+        void apply(const std::vector<tgBasicActuator*>& actuators,
+                   double deltaTimeSeconds) const;
+
+        // Gains
+        std::vector<double> offsetTension;
+        std::vector<double> lengthStiffness;
+        std::vector<double> velStiffness;
+
+        // Set points
+        std::vector<double> setLength;
+        std::vector<double> offsetVel;
+
+        // Sensor readings
+        std::vector<double> currentLength;
+        std::vector<double> velocity;
+        std::vector<double> tension;
+        std::vector<double> stiffness;
+
+        /// The current rest lengths, overwritten with the targets
+        std::vector<double> restLength;
+
+        /// Written by controlBatch
+        std::vector<double> setTension;
+    };
+
+    /**
+     * The impedance law and the tension controller's rest length update
+     * for every actuator in batch. Gives bitwise the same set tensions
+     * and targets as controlTension(tgBasicActuator&, ...) per
+     * actuator, but checks deltaTimeSeconds once and runs in a single
+     * loop the compiler can vectorize, with no virtual calls.
+     * @param[in,out] batch
+     * @param[in] deltaTimeSeconds must be positive
+     * @throw std::runtime_error if deltaTimeSeconds is not positive
+     * @throw std::invalid_argument if the vectors differ in size
+     */
+    static void controlBatch(Batch& batch, double deltaTimeSeconds);
+
     /**
      * Set the value of the offset tension property.
      * @param[in] the new value for the offset tension property
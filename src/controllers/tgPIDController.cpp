@@ -33,6 +33,36 @@
 #include <stdexcept>
 #include <cassert>
 
+namespace
+{
+	/**
+	 * The loop of controlBatch. The vectors of a Batch never overlap,
+	 * and saying so lets the compiler vectorize without runtime checks.
+	 * Same operations in the same order as tgPIDController::control(dt)
+	 */
+	void pidKernel(std::size_t n,
+				   double dt,
+				   const double* __restrict__ setPoint,
+				   const double* __restrict__ sensorData,
+				   const double* __restrict__ kP,
+				   const double* __restrict__ kI,
+				   const double* __restrict__ kD,
+				   double* __restrict__ prevError,
+				   double* __restrict__ intError,
+				   double* __restrict__ output)
+	{
+		for (std::size_t i = 0; i < n; i++)
+		{
+			const double error = setPoint[i] - sensorData[i];
+			intError[i] += (error + prevError[i]) / 2.0 * dt;
+			const double dError = (error - prevError[i]) / dt;
+			output[i] = kP[i] * error + kI[i] * intError[i] +
+						kD[i] * dError;
+			prevError[i] = error;
+		}
+	}
+}
+
 tgPIDController::Config::Config(double p,
 									double i,
 									double d,
@@ -109,6 +139,44 @@ void tgPIDController::control(double dt, double setPoint, double sensorData)
 	control(dt);
 }
 
+std::size_t tgPIDController::Batch::add(const Config& config)
+{
+	setPoint.push_back(config.startingSetPoint);
+	sensorData.push_back(0.0);
+	kP.push_back(config.kP);
+	kI.push_back(config.kI);
+	kD.push_back(config.kD);
+	prevError.push_back(0.0);
+	intError.push_back(0.0);
+	output.push_back(0.0);
+	return size() - 1;
+}
+
+void tgPIDController::controlBatch(Batch& batch, double dt)
+{
+	if (dt <= 0.0)
+	{
+		throw std::runtime_error ("Timestep must be positive.");
+	}
+	
+	const std::size_t n = batch.size();
+	if (batch.setPoint.size() != n || batch.sensorData.size() != n ||
+		batch.kI.size() != n || batch.kD.size() != n ||
+		batch.prevError.size() != n || batch.intError.size() != n)
+	{
+		throw std::invalid_argument("Batch vectors differ in size");
+	}
+	batch.output.resize(n);
+	if (n == 0)
+	{
+		return;
+	}
+	
+	pidKernel(n, dt, &batch.setPoint[0], &batch.sensorData[0],
+			  &batch.kP[0], &batch.kI[0], &batch.kD[0],
+			  &batch.prevError[0], &batch.intError[0], &batch.output[0]);
+}
+
 void tgPIDController::setSensorData(double sensorData)
 {
 	/// @todo - are there any sanity checks we can enforce here?
@@ -29,6 +29,10 @@
 
 #include "tgBasicController.h"
 
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
 // Forward declarations
 class tgControllable;
 
@@ -90,6 +94,49 @@ public:
 		const double startingSetPoint;
 	};
 	
+	/**
+	 * The state, gains and inputs of a group of PID loops, one element
+	 * per loop in each vector, for controlBatch. Fill in setPoint and
+	 * sensorData each step; prevError and intError carry over.
+	 */
+	struct Batch
+	{
+		/**
+		 * Append a loop with config's gains and starting setpoint
+		 * and no history
+		 * @return the index of the new loop
+		 */
+		std::size_t add(const Config& config);
+		
+		std::size_t size() const
+		{
+			return kP.size();
+		}
+		
+		std::vector<double> setPoint;
+		std::vector<double> sensorData;
+		std::vector<double> kP;
+		std::vector<double> kI;
+		std::vector<double> kD;
+		std::vector<double> prevError;
+		std::vector<double> intError;
+		/// Written by controlBatch, the input for each controllable
+		std::vector<double> output;
+	};
+	
+	/**
+	 * Run one step of every loop in batch. Gives bitwise the same
+	 * output and history as calling control(dt, setPoint, sensorData)
+	 * on a tgPIDController per loop, but checks dt once and runs in a
+	 * single loop the compiler can vectorize. Applying output is up to
+	 * the caller.
+	 * @param[in,out] batch
+	 * @param[in] dt - the timestep. Must be positive.
+	 * @throw std::runtime_error if dt is not positive
+	 * @throw std::invalid_argument if the vectors differ in size
+	 */
+	static void controlBatch(Batch& batch, double dt);
+	
     /**
      * The only constructor. 
      * @param[in] controllable. The system to be controlled. One to
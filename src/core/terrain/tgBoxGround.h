@@ -32,6 +32,9 @@
  * 
  * Allows for a variety of terrain. As of version 1.0.0, a box ground
  * which can be rotated into a slope is supported in tgBoxGround
+ * 
+ * Apps that switch terrain between episodes should keep their grounds
+ * in a tgTerrainLibrary so each one is only built once.
  */
 #include "tgBulletGround.h"
 
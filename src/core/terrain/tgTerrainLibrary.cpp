@@ -0,0 +1,129 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgTerrainLibrary.cpp
+ * @brief Contains the implementation of class tgTerrainLibrary
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgTerrainLibrary.h"
+// This library
+#include "tgBulletGround.h"
+
+// The C++ Standard Library
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    void writeVector(std::ostream& out, const btVector3& v)
+    {
+        out << v.x() << " " << v.y() << " " << v.z() << " ";
+    }
+
+    /** Full precision, so only identical configs share a ground */
+    std::string configKey(const tgBoxGround::Config& config)
+    {
+        std::ostringstream key;
+        key.precision(17);
+        key << "box ";
+        writeVector(key, config.m_eulerAngles);
+        key << config.m_friction << " " << config.m_restitution << " ";
+        writeVector(key, config.m_size);
+        writeVector(key, config.m_origin);
+        return key.str();
+    }
+
+    std::string configKey(const tgHillyGround::Config& config)
+    {
+        std::ostringstream key;
+        key.precision(17);
+        key << "hilly ";
+        writeVector(key, config.m_eulerAngles);
+        key << config.m_friction << " " << config.m_restitution << " ";
+        writeVector(key, config.m_size);
+        writeVector(key, config.m_origin);
+        key << config.m_nx << " " << config.m_ny << " "
+            << config.m_margin << " " << config.m_triangleSize << " "
+            << config.m_waveHeight << " " << config.m_offset;
+        return key.str();
+    }
+}
+
+tgTerrainLibrary::tgTerrainLibrary()
+{
+}
+
+tgTerrainLibrary::~tgTerrainLibrary()
+{
+    for (std::size_t i = 0; i < m_grounds.size(); i++)
+    {
+        delete m_grounds[i];
+    }
+}
+
+tgTerrainLibrary::Handle tgTerrainLibrary::box(const tgBoxGround::Config& config)
+{
+    const std::string key = configKey(config);
+    std::map<std::string, Handle>::const_iterator it = m_configs.find(key);
+    if (it != m_configs.end())
+    {
+        return it->second;
+    }
+
+    const Handle handle = add(new tgBoxGround(config));
+    m_configs[key] = handle;
+    return handle;
+}
+
+tgTerrainLibrary::Handle tgTerrainLibrary::hilly(const tgHillyGround::Config& config)
+{
+    const std::string key = configKey(config);
+    std::map<std::string, Handle>::const_iterator it = m_configs.find(key);
+    if (it != m_configs.end())
+    {
+        return it->second;
+    }
+
+    const Handle handle = add(new tgHillyGround(config));
+    m_configs[key] = handle;
+    return handle;
+}
+
+tgTerrainLibrary::Handle tgTerrainLibrary::add(tgBulletGround* ground)
+{
+    if (ground == NULL)
+    {
+        throw std::invalid_argument("Ground is NULL");
+    }
+
+    m_grounds.push_back(ground);
+    return m_grounds.size() - 1;
+}
+
+tgBulletGround* tgTerrainLibrary::get(Handle handle) const
+{
+    if (handle >= m_grounds.size())
+    {
+        throw std::out_of_range("No ground with that handle in the terrain library");
+    }
+    return m_grounds[handle];
+}
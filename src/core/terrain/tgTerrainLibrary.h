@@ -0,0 +1,106 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_TERRAIN_LIBRARY_H
+#define TG_TERRAIN_LIBRARY_H
+
+/**
+ * @file tgTerrainLibrary.h
+ * @brief Contains the definition of class tgTerrainLibrary
+ * @author agent
+ * $Id$
+ */
+
+#include "tgBoxGround.h"
+#include "tgHillyGround.h"
+
+// The C++ Standard Library
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class tgBulletGround;
+
+/**
+ * Owns a set of grounds that stay alive for the whole run, so apps that
+ * change terrain between episodes only build each collision shape (and
+ * for hilly ground, the mesh and its BVH) once. Pass a handle to
+ * tgWorld::reset or tgSimulation::reset to switch grounds; the world
+ * only makes a new rigid body around the existing shape.
+ *
+ * Must outlive every tgWorld using one of its grounds.
+ */
+class tgTerrainLibrary
+{
+public:
+
+    /** Index of a ground within the library */
+    typedef std::size_t Handle;
+
+    tgTerrainLibrary();
+
+    /** Deletes all of the grounds */
+    ~tgTerrainLibrary();
+
+    /**
+     * Return the box ground with this config, building it the first
+     * time the config is seen.
+     */
+    Handle box(const tgBoxGround::Config& config);
+
+    /**
+     * Return the hilly ground with this config, building it the first
+     * time the config is seen.
+     */
+    Handle hilly(const tgHillyGround::Config& config);
+
+    /**
+     * Add any other kind of ground. The library takes ownership. Not
+     * deduplicated.
+     * @throw std::invalid_argument if ground is NULL
+     */
+    Handle add(tgBulletGround* ground);
+
+    /**
+     * @throw std::out_of_range if handle was not returned by this library
+     */
+    tgBulletGround* get(Handle handle) const;
+
+    std::size_t size() const
+    {
+        return m_grounds.size();
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgTerrainLibrary(const tgTerrainLibrary&);
+
+    /** Disable the assignment operator. */
+    tgTerrainLibrary& operator=(const tgTerrainLibrary&);
+
+    /** The grounds, indexed by handle */
+    std::vector<tgBulletGround*> m_grounds;
+
+    /** Text form of each config that has been built, see box and hilly */
+    std::map<std::string, Handle> m_configs;
+};
+
+#endif  // TG_TERRAIN_LIBRARY_H
@@ -0,0 +1,271 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgAdaptiveTimestep.cpp
+ * @brief Contains the implementation of class tgAdaptiveTimestep
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgAdaptiveTimestep.h"
+// This application
+#include "tgBulletUtil.h"
+#include "tgCast.h"
+#include "tgModel.h"
+#include "tgSpringCableActuator.h"
+// The Bullet Physics library
+#include "BulletCollision/BroadphaseCollision/btDispatcher.h"
+#include "BulletCollision/NarrowPhaseCollision/btPersistentManifold.h"
+#include "BulletDynamics/Dynamics/btDynamicsWorld.h"
+#include "LinearMath/btQuickprof.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+
+tgAdaptiveTimestep::Config::Config(double minStep,
+                                   double maxStep,
+                                   double clock,
+                                   double tensionTolerance,
+                                   double penetrationTolerance,
+                                   double maxGrowth,
+                                   double safety) :
+minStep(minStep),
+maxStep(maxStep),
+clock(clock),
+tensionTolerance(tensionTolerance),
+penetrationTolerance(penetrationTolerance),
+maxGrowth(maxGrowth),
+safety(safety)
+{
+    if (minStep <= 0.0)
+    {
+        throw std::invalid_argument("minStep is not positive");
+    }
+    else if (maxStep < minStep)
+    {
+        throw std::invalid_argument("maxStep is less than minStep");
+    }
+    else if (clock <= 0.0)
+    {
+        throw std::invalid_argument("clock is not positive");
+    }
+    else if (tensionTolerance <= 0.0)
+    {
+        throw std::invalid_argument("tensionTolerance is not positive");
+    }
+    else if (penetrationTolerance <= 0.0)
+    {
+        throw std::invalid_argument("penetrationTolerance is not positive");
+    }
+    else if (maxGrowth <= 1.0)
+    {
+        throw std::invalid_argument("maxGrowth is not greater than one");
+    }
+    else if (safety <= 0.0 || safety > 1.0)
+    {
+        throw std::invalid_argument("safety is not in (0, 1]");
+    }
+}
+
+tgAdaptiveTimestep::tgAdaptiveTimestep(const Config& config) :
+m_config(config),
+m_stepSize(config.minStep),
+m_revision(0),
+m_haveLengths(false),
+m_touching(-1),
+m_numSteps(0),
+m_totalTime(0.0),
+m_numContactEvents(0)
+{
+}
+
+tgAdaptiveTimestep::~tgAdaptiveTimestep()
+{
+}
+
+void tgAdaptiveTimestep::reset()
+{
+    // Models are rebuilt on reset, so find the cables again
+    m_stepSize = m_config.minStep;
+    m_models.clear();
+    m_cables.clear();
+    m_lengths.clear();
+    m_haveLengths = false;
+    m_touching = -1;
+    m_numSteps = 0;
+    m_totalTime = 0.0;
+    m_numContactEvents = 0;
+}
+
+void tgAdaptiveTimestep::update(const tgWorld& world,
+                                const std::vector<tgModel*>& models,
+                                double lastStep)
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgAdaptiveTimestep::update");
+#endif //BT_NO_PROFILE
+    if (lastStep <= 0.0)
+    {
+        throw std::invalid_argument("lastStep is not positive");
+    }
+
+    m_numSteps++;
+    m_totalTime += lastStep;
+
+    findCables(models);
+
+    // Grow from the proposal, lastStep may have been cut short to land
+    // on the clock
+    const double base = lastStep > m_stepSize ? lastStep : m_stepSize;
+    double step = base * m_config.maxGrowth;
+    const double cables = cableStep(lastStep);
+    if (cables < step)
+    {
+        step = cables;
+    }
+    const double contacts = contactStep(world, lastStep);
+    if (contacts < step)
+    {
+        step = contacts;
+    }
+
+    if (step > m_config.maxStep)
+    {
+        step = m_config.maxStep;
+    }
+    else if (step < m_config.minStep)
+    {
+        step = m_config.minStep;
+    }
+    m_stepSize = step;
+}
+
+void tgAdaptiveTimestep::findCables(const std::vector<tgModel*>& models)
+{
+    if (m_haveLengths && models == m_models &&
+        m_revision == tgModel::getStructureRevision())
+    {
+        return;
+    }
+
+    m_models = models;
+    m_revision = tgModel::getStructureRevision();
+    m_cables.clear();
+    for (std::size_t i = 0; i < models.size(); i++)
+    {
+        const std::vector<tgSpringCableActuator*> cables =
+            tgCast::filter<tgModel, tgSpringCableActuator>(models[i]->getDescendants());
+        m_cables.insert(m_cables.end(), cables.begin(), cables.end());
+    }
+    m_lengths.clear();
+    m_haveLengths = false;
+}
+
+double tgAdaptiveTimestep::cableStep(double lastStep)
+{
+    const std::size_t n = m_cables.size();
+    if (!m_haveLengths)
+    {
+        // No rates until two lengths have been seen
+        m_lengths.resize(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            m_lengths[i] = m_cables[i]->getCurrentLength();
+        }
+        m_haveLengths = true;
+        return m_config.maxStep;
+    }
+
+    // Largest rate of tension change, stiffness times stretch rate
+    double maxTensionRate = 0.0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double length = m_cables[i]->getCurrentLength();
+        const double stretchRate = (length - m_lengths[i]) / lastStep;
+        m_lengths[i] = length;
+
+        // A slack cable's tension doesn't depend on its stretch
+        if (m_cables[i]->getTension() <= 0.0)
+        {
+            continue;
+        }
+        const double tensionRate =
+            m_cables[i]->getConfig().stiffness * std::fabs(stretchRate);
+        if (tensionRate > maxTensionRate)
+        {
+            maxTensionRate = tensionRate;
+        }
+    }
+
+    if (maxTensionRate <= 0.0)
+    {
+        return m_config.maxStep;
+    }
+    return m_config.safety * m_config.tensionTolerance / maxTensionRate;
+}
+
+double tgAdaptiveTimestep::contactStep(const tgWorld& world, double lastStep)
+{
+    btDispatcher* const dispatcher =
+        tgBulletUtil::worldToDynamicsWorld(world).getDispatcher();
+
+    int touching = 0;
+    double maxPenetration = 0.0;
+    const int numManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; i++)
+    {
+        const btPersistentManifold* const manifold =
+            dispatcher->getManifoldByIndexInternal(i);
+        bool touches = false;
+        for (int j = 0; j < manifold->getNumContacts(); j++)
+        {
+            const double distance = manifold->getContactPoint(j).getDistance();
+            if (distance < 0.0)
+            {
+                touches = true;
+                if (-distance > maxPenetration)
+                {
+                    maxPenetration = -distance;
+                }
+            }
+        }
+        if (touches)
+        {
+            touching++;
+        }
+    }
+
+    // More pairs touching than last step is an impact
+    const bool contactEvent = m_touching >= 0 && touching > m_touching;
+    m_touching = touching;
+    if (contactEvent)
+    {
+        m_numContactEvents++;
+        return m_config.minStep;
+    }
+
+    if (maxPenetration <= m_config.penetrationTolerance)
+    {
+        return m_config.maxStep;
+    }
+    // Penetration per step grows with the step
+    return m_config.safety * lastStep *
+           m_config.penetrationTolerance / maxPenetration;
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_ADAPTIVE_TIMESTEP_H
+#define TG_ADAPTIVE_TIMESTEP_H
+
+/**
+ * @file tgAdaptiveTimestep.h
+ * @brief Contains the definition of class tgAdaptiveTimestep
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgModel;
+class tgSpringCableActuator;
+class tgWorld;
+
+/**
+ * Chooses the size of each physics step for tgSimView::run. Give it to
+ * tgSimView::setAdaptiveTimestep.
+ *
+ * After every step it estimates how large the next step can be from
+ * two sources of error:
+ * - Cables: a cable stretching at rate v changes its tension by about
+ *   stiffness * v * dt over the next step. The step is chosen so no
+ *   cable's tension changes by more than tensionTolerance.
+ * - Contacts: when a new pair of objects comes into contact the next
+ *   step is minStep. Otherwise the step shrinks when the deepest
+ *   penetration exceeds penetrationTolerance.
+ * The step never grows by more than maxGrowth at a time and always
+ * stays between minStep and maxStep.
+ *
+ * tgSimView::run shortens steps so they land on every multiple of
+ * clock, on every render and at the end of the run. Controllers and
+ * loggers that act on that clock therefore see the same times they
+ * would with a fixed step, though they are still stepped with each
+ * physics step's dt.
+ *
+ * Tolerances are in the units of the model, so they scale with it like
+ * tgSpringCableActuator::Config does.
+ */
+class tgAdaptiveTimestep
+{
+public:
+
+    struct Config
+    {
+    public:
+        /**
+         * @throw std::invalid_argument if a parameter is out of range
+         */
+        Config(double minStep = 1.0/4000.0,
+               double maxStep = 1.0/250.0,
+               double clock = 1.0/100.0,
+               double tensionTolerance = 1.0,
+               double penetrationTolerance = 0.05,
+               double maxGrowth = 1.25,
+               double safety = 0.9);
+
+        /** Smallest step in seconds, used after contact events. Positive */
+        double minStep;
+
+        /** Largest step in seconds. At least minStep */
+        double maxStep;
+
+        /** Steps land on every multiple of this many seconds. Positive */
+        double clock;
+
+        /** Largest change in any cable's tension per step, in force */
+        double tensionTolerance;
+
+        /** Deepest penetration allowed before the step shrinks, in length */
+        double penetrationTolerance;
+
+        /** Largest ratio between consecutive steps. Greater than one */
+        double maxGrowth;
+
+        /** Fraction of the estimated largest step that is taken. In (0, 1] */
+        double safety;
+    };
+
+    tgAdaptiveTimestep(const Config& config = Config());
+
+    ~tgAdaptiveTimestep();
+
+    /**
+     * Start over at time zero with a step of minStep. Called by
+     * tgSimView::setup, so after every simulation reset.
+     */
+    void reset();
+
+    /**
+     * Measure the step that was just taken and propose the next one.
+     * @param[in] world the world that was stepped
+     * @param[in] models the models that were stepped, searched for cables
+     * @param[in] lastStep the size of the step that was just taken
+     * @throw std::invalid_argument if lastStep is not positive
+     */
+    void update(const tgWorld& world,
+                const std::vector<tgModel*>& models,
+                double lastStep);
+
+    /** The proposed size of the next step, between minStep and maxStep */
+    double getStepSize() const
+    {
+        return m_stepSize;
+    }
+
+    const Config& getConfig() const
+    {
+        return m_config;
+    }
+
+    /** Steps measured since the last reset */
+    std::size_t getNumSteps() const
+    {
+        return m_numSteps;
+    }
+
+    /** Simulated seconds since the last reset */
+    double getTotalTime() const
+    {
+        return m_totalTime;
+    }
+
+    /** Contact events since the last reset */
+    std::size_t getNumContactEvents() const
+    {
+        return m_numContactEvents;
+    }
+
+    /** Mean step since the last reset, zero before the first step */
+    double getMeanStepSize() const
+    {
+        return m_numSteps > 0 ? m_totalTime / m_numSteps : 0.0;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgAdaptiveTimestep(const tgAdaptiveTimestep&);
+
+    /** Disable the assignment operator. */
+    tgAdaptiveTimestep& operator=(const tgAdaptiveTimestep&);
+
+    /** Find the cables again if the model trees changed */
+    void findCables(const std::vector<tgModel*>& models);
+
+    /**
+     * Largest step the cables allow, or maxStep if none are moving.
+     * Also records their lengths for the next step.
+     */
+    double cableStep(double lastStep);
+
+    /**
+     * Largest step the contacts allow, or maxStep if nothing penetrates
+     * too deeply. minStep after a contact event.
+     */
+    double contactStep(const tgWorld& world, double lastStep);
+
+    const Config m_config;
+
+    double m_stepSize;
+
+    /** What the cables were found in */
+    std::vector<tgModel*> m_models;
+
+    /** tgModel::getStructureRevision() when the cables were found */
+    unsigned long m_revision;
+
+    std::vector<tgSpringCableActuator*> m_cables;
+
+    /** Cable lengths after the previous step, parallel to m_cables */
+    std::vector<double> m_lengths;
+
+    /** False until m_lengths holds the lengths of the current cables */
+    bool m_haveLengths;
+
+    /** Touching pairs after the previous step, -1 after a reset */
+    int m_touching;
+
+    std::size_t m_numSteps;
+
+    double m_totalTime;
+
+    std::size_t m_numContactEvents;
+};
+
+#endif // TG_ADAPTIVE_TIMESTEP_H
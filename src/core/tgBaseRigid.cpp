@@ -98,8 +98,7 @@ btVector3 tgBaseRigid::orientation() const
   btScalar pitch = 0.0;
   btScalar roll = 0.0;
   rot.getEulerYPR(yaw, pitch, roll);
-  btVector3 *result = new btVector3(yaw, pitch, roll);
-  return *result;
+  return btVector3(yaw, pitch, roll);
 }
 
 bool tgBaseRigid::invariant() const
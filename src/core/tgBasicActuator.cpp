@@ -106,7 +106,11 @@ void tgBasicActuator::step(double dt)
     {   
         // Want to update any controls before applying forces
         notifyStep(dt); 
-        m_springCable->step(dt);
+        // Otherwise tgCableSubcycler applies the force in substeps
+        if (!m_subcycled)
+        {
+            m_springCable->step(dt);
+        }
         logHistory();  
         tgModel::step(dt);
     }
@@ -50,7 +50,9 @@
 // The C++ Standard Library
 #include <iostream>
 #include <cmath>		// abs
+#include <new>			// placement new
 #include <stdexcept>
+#include <typeinfo>
 
 //#define VERBOSE
 
@@ -79,6 +81,13 @@ tgBulletContactSpringCable::~tgBulletContactSpringCable()
     btCollisionShape* shape = m_ghostObject->getCollisionShape();
     deleteCollisionShape(shape);
     delete m_ghostObject;
+    
+    // tgBulletSpringCable deletes the anchors still in m_anchors
+    for (std::size_t i = 0; i < m_anchorPool.size(); i++)
+    {
+        delete m_anchorPool[i];
+    }
+    m_anchorPool.clear();
 }
 
 const btScalar tgBulletContactSpringCable::getActualLength() const
@@ -309,7 +318,7 @@ void tgBulletContactSpringCable::updateManifolds()
 						if (anchorPos >= 0)
 						{
 							// Not permanent, sliding contact
-							tgBulletSpringCableAnchor* const newAnchor = new tgBulletSpringCableAnchor(rb, pos, m_touchingNormal, false, true, manifold);
+							tgBulletSpringCableAnchor* const newAnchor = newSlidingAnchor(rb, pos, m_touchingNormal, manifold);
 						
 							
 							tgBulletSpringCableAnchor* backAnchor = m_anchors[anchorPos];
@@ -347,7 +356,7 @@ void tgBulletContactSpringCable::updateManifolds()
 							if (del)
 							{
 								/// @todo further examination of whether the anchors should be deleted here
-								delete newAnchor;
+								recycleAnchor(newAnchor);
 							}
 							else
 							{
@@ -373,11 +382,11 @@ void tgBulletContactSpringCable::updateAnchorList()
     
     btScalar startLength = getActualLength();
     
-	while (m_newAnchors.size() > 0)
+	// In the order updateManifolds found them, cleared at the end
+	for (std::size_t k = 0; k < m_newAnchors.size(); k++)
 	{
 		// Not permanent, sliding contact
-		tgBulletSpringCableAnchor* const newAnchor = m_newAnchors[0];
-		m_newAnchors.erase(m_newAnchors.begin());
+		tgBulletSpringCableAnchor* const newAnchor = m_newAnchors[k];
 		
 		btVector3 pos1 = newAnchor->getWorldPosition();
 
@@ -434,11 +443,11 @@ void tgBulletContactSpringCable::updateAnchorList()
             
 			if (del)
 			{
-				delete newAnchor;
+				recycleAnchor(newAnchor);
 			}
 			else if(normalValue1 < 0.0 || normalValue2 < 0.0)
 			{
-				delete newAnchor;
+				recycleAnchor(newAnchor);
 			}
 			else if ((backNormal.dot(contactNormal) < 0.0 && newAnchor->attachedBody == backAnchor->attachedBody) || 
                         (forwardNormal.dot(contactNormal) < 0.0 && newAnchor->attachedBody == forwardAnchor->attachedBody))
@@ -447,7 +456,7 @@ void tgBulletContactSpringCable::updateAnchorList()
                 std::cout << "Deleting based on contact normals! " << backNormal.dot(contactNormal);
                 std::cout << " " << forwardNormal.dot(contactNormal) << std::endl;
 #endif
-                delete newAnchor;
+                recycleAnchor(newAnchor);
             }
 			else
 			{		
@@ -480,9 +489,10 @@ void tgBulletContactSpringCable::updateAnchorList()
 		}
 		else
 		{
-			delete newAnchor;
+			recycleAnchor(newAnchor);
 		}
 	}
+	m_newAnchors.clear();
    
     //std::cout << "contacts " << numContacts << " unprunedAnchors " << m_anchors.size();
     
@@ -797,7 +807,7 @@ bool tgBulletContactSpringCable::deleteAnchor(int i)
 	
 	if (m_anchors[i]->permanent != true)
 	{
-		delete m_anchors[i];
+		recycleAnchor(m_anchors[i]);
 		m_anchors.erase(m_anchors.begin() + i);
 		return true;
 	}
@@ -807,6 +817,39 @@ bool tgBulletContactSpringCable::deleteAnchor(int i)
 	}
 }
 
+tgBulletSpringCableAnchor* tgBulletContactSpringCable::newSlidingAnchor(btRigidBody* rb,
+                                                                        const btVector3& pos,
+                                                                        const btVector3& normal,
+                                                                        btPersistentManifold* manifold)
+{
+	if (m_anchorPool.empty())
+	{
+		return new tgBulletSpringCableAnchor(rb, pos, normal, false, true, manifold);
+	}
+	
+	// Reuse the memory of an anchor that was rejected or pruned
+	tgBulletSpringCableAnchor* const pAnchor = m_anchorPool.back();
+	m_anchorPool.pop_back();
+	pAnchor->~tgBulletSpringCableAnchor();
+	return new (pAnchor) tgBulletSpringCableAnchor(rb, pos, normal, false, true, manifold);
+}
+
+void tgBulletContactSpringCable::recycleAnchor(tgBulletSpringCableAnchor* pAnchor)
+{
+	assert(pAnchor != NULL);
+	assert(!pAnchor->permanent);
+	
+	// Only reconstruct anchors of exactly the type newSlidingAnchor makes
+	if (typeid(*pAnchor) == typeid(tgBulletSpringCableAnchor))
+	{
+		m_anchorPool.push_back(pAnchor);
+	}
+	else
+	{
+		delete pAnchor;
+	}
+}
+
 int tgBulletContactSpringCable::findNearestPastAnchor(btVector3& pos)
 {
 
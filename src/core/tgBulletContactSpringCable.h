@@ -43,6 +43,7 @@ class btRigidBody;
 class btCollisionShape;
 class btCompoundShape;
 class btPairCachingGhostObject;
+class btPersistentManifold;
 class btDynamicsWorld;
 
 /**
@@ -199,8 +200,8 @@ private:
     void clearCompoundShape(btCompoundShape* pShape);
     
     /**
-     * Determine if the anchor at i is permanent, if not, delete it
-     * and remove it from m_anchors.
+     * Determine if the anchor at i is permanent, if not, remove it
+     * from m_anchors and recycle it.
      * @param[in] i the index of the anchor to be deleted
      * @return true if the anchor has been deleted
      */
@@ -218,6 +219,22 @@ private:
      */
     int findNearestPastAnchor(btVector3& pos);
     
+    /**
+     * Make a sliding, non-permanent anchor, reusing one from
+     * m_anchorPool if there is one. Contacts are found and rejected
+     * every step, so this keeps them from going through the allocator.
+     */
+    tgBulletSpringCableAnchor* newSlidingAnchor(btRigidBody* rb,
+                                                const btVector3& pos,
+                                                const btVector3& normal,
+                                                btPersistentManifold* manifold);
+    
+    /**
+     * Use in place of deleting a non-permanent anchor. The anchor
+     * must no longer be in m_anchors or m_newAnchors.
+     */
+    void recycleAnchor(tgBulletSpringCableAnchor* pAnchor);
+    
     /**
      * An iterator over a list of tgBulletSpringCableAnchors. Used to insert new
      * anchors during updateAnchorList()
@@ -230,6 +247,12 @@ private:
      */
     std::vector<tgBulletSpringCableAnchor*> m_newAnchors;
     
+    /**
+     * Anchors that were rejected or pruned, kept to be reconstructed
+     * by newSlidingAnchor. We own these.
+     */
+    std::vector<tgBulletSpringCableAnchor*> m_anchorPool;
+    
     /**
      * A reference to the dynamics world so that we can track the
      * contact points in the broadphase's pairCache and remove
@@ -32,6 +32,24 @@
 #include <iostream>
 #include <stdexcept>
 
+namespace
+{
+    /** Static and kinematic bodies count as resting, they don't sleep */
+    bool isResting(const btRigidBody* body)
+    {
+        return !body->isActive() || body->isStaticOrKinematicObject();
+    }
+
+    /** activate() does nothing to static and kinematic bodies */
+    void wake(btRigidBody* body)
+    {
+        if (!body->isActive())
+        {
+            body->activate();
+        }
+    }
+}
+
 tgBulletSpringCable::tgBulletSpringCable( const std::vector<tgBulletSpringCableAnchor*>& anchors,
                 double coefK,
                 double dampingCoefficient,
@@ -40,7 +58,9 @@ tgSpringCable(tgCast::filter<tgBulletSpringCableAnchor, tgSpringCableAnchor>(anc
                 coefK, dampingCoefficient, pretension),
 m_anchors(anchors),
 anchor1(anchors.front()),
-anchor2(anchors.back())
+anchor2(anchors.back()),
+m_sleepThreshold(-1.0),
+m_appliedTension(0.0)
 {
     assert(m_anchors.size() >= 2);
     assert(invariant());
@@ -118,9 +138,12 @@ void tgBulletSpringCable::calculateAndApplyForce(double dt)
     std::cout << "Length: " << dist.length() << " rl: " << m_restLength <<std::endl; 
     #endif
       
+    // Tension actually applied, zero if slack
+    double appliedTension = 0.0;
     if (dist.length() > m_restLength)
     {   
         force = unitVector * magnitude; 
+        appliedTension = magnitude;
     }
     else
     {
@@ -129,6 +152,34 @@ void tgBulletSpringCable::calculateAndApplyForce(double dt)
     
     // Finished calculating, so can store things
     m_prevLength = currLength;
+    
+    if (m_sleepThreshold >= 0.0)
+    {
+        btRigidBody* const body1 = anchor1->attachedBody;
+        btRigidBody* const body2 = anchor2->attachedBody;
+        
+        if (appliedTension == 0.0)
+        {
+            // Nothing to apply, and no reason to wake anything
+        }
+        else if (isResting(body1) && isResting(body2) &&
+                 btFabs(appliedTension - m_appliedTension) <= m_sleepThreshold)
+        {
+            // The bodies went to sleep under this tension, leave them
+            return;
+        }
+        else
+        {
+            // Bodies that are awake are left alone so they can still
+            // fall asleep
+            wake(body1);
+            wake(body2);
+            body1->applyImpulse(force*dt, anchor1->getRelativePosition());
+            body2->applyImpulse(-force*dt, anchor2->getRelativePosition());
+        }
+        m_appliedTension = appliedTension;
+        return;
+    }
 
     //Now Apply it to the connected two bodies
     btVector3 point1 = this->anchor1->getRelativePosition();
@@ -140,6 +191,17 @@ void tgBulletSpringCable::calculateAndApplyForce(double dt)
     this->anchor2->attachedBody->applyImpulse(-force*dt,point2);
 }
 
+void tgBulletSpringCable::setRestLength(const double newRestLength)
+{
+    if (m_sleepThreshold >= 0.0 && newRestLength != m_restLength)
+    {
+        // A controller moved the cable, so it's time to wake up
+        wake(anchor1->attachedBody);
+        wake(anchor2->attachedBody);
+    }
+    tgSpringCable::setRestLength(newRestLength);
+}
+
 const double tgBulletSpringCable::getActualLength() const
 {
     const btVector3 dist =
@@ -93,6 +93,33 @@ public:
      */
     virtual const std::vector<const tgSpringCableAnchor*> getAnchors() const;
     
+    /**
+     * Sets m_restLength, and if sleeping is enabled wakes the bodies
+     * when the rest length changes
+     * @param[in] newRestLength, must be non-negative
+     */
+    virtual void setRestLength(const double newRestLength);
+    
+    /**
+     * Let Bullet deactivate the bodies of this cable. While both bodies
+     * are asleep (or static) and the tension is within threshold of the
+     * last tension applied, the cable neither wakes them nor applies
+     * impulses. A slack cable never wakes its bodies. Only affects
+     * tgBulletSpringCable's own force calculation, contact cables always
+     * keep their bodies awake.
+     * @param[in] threshold in units of force, negative to always keep
+     * the bodies awake (the default)
+     */
+    void setSleepThreshold(double threshold)
+    {
+        m_sleepThreshold = threshold;
+    }
+    
+    double getSleepThreshold() const
+    {
+        return m_sleepThreshold;
+    }
+    
 protected:
     
     /**
@@ -123,6 +150,17 @@ private:
      * anchor2
      */
     virtual void calculateAndApplyForce(double dt);
+    
+    /**
+     * See setSleepThreshold. Negative if bodies are always woken.
+     */
+    double m_sleepThreshold;
+    
+    /**
+     * The tension of the last impulses applied, compared against
+     * m_sleepThreshold
+     */
+    double m_appliedTension;
 
 private: 
     /** Ensures integrity of member variables */
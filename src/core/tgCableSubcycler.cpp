@@ -0,0 +1,246 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgCableSubcycler.cpp
+ * @brief Contains the implementation of class tgCableSubcycler
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgCableSubcycler.h"
+// This application
+#include "tgBulletContactSpringCable.h"
+#include "tgBulletSpringCable.h"
+#include "tgBulletSpringCableAnchor.h"
+#include "tgCast.h"
+#include "tgModel.h"
+#include "tgSpringCableActuator.h"
+// The Bullet Physics library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btTransformUtil.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <stdexcept>
+
+tgCableSubcycler::tgCableSubcycler(int substeps) :
+m_substeps(substeps),
+m_revision(0),
+m_found(false),
+m_pending(false),
+m_swapped(false)
+{
+    if (substeps < 1)
+    {
+        throw std::invalid_argument("substeps is less than one");
+    }
+}
+
+tgCableSubcycler::~tgCableSubcycler()
+{
+}
+
+void tgCableSubcycler::reset()
+{
+    m_models.clear();
+    m_actuators.clear();
+    m_bodies.clear();
+    m_start.clear();
+    m_linearOffset.clear();
+    m_angularOffset.clear();
+    m_found = false;
+    m_pending = false;
+    m_swapped = false;
+}
+
+void tgCableSubcycler::release(const std::vector<tgModel*>& models)
+{
+    // Search again, the actuators found last may be gone
+    for (std::size_t i = 0; i < models.size(); i++)
+    {
+        const std::vector<tgSpringCableActuator*> actuators =
+            tgCast::filter<tgModel, tgSpringCableActuator>(models[i]->getDescendants());
+        for (std::size_t j = 0; j < actuators.size(); j++)
+        {
+            actuators[j]->setSubcycled(false);
+        }
+    }
+    reset();
+}
+
+bool tgCableSubcycler::isCurrent() const
+{
+    return m_found && m_revision == tgModel::getStructureRevision();
+}
+
+void tgCableSubcycler::beforeWorldStep()
+{
+    if (!m_pending || !isCurrent())
+    {
+        m_pending = false;
+        return;
+    }
+
+    for (std::size_t i = 0; i < m_bodies.size(); i++)
+    {
+        btRigidBody* const body = m_bodies[i];
+        body->setLinearVelocity(body->getLinearVelocity() - m_linearOffset[i]);
+        body->setAngularVelocity(body->getAngularVelocity() - m_angularOffset[i]);
+    }
+    m_swapped = true;
+}
+
+void tgCableSubcycler::afterWorldStep()
+{
+    if (m_swapped && isCurrent())
+    {
+        for (std::size_t i = 0; i < m_bodies.size(); i++)
+        {
+            btRigidBody* const body = m_bodies[i];
+            body->setLinearVelocity(body->getLinearVelocity() + m_linearOffset[i]);
+            body->setAngularVelocity(body->getAngularVelocity() + m_angularOffset[i]);
+        }
+    }
+    m_swapped = false;
+    m_pending = false;
+}
+
+void tgCableSubcycler::findActuators(const std::vector<tgModel*>& models)
+{
+    if (isCurrent() && models == m_models)
+    {
+        return;
+    }
+
+    m_models = models;
+    m_revision = tgModel::getStructureRevision();
+    m_actuators.clear();
+    m_bodies.clear();
+    for (std::size_t i = 0; i < models.size(); i++)
+    {
+        const std::vector<tgSpringCableActuator*> actuators =
+            tgCast::filter<tgModel, tgSpringCableActuator>(models[i]->getDescendants());
+        for (std::size_t j = 0; j < actuators.size(); j++)
+        {
+            const tgBulletSpringCable* const cable =
+                tgCast::cast<tgSpringCable, tgBulletSpringCable>(
+                    actuators[j]->getSpringCable());
+            // Contact cables move their anchors during their step
+            if (cable == NULL ||
+                tgCast::cast<tgBulletSpringCable, tgBulletContactSpringCable>(cable))
+            {
+                continue;
+            }
+            actuators[j]->setSubcycled(true);
+            m_actuators.push_back(actuators[j]);
+
+            const std::vector<const tgSpringCableAnchor*> anchors =
+                cable->getAnchors();
+            const tgBulletSpringCableAnchor* const ends[2] = {
+                tgCast::cast<tgSpringCableAnchor, tgBulletSpringCableAnchor>(anchors.front()),
+                tgCast::cast<tgSpringCableAnchor, tgBulletSpringCableAnchor>(anchors.back())
+            };
+            for (int k = 0; k < 2; k++)
+            {
+                btRigidBody* const body = ends[k]->attachedBody;
+                if (!body->isStaticOrKinematicObject())
+                {
+                    m_bodies.push_back(body);
+                }
+            }
+        }
+    }
+    std::sort(m_bodies.begin(), m_bodies.end());
+    m_bodies.erase(std::unique(m_bodies.begin(), m_bodies.end()),
+                   m_bodies.end());
+
+    m_start.resize(m_bodies.size());
+    m_linearOffset.resize(m_bodies.size());
+    m_angularOffset.resize(m_bodies.size());
+    m_found = true;
+    m_pending = false;
+}
+
+void tgCableSubcycler::step(const std::vector<tgModel*>& models, double dt)
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgCableSubcycler::step");
+#endif //BT_NO_PROFILE
+    if (dt <= 0.0)
+    {
+        throw std::invalid_argument("dt is not positive");
+    }
+
+    findActuators(models);
+
+    const std::size_t n = m_bodies.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        m_start[i] = m_bodies[i]->getWorldTransform();
+    }
+
+    const double h = dt / m_substeps;
+    for (int k = 0; k < m_substeps; k++)
+    {
+        for (std::size_t j = 0; j < m_actuators.size(); j++)
+        {
+            m_actuators[j]->substep(h);
+        }
+
+        // Move the bodies along the prediction
+        for (std::size_t i = 0; i < n; i++)
+        {
+            btRigidBody* const body = m_bodies[i];
+            if (!body->isActive())
+            {
+                continue;
+            }
+            btTransform predicted;
+            btTransformUtil::integrateTransform(body->getWorldTransform(),
+                                                body->getLinearVelocity(),
+                                                body->getAngularVelocity(),
+                                                h,
+                                                predicted);
+            body->setWorldTransform(predicted);
+        }
+    }
+
+    for (std::size_t j = 0; j < m_actuators.size(); j++)
+    {
+        m_actuators[j]->endSubsteps();
+    }
+
+    // Put the bodies back for Bullet, remembering how they moved
+    for (std::size_t i = 0; i < n; i++)
+    {
+        btRigidBody* const body = m_bodies[i];
+        btVector3 linear;
+        btVector3 angular;
+        btTransformUtil::calculateVelocity(m_start[i],
+                                           body->getWorldTransform(),
+                                           dt,
+                                           linear,
+                                           angular);
+        m_linearOffset[i] = body->getLinearVelocity() - linear;
+        m_angularOffset[i] = body->getAngularVelocity() - angular;
+        body->setWorldTransform(m_start[i]);
+    }
+    m_pending = true;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_CABLE_SUBCYCLER_H
+#define TG_CABLE_SUBCYCLER_H
+
+/**
+ * @file tgCableSubcycler.h
+ * @brief Contains the definition of class tgCableSubcycler
+ * @author agent
+ * $Id$
+ */
+
+// The Bullet Physics library
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class btRigidBody;
+class tgModel;
+class tgSpringCableActuator;
+
+/**
+ * Runs the cables at a higher rate than the rigid bodies. Give it to
+ * tgSimulation::setCableSubcycler, which doesn't take ownership, so
+ * keep it alongside the simulation:
+ * @code
+ * tgCableSubcycler subcycler(8);
+ * tgSimulation simulation(view);
+ * simulation.setCableSubcycler(&subcycler);
+ * @endcode
+ * Declared before the simulation, it is destroyed after it. To destroy
+ * it earlier, call setCableSubcycler(NULL) first.
+ *
+ * Each tgSimulation::step of dt then takes one Bullet step of dt, and
+ * the cable forces and the motors of tgKinematicActuator are
+ * integrated over substeps substeps of dt / substeps. Stiff cables
+ * stay stable at a dt where they otherwise wouldn't, without paying
+ * for collision detection and the constraint solver at the small step.
+ *
+ * During the substeps the bodies the cables are attached to are moved
+ * along a prediction: each substep applies the cable impulses, then
+ * moves every body by its velocity for one substep. Gravity, contacts
+ * and joints only act in the Bullet step, so the prediction is only
+ * as good as the assumption that they change slowly over dt. The
+ * bodies are put back afterwards, and for the next Bullet step their
+ * velocities are swapped for the mean velocity of the prediction, so
+ * Bullet moves them along the path the cables saw. The velocity the
+ * cables left them with is restored after the Bullet step.
+ *
+ * Only cables between two bodies (tgBulletSpringCable) are
+ * subcycled. Cables that wrap around contacts
+ * (tgBulletContactSpringCable) and actuators of any other type are
+ * still stepped once per step by the models.
+ */
+class tgCableSubcycler
+{
+public:
+
+    /**
+     * @param[in] substeps cable steps per Bullet step
+     * @throw std::invalid_argument if substeps is less than one
+     */
+    tgCableSubcycler(int substeps = 4);
+
+    ~tgCableSubcycler();
+
+    /**
+     * Forget the actuators and bodies. Called by tgSimulation after
+     * every reset, which rebuilds them.
+     */
+    void reset();
+
+    /**
+     * Give the actuators in models back to their own step. Called by
+     * tgSimulation::setCableSubcycler when this is replaced.
+     */
+    void release(const std::vector<tgModel*>& models);
+
+    /**
+     * Swap in the mean velocities of the last prediction. Called by
+     * tgSimulation::step just before the world step.
+     */
+    void beforeWorldStep();
+
+    /**
+     * Restore the velocities the cables left. Called by
+     * tgSimulation::step just after the world step.
+     */
+    void afterWorldStep();
+
+    /**
+     * Run the substeps of the cables in models. Called by
+     * tgSimulation::step after the models were stepped, so the
+     * controllers have already set their inputs.
+     * @throw std::invalid_argument if dt is not positive
+     */
+    void step(const std::vector<tgModel*>& models, double dt);
+
+    int getSubsteps() const
+    {
+        return m_substeps;
+    }
+
+    /** Actuators subcycled in the last step */
+    std::size_t getNumActuators() const
+    {
+        return m_actuators.size();
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgCableSubcycler(const tgCableSubcycler&);
+
+    /** Disable the assignment operator. */
+    tgCableSubcycler& operator=(const tgCableSubcycler&);
+
+    /** Find the actuators and bodies again if the model trees changed */
+    void findActuators(const std::vector<tgModel*>& models);
+
+    /** True if the bodies are still the ones that were found */
+    bool isCurrent() const;
+
+    const int m_substeps;
+
+    /** What the actuators were found in */
+    std::vector<tgModel*> m_models;
+
+    /** tgModel::getStructureRevision() when the actuators were found */
+    unsigned long m_revision;
+
+    /** False until the actuators have been found */
+    bool m_found;
+
+    std::vector<tgSpringCableActuator*> m_actuators;
+
+    /** Every dynamic body one of the actuators is attached to, once */
+    std::vector<btRigidBody*> m_bodies;
+
+    /** Where each body was before the substeps, parallel to m_bodies */
+    std::vector<btTransform> m_start;
+
+    /**
+     * Velocity after the substeps minus the mean velocity of the
+     * prediction, parallel to m_bodies
+     */
+    std::vector<btVector3> m_linearOffset;
+
+    std::vector<btVector3> m_angularOffset;
+
+    /** True from step until the velocities have been swapped back */
+    bool m_pending;
+
+    /** True between beforeWorldStep and afterWorldStep */
+    bool m_swapped;
+};
+
+#endif // TG_CABLE_SUBCYCLER_H
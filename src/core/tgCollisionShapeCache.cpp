@@ -0,0 +1,172 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgCollisionShapeCache.cpp
+ * @brief Contains the implementation of class tgCollisionShapeCache
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgCollisionShapeCache.h"
+// The Bullet Physics library
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletCollision/CollisionShapes/btCylinderShape.h"
+#include "BulletCollision/CollisionShapes/btSphereShape.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+bool tgCollisionShapeCache::Key::operator<(const Key& other) const
+{
+    if (type != other.type)
+    {
+        return type < other.type;
+    }
+    else if (x != other.x)
+    {
+        return x < other.x;
+    }
+    else if (y != other.y)
+    {
+        return y < other.y;
+    }
+    else if (z != other.z)
+    {
+        return z < other.z;
+    }
+    return margin < other.margin;
+}
+
+tgCollisionShapeCache::tgCollisionShapeCache(double resolution) :
+m_resolution(resolution),
+m_numHits(0),
+m_numMisses(0)
+{
+    if (resolution <= 0.0)
+    {
+        throw std::invalid_argument("resolution is not positive");
+    }
+}
+
+tgCollisionShapeCache::~tgCollisionShapeCache()
+{
+    clear();
+}
+
+double tgCollisionShapeCache::round(double value) const
+{
+    return std::floor(value / m_resolution + 0.5);
+}
+
+btCollisionShape* tgCollisionShapeCache::get(ShapeType type,
+                                             const btVector3& dimensions,
+                                             double margin)
+{
+    Key key;
+    key.type = type;
+    key.x = round(dimensions.x());
+    // A sphere only has a radius
+    key.y = type == sphere ? 0.0 : round(dimensions.y());
+    key.z = type == sphere ? 0.0 : round(dimensions.z());
+    key.margin = margin < 0.0 ? -1.0 : round(margin);
+
+    std::map<Key, Entry>::iterator it = m_shapes.find(key);
+    if (it != m_shapes.end())
+    {
+        m_numHits++;
+        it->second.used = true;
+        return it->second.shape;
+    }
+
+    btCollisionShape* pShape = NULL;
+    switch (type)
+    {
+        case cylinder:
+            pShape = new btCylinderShape(dimensions);
+            break;
+        case sphere:
+            pShape = new btSphereShape(dimensions.x());
+            break;
+        case box:
+            pShape = new btBoxShape(dimensions);
+            break;
+        default:
+            throw std::invalid_argument("Unknown shape type");
+    }
+    if (margin >= 0.0)
+    {
+        pShape->setMargin(margin);
+    }
+
+    const Entry entry = {pShape, true};
+    m_shapes[key] = entry;
+    m_keys[pShape] = key;
+    m_numMisses++;
+    return pShape;
+}
+
+bool tgCollisionShapeCache::contains(const btCollisionShape* pShape) const
+{
+    return m_keys.find(pShape) != m_keys.end();
+}
+
+void tgCollisionShapeCache::release(const btCollisionShape* pShape)
+{
+    std::map<const btCollisionShape*, Key>::iterator it = m_keys.find(pShape);
+    if (it != m_keys.end())
+    {
+        m_shapes.erase(it->second);
+        m_keys.erase(it);
+    }
+}
+
+void tgCollisionShapeCache::prune()
+{
+    std::map<Key, Entry>::iterator it = m_shapes.begin();
+    while (it != m_shapes.end())
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+        {
+            m_keys.erase(it->second.shape);
+            delete it->second.shape;
+            m_shapes.erase(it++);
+        }
+    }
+    assert(m_keys.size() == m_shapes.size());
+}
+
+void tgCollisionShapeCache::clear()
+{
+    for (std::map<Key, Entry>::iterator it = m_shapes.begin();
+         it != m_shapes.end();
+         ++it)
+    {
+        delete it->second.shape;
+    }
+    m_shapes.clear();
+    m_keys.clear();
+}
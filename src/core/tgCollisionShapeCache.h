@@ -0,0 +1,163 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_COLLISION_SHAPE_CACHE_H
+#define TG_COLLISION_SHAPE_CACHE_H
+
+/**
+ * @file tgCollisionShapeCache.h
+ * @brief Contains the definition of class tgCollisionShapeCache
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <map>
+
+// Forward declarations
+class btCollisionShape;
+class btVector3;
+
+/**
+ * Shares one collision shape between every rigid of the same type,
+ * dimensions and margin, so a spine with hundreds of identical rods
+ * has one btCylinderShape rather than hundreds. Bullet only reads a
+ * shape, so sharing doesn't change the physics.
+ *
+ * Each tgWorld owns one and gives it to its implementation. It
+ * outlives tgWorld::reset, so a model rebuilt with the same geometry
+ * gets the same shapes back. Shapes no rigid asked for between two
+ * resets are deleted on the second one.
+ *
+ * Dimensions that differ by less than resolution share a shape, so
+ * rods whose lengths were computed from different nodes still match.
+ */
+class tgCollisionShapeCache
+{
+public:
+
+    enum ShapeType
+    {
+        cylinder,
+        sphere,
+        box
+    };
+
+    /**
+     * @param[in] resolution dimensions and margins are rounded to a
+     * multiple of this, in the units of the model
+     * @throw std::invalid_argument if resolution is not positive
+     */
+    tgCollisionShapeCache(double resolution = 1.0e-9);
+
+    /** Deletes every shape that is still cached */
+    ~tgCollisionShapeCache();
+
+    /**
+     * The shape of type with these dimensions, created the first time
+     * it is asked for. The cache keeps ownership.
+     * @param[in] type the kind of btCollisionShape
+     * @param[in] dimensions the half extents of a cylinder or a box,
+     * the radius of a sphere in x
+     * @param[in] margin the collision margin, negative for Bullet's
+     * default for the type
+     */
+    btCollisionShape* get(ShapeType type,
+                          const btVector3& dimensions,
+                          double margin = -1.0);
+
+    /** True if pShape belongs to the cache */
+    bool contains(const btCollisionShape* pShape) const;
+
+    /**
+     * Stop owning pShape, which the caller must now delete. A later get
+     * creates a new shape. Does nothing if pShape isn't cached.
+     */
+    void release(const btCollisionShape* pShape);
+
+    /**
+     * Delete the shapes that weren't asked for since the last prune.
+     * No body may use them, so this is called by tgWorld::reset once
+     * the old implementation is gone.
+     */
+    void prune();
+
+    /** Delete every shape. No body may use them. */
+    void clear();
+
+    /** Shapes currently cached */
+    std::size_t size() const
+    {
+        return m_shapes.size();
+    }
+
+    /** Calls to get that returned an existing shape */
+    std::size_t getNumHits() const
+    {
+        return m_numHits;
+    }
+
+    /** Calls to get that created a shape */
+    std::size_t getNumMisses() const
+    {
+        return m_numMisses;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgCollisionShapeCache(const tgCollisionShapeCache&);
+
+    /** Disable the assignment operator. */
+    tgCollisionShapeCache& operator=(const tgCollisionShapeCache&);
+
+    /** Type and rounded dimensions */
+    struct Key
+    {
+        int type;
+        double x;
+        double y;
+        double z;
+        double margin;
+
+        bool operator<(const Key& other) const;
+    };
+
+    struct Entry
+    {
+        btCollisionShape* shape;
+        /** Asked for since the last prune */
+        bool used;
+    };
+
+    double round(double value) const;
+
+    const double m_resolution;
+
+    std::map<Key, Entry> m_shapes;
+
+    /** The key of every cached shape, for contains and release */
+    std::map<const btCollisionShape*, Key> m_keys;
+
+    std::size_t m_numHits;
+
+    std::size_t m_numMisses;
+};
+
+#endif // TG_COLLISION_SHAPE_CACHE_H
@@ -103,7 +103,9 @@ tgKinematicActuator::tgKinematicActuator(tgBulletSpringCable* muscle,
                    tgKinematicActuator::Config& config) :
     m_motorVel(0.0),
     m_motorAcc(0.0),
+    m_desiredTorque(0.0),
     m_appliedTorque(0.0),
+    m_grouped(false),
     m_config(config),
     tgSpringCableActuator(muscle, tags, config)
 {
@@ -145,14 +147,38 @@ void tgKinematicActuator::step(double dt)
     {   
         // Want to update any controls before applying forces
         notifyStep(dt); 
-        // Adjust rest length based on muscle dynamics
-        integrateRestLength(dt);
-        m_springCable->step(dt);
-        logHistory();  
+        // Otherwise tgCableSubcycler integrates the motor in substeps,
+        // and resets the torque after the last one, or
+        // tgKinematicMotorGroup integrates it with the others after the
+        // models were stepped, and logs it
+        if (!m_subcycled && !m_grouped)
+        {
+            // Adjust rest length based on muscle dynamics
+            integrateRestLength(dt);
+            m_springCable->step(dt);
+        }
+        if (!m_grouped)
+        {
+            logHistory();
+        }
         tgModel::step(dt);
     }
     
-    // Reset and wait for next control input
+    if (!m_subcycled && !m_grouped)
+    {
+        // Reset and wait for next control input
+        m_desiredTorque = 0.0;
+    }
+}
+
+void tgKinematicActuator::substep(double dt)
+{
+    integrateRestLength(dt);
+    m_springCable->step(dt);
+}
+
+void tgKinematicActuator::endSubsteps()
+{
     m_desiredTorque = 0.0;
 }
 
@@ -39,6 +39,8 @@ class tgWorld;
 // Should always be a child Model of a tgModel
 class tgKinematicActuator : public tgSpringCableActuator
 {
+    friend class tgKinematicMotorGroup;
+
 public: 
 	struct Config : public tgSpringCableActuator::Config
 	{
@@ -128,7 +130,13 @@ public:
      * @param[in] dt, must be >= 0.0
      */    
     virtual void step(double dt);
-    
+
+    /** Integrates the motor and applies the cable force over dt */
+    virtual void substep(double dt);
+
+    /** Resets the torque to wait for the next control input */
+    virtual void endSubsteps();
+
     /**
      * Double dispatch function for a tgModelVisitor. This object
      * will pass itself back to the visitor. Used for rendering and 
@@ -166,6 +174,20 @@ public:
 	 */
 	virtual void setControlInput(double input);
 	
+    /**
+     * Let tgKinematicMotorGroup integrate the motor, apply the cable
+     * force and log the history. step then only notifies the observers.
+     */
+    void setGrouped(bool grouped)
+    {
+        m_grouped = grouped;
+    }
+
+    bool isGrouped() const
+    {
+        return m_grouped;
+    }
+
 protected:
 	
 	virtual void integrateRestLength(double dt);
@@ -206,6 +228,9 @@ private:
 	double m_desiredTorque;
     
     double m_appliedTorque;
+
+    /** True while tgKinematicMotorGroup integrates the motor */
+    bool m_grouped;
     
     /**
      * Override the base config to get the extra parameters
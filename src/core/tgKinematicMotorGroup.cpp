@@ -0,0 +1,260 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgKinematicMotorGroup.cpp
+ * @brief Contains the implementation of class tgKinematicMotorGroup
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgKinematicMotorGroup.h"
+// This application
+#include "tgCast.h"
+#include "tgKinematicActuator.h"
+#include "tgModel.h"
+#include "tgSpringCable.h"
+// The Bullet Physics library
+#include "LinearMath/btQuickprof.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace
+{
+    /**
+     * The motor model of tgKinematicActuator::integrateRestLength and
+     * getAppliedTorque for n motors. The arrays never overlap, and
+     * saying so lets the compiler keep everything in registers.
+     */
+    void integrateMotors(std::size_t n,
+                         double dt,
+                         const double* __restrict__ radius,
+                         const double* __restrict__ motorFriction,
+                         const double* __restrict__ motorInertia,
+                         const double* __restrict__ maxTension,
+                         const double* __restrict__ targetVelocity,
+                         const double* __restrict__ minRestLength,
+                         const char* __restrict__ backdrivable,
+                         const double* __restrict__ desiredTorque,
+                         const double* __restrict__ tension,
+                         double* __restrict__ motorVel,
+                         double* __restrict__ motorAcc,
+                         double* __restrict__ appliedTorque,
+                         double* __restrict__ restLength)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            // getAppliedTorque
+            double maxTorque = maxTension[i] * radius[i] *
+                (1.0 - radius[i] * std::abs(motorVel[i]) / targetVelocity[i]);
+            maxTorque = maxTorque < 0.0 ? 0.0 : maxTorque;
+            const double desired = desiredTorque[i];
+            const double applied = std::abs(desired) < maxTorque ? desired :
+                desired / std::abs(desired) * maxTorque;
+            appliedTorque[i] = applied;
+
+            const double acc = (applied - motorFriction[i] * motorVel[i]
+                                + tension[i] * radius[i]) / motorInertia[i];
+            motorAcc[i] = acc;
+
+            if (!backdrivable[i] && acc * applied <= 0.0)
+            {
+                motorVel[i] = motorVel[i] + acc * dt > 0.0 ? 0.0 :
+                    motorVel[i] + acc * dt;
+            }
+            else
+            {
+                motorVel[i] += acc * dt;
+            }
+
+            const double length = restLength[i] + radius[i] * motorVel[i] * dt;
+            restLength[i] = (length > minRestLength[i]) ? length : minRestLength[i];
+        }
+    }
+}
+
+tgKinematicMotorGroup::tgKinematicMotorGroup() :
+m_revision(0),
+m_found(false)
+{
+}
+
+tgKinematicMotorGroup::~tgKinematicMotorGroup()
+{
+}
+
+void tgKinematicMotorGroup::reset()
+{
+    m_models.clear();
+    m_actuators.clear();
+    m_found = false;
+}
+
+void tgKinematicMotorGroup::release(const std::vector<tgModel*>& models)
+{
+    // Search again, the actuators found last may be gone
+    for (std::size_t i = 0; i < models.size(); i++)
+    {
+        const std::vector<tgKinematicActuator*> actuators =
+            tgCast::filter<tgModel, tgKinematicActuator>(models[i]->getDescendants());
+        for (std::size_t j = 0; j < actuators.size(); j++)
+        {
+            actuators[j]->setGrouped(false);
+        }
+    }
+    reset();
+}
+
+bool tgKinematicMotorGroup::isCurrent() const
+{
+    return m_found && m_revision == tgModel::getStructureRevision();
+}
+
+void tgKinematicMotorGroup::beforeModelsStep(const std::vector<tgModel*>& models)
+{
+    if (!isCurrent() || models != m_models)
+    {
+        findActuators(models);
+    }
+    // Every one of them leaves its motor to us this step
+    m_skip.assign(m_actuators.size(), 0);
+}
+
+void tgKinematicMotorGroup::findActuators(const std::vector<tgModel*>& models)
+{
+    m_models = models;
+    m_revision = tgModel::getStructureRevision();
+    m_actuators.clear();
+    m_skip.clear();
+    m_radius.clear();
+    m_motorFriction.clear();
+    m_motorInertia.clear();
+    m_maxTension.clear();
+    m_targetVelocity.clear();
+    m_minRestLength.clear();
+    m_backdrivable.clear();
+    m_motorVel.clear();
+    m_motorAcc.clear();
+
+    for (std::size_t i = 0; i < models.size(); i++)
+    {
+        const std::vector<tgKinematicActuator*> actuators =
+            tgCast::filter<tgModel, tgKinematicActuator>(models[i]->getDescendants());
+        for (std::size_t j = 0; j < actuators.size(); j++)
+        {
+            tgKinematicActuator* const pActuator = actuators[j];
+            // A subclass may integrate differently
+            if (typeid(*pActuator) != typeid(tgKinematicActuator))
+            {
+                continue;
+            }
+
+            m_skip.push_back(pActuator->isGrouped() ? 0 : 1);
+            pActuator->setGrouped(true);
+            m_actuators.push_back(pActuator);
+
+            const tgKinematicActuator::Config& config = pActuator->m_config;
+            m_radius.push_back(config.radius);
+            m_motorFriction.push_back(config.motorFriction);
+            m_motorInertia.push_back(config.motorInertia);
+            m_maxTension.push_back(config.maxTens);
+            m_targetVelocity.push_back(config.targetVelocity);
+            m_minRestLength.push_back(config.minRestLength);
+            m_backdrivable.push_back(config.backdrivable ? 1 : 0);
+            m_motorVel.push_back(pActuator->m_motorVel);
+            m_motorAcc.push_back(pActuator->m_motorAcc);
+        }
+    }
+
+    const std::size_t n = m_actuators.size();
+    m_desiredTorque.resize(n);
+    m_appliedTorque.resize(n);
+    m_tension.resize(n);
+    m_restLength.resize(n);
+    m_found = true;
+}
+
+void tgKinematicMotorGroup::step(double dt)
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgKinematicMotorGroup::step");
+#endif //BT_NO_PROFILE
+    if (dt <= 0.0)
+    {
+        throw std::invalid_argument("dt is not positive");
+    }
+
+    if (!isCurrent())
+    {
+        // The trees changed while the models stepped. The actuators
+        // that are new integrated themselves, so they are skipped
+        findActuators(m_models);
+    }
+
+    const std::size_t n = m_actuators.size();
+    if (n == 0)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const tgKinematicActuator& actuator = *m_actuators[i];
+        m_desiredTorque[i] = actuator.m_desiredTorque;
+        m_tension[i] = actuator.getTension();
+        m_restLength[i] = actuator.m_restLength;
+    }
+
+    integrateMotors(n, dt, &m_radius[0], &m_motorFriction[0],
+                    &m_motorInertia[0], &m_maxTension[0],
+                    &m_targetVelocity[0], &m_minRestLength[0],
+                    &m_backdrivable[0], &m_desiredTorque[0], &m_tension[0],
+                    &m_motorVel[0], &m_motorAcc[0], &m_appliedTorque[0],
+                    &m_restLength[0]);
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        tgKinematicActuator& actuator = *m_actuators[i];
+        if (m_skip[i] || actuator.isSubcycled())
+        {
+            // Either it integrated itself this step, or tgCableSubcycler
+            // integrates it. Keep its state rather than ours
+            if (!m_skip[i])
+            {
+                actuator.logHistory();
+            }
+            m_skip[i] = 0;
+            m_motorVel[i] = actuator.m_motorVel;
+            m_motorAcc[i] = actuator.m_motorAcc;
+            continue;
+        }
+
+        actuator.m_motorVel = m_motorVel[i];
+        actuator.m_motorAcc = m_motorAcc[i];
+        actuator.m_appliedTorque = m_appliedTorque[i];
+        actuator.m_restLength = m_restLength[i];
+        actuator.m_springCable->setRestLength(m_restLength[i]);
+        actuator.m_springCable->step(dt);
+        actuator.logHistory();
+        // Reset and wait for next control input
+        actuator.m_desiredTorque = 0.0;
+    }
+}
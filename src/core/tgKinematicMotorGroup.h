@@ -0,0 +1,153 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_KINEMATIC_MOTOR_GROUP_H
+#define TG_KINEMATIC_MOTOR_GROUP_H
+
+/**
+ * @file tgKinematicMotorGroup.h
+ * @brief Contains the definition of class tgKinematicMotorGroup
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgKinematicActuator;
+class tgModel;
+
+/**
+ * Integrates the motors of every tgKinematicActuator in the models in
+ * one pass per step. Give it to tgSimulation::setKinematicMotorGroup.
+ *
+ * The motor velocities and accelerations and the motor parameters of
+ * the configs are kept in contiguous arrays, parallel to the
+ * actuators. Each step reads the torques the controllers set and the
+ * cable tensions, advances every motor in one loop, then sets the rest
+ * lengths and applies the cable forces. The actuators' own steps then
+ * only notify their controllers.
+ *
+ * The arithmetic is the same as tgKinematicActuator::integrateRestLength
+ * in the same order, so the motors follow the same trajectories as
+ * when the actuators step themselves. The cables apply their forces
+ * after all the models were stepped rather than in between, which
+ * changes nothing unless other models apply forces to the same bodies
+ * in the same step: then the impulses are summed in a different order.
+ * A controller that reads another kinematic actuator's rest length
+ * during the step sees it before that actuator's motor moved.
+ *
+ * Actuators subcycled by tgCableSubcycler are integrated in its
+ * substeps instead, and subclasses of tgKinematicActuator are left to
+ * step themselves.
+ */
+class tgKinematicMotorGroup
+{
+public:
+
+    tgKinematicMotorGroup();
+
+    ~tgKinematicMotorGroup();
+
+    /**
+     * Forget the actuators. Called by tgSimulation after every reset,
+     * which rebuilds them.
+     */
+    void reset();
+
+    /**
+     * Give the actuators in models back to their own step. Called by
+     * tgSimulation::setKinematicMotorGroup when this is replaced.
+     */
+    void release(const std::vector<tgModel*>& models);
+
+    /**
+     * Find the actuators if the models changed, so their own steps
+     * leave the motors to us. Called by tgSimulation::step before the
+     * models are stepped.
+     */
+    void beforeModelsStep(const std::vector<tgModel*>& models);
+
+    /**
+     * Integrate every motor over dt. Called by tgSimulation::step after
+     * the models were stepped, so the controllers have set their
+     * torques.
+     * @throw std::invalid_argument if dt is not positive
+     */
+    void step(double dt);
+
+    /** Actuators integrated in the last step */
+    std::size_t getNumActuators() const
+    {
+        return m_actuators.size();
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgKinematicMotorGroup(const tgKinematicMotorGroup&);
+
+    /** Disable the assignment operator. */
+    tgKinematicMotorGroup& operator=(const tgKinematicMotorGroup&);
+
+    /** Find the actuators again and load their motors */
+    void findActuators(const std::vector<tgModel*>& models);
+
+    /** True if the actuators are still the ones that were found */
+    bool isCurrent() const;
+
+    /** What the actuators were found in */
+    std::vector<tgModel*> m_models;
+
+    /** tgModel::getStructureRevision() when the actuators were found */
+    unsigned long m_revision;
+
+    /** False until the actuators have been found */
+    bool m_found;
+
+    std::vector<tgKinematicActuator*> m_actuators;
+
+    /**
+     * Nonzero for actuators found after the models were stepped, which
+     * integrated themselves this step
+     */
+    std::vector<char> m_skip;
+
+    // Motor parameters, parallel to m_actuators
+    std::vector<double> m_radius;
+    std::vector<double> m_motorFriction;
+    std::vector<double> m_motorInertia;
+    std::vector<double> m_maxTension;
+    std::vector<double> m_targetVelocity;
+    std::vector<double> m_minRestLength;
+    std::vector<char> m_backdrivable;
+
+    // Motor state, parallel to m_actuators
+    std::vector<double> m_motorVel;
+    std::vector<double> m_motorAcc;
+
+    // Read from or written to the actuators each step
+    std::vector<double> m_desiredTorque;
+    std::vector<double> m_appliedTorque;
+    std::vector<double> m_tension;
+    std::vector<double> m_restLength;
+};
+
+#endif // TG_KINEMATIC_MOTOR_GROUP_H
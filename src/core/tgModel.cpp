@@ -30,20 +30,28 @@
 // The C++ Standard Library
 #include <stdexcept>
 
-tgModel::tgModel()
+unsigned long tgModel::structureRevision = 0;
+
+tgModel::tgModel() :
+m_childrenScheduled(false)
 {
   // Postcondition
   assert(invariant());
 }
 
 tgModel::tgModel(const tgTags& tags) :
-        tgTaggable(tags)
+        tgTaggable(tags),
+        m_childrenScheduled(false)
 {
   assert(invariant());
 }
 
 tgModel::~tgModel()
 {
+  if (!m_children.empty())
+  {
+    structureRevision++;
+  }
   const size_t n = m_children.size();
   for (size_t i = 0; i < n; ++i)
   {
@@ -72,7 +80,11 @@ void tgModel::teardown()
     m_children[i]->teardown();
     delete m_children[i];
   }
-  m_children.clear();
+  if (!m_children.empty())
+  {
+    m_children.clear();
+    structureRevision++;
+  }
   //Clear the markers
   this->m_markers.clear();
 
@@ -87,7 +99,7 @@ void tgModel::step(double dt)
   {
     throw std::invalid_argument("dt is not positive");
   }
-  else
+  else if (!m_childrenScheduled)
   {
     // Note: You can adjust whether to step children before notifying 
     // controllers or the other way around in your model
@@ -143,6 +155,7 @@ void tgModel::addChild(tgModel* pChild)
   }
 
   m_children.push_back(pChild);
+  structureRevision++;
 
   // Postcondition
   assert(invariant());
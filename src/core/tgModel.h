@@ -45,6 +45,9 @@ class abstractMarker;
  */
 class tgModel : public tgTaggable
 {
+    /** Sets m_childrenScheduled */
+    friend class tgStepSchedule;
+
 public: 
 
     /**
@@ -86,6 +89,8 @@ public:
     * std::invalid_argument is thrown if dt is not positive
     * @throw std::invalid_argument if dt is not positive
     * @note This is not necessarily const for every child.
+    * @note Does not step the children while this model is in a
+    * tgStepSchedule, the schedule steps them instead.
     */
     virtual void step(double dt);
 
@@ -152,6 +157,15 @@ public:
 
     void addMarker(abstractMarker a);
 
+    /**
+     * Changes whenever any model anywhere gains or loses children, so
+     * a tgStepSchedule knows when to rebuild.
+     */
+    static unsigned long getStructureRevision()
+    {
+        return structureRevision;
+    }
+
 private:
 
     /** Integrity predicate. */
@@ -168,6 +182,11 @@ private:
 
     std::vector<abstractMarker> m_markers;
 
+    /** True while a tgStepSchedule steps the children of this model */
+    bool m_childrenScheduled;
+
+    static unsigned long structureRevision;
+
 };
 
 /**
@@ -0,0 +1,167 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgObservationBuffer.cpp
+ * @brief Contains the implementation of class tgObservationBuffer
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgObservationBuffer.h"
+// This application
+#include "tgBaseRigid.h"
+#include "tgSpringCableActuator.h"
+// The Bullet Physics library
+#include "LinearMath/btQuickprof.h"
+// The C++ Standard Library
+#include <stdexcept>
+
+const std::size_t tgObservationBuffer::centerOfMassSize;
+const std::size_t tgObservationBuffer::poseSize;
+const std::size_t tgObservationBuffer::cableSize;
+
+tgObservationBuffer::tgObservationBuffer() :
+m_numUpdates(0)
+{
+}
+
+tgObservationBuffer::~tgObservationBuffer()
+{
+}
+
+void tgObservationBuffer::clear()
+{
+    m_centersOfMass.clear();
+    m_poses.clear();
+    m_cables.clear();
+    m_values.clear();
+    m_numUpdates = 0;
+}
+
+std::size_t tgObservationBuffer::addCenterOfMass(const std::vector<tgBaseRigid*>& rigids)
+{
+    if (rigids.empty())
+    {
+        throw std::invalid_argument("No rigids to observe");
+    }
+
+    CenterOfMass c;
+    c.offset = m_values.size();
+    c.mass = 0.0;
+    for (std::size_t i = 0; i < rigids.size(); i++)
+    {
+        c.rigids.push_back(rigids[i]);
+        c.mass += rigids[i]->mass();
+    }
+    if (c.mass <= 0.0)
+    {
+        throw std::invalid_argument("Rigids to observe have no mass");
+    }
+
+    m_values.resize(m_values.size() + centerOfMassSize);
+    m_centersOfMass.push_back(c);
+    read(c);
+    return c.offset;
+}
+
+std::size_t tgObservationBuffer::addPose(const tgBaseRigid* rigid)
+{
+    if (rigid == NULL)
+    {
+        throw std::invalid_argument("NULL rigid to observe");
+    }
+
+    const Pose p = {m_values.size(), rigid};
+    m_values.resize(m_values.size() + poseSize);
+    m_poses.push_back(p);
+    read(p);
+    return p.offset;
+}
+
+std::size_t tgObservationBuffer::addCable(const tgSpringCableActuator* cable)
+{
+    if (cable == NULL)
+    {
+        throw std::invalid_argument("NULL cable to observe");
+    }
+
+    const Cable c = {m_values.size(), cable};
+    m_values.resize(m_values.size() + cableSize);
+    m_cables.push_back(c);
+    read(c);
+    return c.offset;
+}
+
+void tgObservationBuffer::update()
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgObservationBuffer::update");
+#endif //BT_NO_PROFILE
+    for (std::size_t i = 0; i < m_centersOfMass.size(); i++)
+    {
+        read(m_centersOfMass[i]);
+    }
+    for (std::size_t i = 0; i < m_poses.size(); i++)
+    {
+        read(m_poses[i]);
+    }
+    for (std::size_t i = 0; i < m_cables.size(); i++)
+    {
+        read(m_cables[i]);
+    }
+    m_numUpdates++;
+}
+
+void tgObservationBuffer::read(const CenterOfMass& c)
+{
+    btVector3 sum(0.0, 0.0, 0.0);
+    for (std::size_t i = 0; i < c.rigids.size(); i++)
+    {
+        sum += c.rigids[i]->centerOfMass() * c.rigids[i]->mass();
+    }
+    sum /= c.mass;
+
+    double* const values = &m_values[c.offset];
+    values[0] = sum.x();
+    values[1] = sum.y();
+    values[2] = sum.z();
+}
+
+void tgObservationBuffer::read(const Pose& p)
+{
+    const btVector3 position = p.rigid->centerOfMass();
+    const btVector3 orientation = p.rigid->orientation();
+
+    double* const values = &m_values[p.offset];
+    values[0] = position.x();
+    values[1] = position.y();
+    values[2] = position.z();
+    values[3] = orientation.x();
+    values[4] = orientation.y();
+    values[5] = orientation.z();
+}
+
+void tgObservationBuffer::read(const Cable& c)
+{
+    double* const values = &m_values[c.offset];
+    values[0] = c.cable->getCurrentLength();
+    values[1] = c.cable->getVelocity();
+    values[2] = c.cable->getTension();
+}
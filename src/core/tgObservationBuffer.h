@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_OBSERVATION_BUFFER_H
+#define TG_OBSERVATION_BUFFER_H
+
+/**
+ * @file tgObservationBuffer.h
+ * @brief Contains the definition of class tgObservationBuffer
+ * @author agent
+ * $Id$
+ */
+
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class tgBaseRigid;
+class tgSpringCableActuator;
+
+/**
+ * The state of the world that controllers, loggers and scorers read,
+ * gathered once per step into one contiguous array of doubles. Each
+ * tgWorld has one, see tgWorld::observations.
+ *
+ * Models declare what can be observed in their setup, each add
+ * function returns the offset of the new values in the buffer. The
+ * values are read right away and then again after every world step,
+ * so they are what the bodies and cables were at the start of the
+ * models' step.
+ *
+ * The buffer keeps pointers to the rigids and cables, so it must be
+ * cleared before they are deleted. tgSimulation clears it before it
+ * tears the models down, and the world clears it again on every reset.
+ * The models declare their observables again when they are set up.
+ * Anything that tears models down without a tgSimulation must clear
+ * the world's buffer first.
+ */
+class tgObservationBuffer
+{
+public:
+
+    /** Values added by addCenterOfMass: x, y and z */
+    static const std::size_t centerOfMassSize = 3;
+
+    /** Values added by addPose: x, y, z, yaw, pitch and roll */
+    static const std::size_t poseSize = 6;
+
+    /** Values added by addCable: length, velocity and tension */
+    static const std::size_t cableSize = 3;
+
+    tgObservationBuffer();
+
+    ~tgObservationBuffer();
+
+    /** Forget every observable and value */
+    void clear();
+
+    /**
+     * Observe the mass weighted center of mass of rigids, such as the
+     * rods of one segment.
+     * @param[in] rigids not empty, must outlive the observable
+     * @return the offset of the centerOfMassSize values
+     * @throw std::invalid_argument if rigids is empty or massless
+     */
+    std::size_t addCenterOfMass(const std::vector<tgBaseRigid*>& rigids);
+
+    /**
+     * Observe the center of mass and the orientation of rigid, as
+     * returned by tgBaseRigid::orientation.
+     * @param[in] rigid must outlive the observable
+     * @return the offset of the poseSize values
+     * @throw std::invalid_argument if rigid is NULL
+     */
+    std::size_t addPose(const tgBaseRigid* rigid);
+
+    /**
+     * Observe the length, velocity and tension of cable, as returned by
+     * its getCurrentLength, getVelocity and getTension.
+     * @param[in] cable must outlive the observable
+     * @return the offset of the cableSize values
+     * @throw std::invalid_argument if cable is NULL
+     */
+    std::size_t addCable(const tgSpringCableActuator* cable);
+
+    /** Read every observable again. Called by tgWorld::step. */
+    void update();
+
+    /** All of the values, in the order they were added */
+    const std::vector<double>& getValues() const
+    {
+        return m_values;
+    }
+
+    /** The value at offset, which must be less than size() */
+    double get(std::size_t offset) const
+    {
+        return m_values[offset];
+    }
+
+    /** The three values starting at offset, such as a center of mass */
+    btVector3 getVector(std::size_t offset) const
+    {
+        return btVector3(m_values[offset],
+                         m_values[offset + 1],
+                         m_values[offset + 2]);
+    }
+
+    std::size_t size() const
+    {
+        return m_values.size();
+    }
+
+    /** Updates since the last clear */
+    std::size_t getNumUpdates() const
+    {
+        return m_numUpdates;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgObservationBuffer(const tgObservationBuffer&);
+
+    /** Disable the assignment operator. */
+    tgObservationBuffer& operator=(const tgObservationBuffer&);
+
+    /** The rigids and total mass of one addCenterOfMass */
+    struct CenterOfMass
+    {
+        std::size_t offset;
+        std::vector<const tgBaseRigid*> rigids;
+        double mass;
+    };
+
+    struct Pose
+    {
+        std::size_t offset;
+        const tgBaseRigid* rigid;
+    };
+
+    struct Cable
+    {
+        std::size_t offset;
+        const tgSpringCableActuator* cable;
+    };
+
+    void read(const CenterOfMass& c);
+
+    void read(const Pose& p);
+
+    void read(const Cable& c);
+
+    std::vector<CenterOfMass> m_centersOfMass;
+
+    std::vector<Pose> m_poses;
+
+    std::vector<Cable> m_cables;
+
+    std::vector<double> m_values;
+
+    std::size_t m_numUpdates;
+};
+
+#endif // TG_OBSERVATION_BUFFER_H
@@ -0,0 +1,339 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgProfiler.cpp
+ * @brief Contains the implementation of class tgProfiler
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgProfiler.h"
+// The Bullet Physics library
+#include "LinearMath/btQuickprof.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+    /** Nearest rank percentile of sorted, which must not be empty */
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        std::size_t rank = static_cast<std::size_t>(p * sorted.size() / 100.0 + 0.5);
+        if (rank > 0)
+        {
+            rank--;
+        }
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    /** Scope names come from BT_PROFILE, but may still need escaping */
+    std::string jsonString(const std::string& s)
+    {
+        std::string result = "\"";
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            if (s[i] == '"' || s[i] == '\\')
+            {
+                result += '\\';
+            }
+            result += s[i];
+        }
+        return result + "\"";
+    }
+
+    std::string csvString(const std::string& s)
+    {
+        std::string result = "\"";
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            if (s[i] == '"')
+            {
+                result += '"';
+            }
+            result += s[i];
+        }
+        return result + "\"";
+    }
+}
+
+const std::size_t tgProfiler::recentSamples;
+
+tgProfiler::tgProfiler(int sampleInterval, std::size_t maxEvents) :
+m_sampleInterval(sampleInterval),
+m_maxEvents(maxEvents),
+m_stepsSinceSample(0),
+m_numSamples(0),
+m_traceTime(0.0),
+m_droppedEvents(0)
+{
+    if (sampleInterval <= 0)
+    {
+        throw std::invalid_argument("Profiler sample interval is not positive");
+    }
+}
+
+tgProfiler::~tgProfiler()
+{
+}
+
+void tgProfiler::onStep()
+{
+#ifndef BT_NO_PROFILE
+    m_stepsSinceSample++;
+    if (m_stepsSinceSample >= m_sampleInterval)
+    {
+        sample();
+        m_stepsSinceSample = 0;
+    }
+#endif //BT_NO_PROFILE
+}
+
+void tgProfiler::clear()
+{
+    m_stepsSinceSample = 0;
+    m_numSamples = 0;
+    m_traceTime = 0.0;
+    m_scopes.clear();
+    m_scopeIndex.clear();
+    m_events.clear();
+    m_droppedEvents = 0;
+}
+
+void tgProfiler::sample()
+{
+#ifndef BT_NO_PROFILE
+    // Everything since the world step reset the tree
+    const double stepTime = CProfileManager::Get_Time_Since_Reset();
+
+    const std::size_t root = scopeIndex("step", "step", 0);
+
+    CProfileIterator* it = CProfileManager::Get_Iterator();
+    const double childTime = readChildren(it, "step", 1, m_traceTime);
+    CProfileManager::Release_Iterator(it);
+
+    addSample(root, m_traceTime, stepTime, stepTime - childTime, 1);
+
+    m_traceTime += stepTime;
+    m_numSamples++;
+#endif //BT_NO_PROFILE
+}
+
+double tgProfiler::readChildren(CProfileIterator* it,
+                                const std::string& parentPath,
+                                int depth,
+                                double start)
+{
+#ifndef BT_NO_PROFILE
+    // Read this level first, entering a child moves the iterator
+    std::vector<std::string> names;
+    std::vector<int> calls;
+    std::vector<double> times;
+    for (it->First(); !it->Is_Done(); it->Next())
+    {
+        names.push_back(it->Get_Current_Name());
+        calls.push_back(it->Get_Current_Total_Calls());
+        times.push_back(it->Get_Current_Total_Time());
+    }
+
+    double total = 0.0;
+    for (std::size_t i = 0; i < names.size(); i++)
+    {
+        // Scopes Bullet knows about but that didn't run this step
+        if (calls[i] == 0)
+        {
+            continue;
+        }
+
+        const std::string path = parentPath + "/" + names[i];
+        // Before the children, so parents come first in the CSV
+        const std::size_t index = scopeIndex(path, names[i], depth);
+
+        it->Enter_Child(i);
+        const double childTime = readChildren(it, path, depth + 1, start);
+        it->Enter_Parent();
+
+        addSample(index, start, times[i], times[i] - childTime, calls[i]);
+
+        start += times[i];
+        total += times[i];
+    }
+    return total;
+#else
+    return 0.0;
+#endif //BT_NO_PROFILE
+}
+
+void tgProfiler::addSample(std::size_t index,
+                           double start,
+                           double inclusive,
+                           double exclusive,
+                           int calls)
+{
+    Scope& s = m_scopes[index];
+    if (s.samples == 0 || inclusive < s.min)
+    {
+        s.min = inclusive;
+    }
+    if (s.samples == 0 || inclusive > s.max)
+    {
+        s.max = inclusive;
+    }
+    s.samples++;
+    s.calls += calls;
+    s.inclusive += inclusive;
+    s.exclusive += exclusive;
+
+    // A ring of the last recentSamples
+    if (s.recent.size() < recentSamples)
+    {
+        s.recent.push_back(inclusive);
+    }
+    else
+    {
+        s.recent[s.nextRecent] = inclusive;
+    }
+    s.nextRecent = (s.nextRecent + 1) % recentSamples;
+
+    if (m_events.size() < m_maxEvents)
+    {
+        const Event e = {index, m_numSamples, start, inclusive, calls};
+        m_events.push_back(e);
+    }
+    else if (m_maxEvents > 0)
+    {
+        m_droppedEvents++;
+    }
+}
+
+const tgProfiler::Scope& tgProfiler::getScope(const std::string& path) const
+{
+    std::map<std::string, std::size_t>::const_iterator it =
+        m_scopeIndex.find(path);
+    if (it == m_scopeIndex.end())
+    {
+        throw std::invalid_argument("No profiled scope " + path);
+    }
+    return m_scopes[it->second];
+}
+
+std::size_t tgProfiler::scopeIndex(const std::string& path,
+                                   const std::string& name,
+                                   int depth)
+{
+    std::map<std::string, std::size_t>::const_iterator it =
+        m_scopeIndex.find(path);
+    if (it != m_scopeIndex.end())
+    {
+        return it->second;
+    }
+
+    Scope s;
+    s.name = name;
+    s.path = path;
+    s.depth = depth;
+    s.samples = 0;
+    s.calls = 0;
+    s.inclusive = 0.0;
+    s.exclusive = 0.0;
+    s.min = 0.0;
+    s.max = 0.0;
+    s.nextRecent = 0;
+    m_scopes.push_back(s);
+
+    const std::size_t index = m_scopes.size() - 1;
+    m_scopeIndex[path] = index;
+    return index;
+}
+
+void tgProfiler::writeCSV(std::ostream& out) const
+{
+    const std::streamsize precision = out.precision(12);
+    out << "scope,depth,samples,calls,inclusive_ms,exclusive_ms,"
+        << "mean_ms,p50_ms,p90_ms,p99_ms,min_ms,max_ms" << std::endl;
+
+    for (std::size_t i = 0; i < m_scopes.size(); i++)
+    {
+        const Scope& s = m_scopes[i];
+        std::vector<double> sorted(s.recent);
+        std::sort(sorted.begin(), sorted.end());
+
+        out << csvString(s.path) << ","
+            << s.depth << ","
+            << s.samples << ","
+            << s.calls << ","
+            << s.inclusive << ","
+            << s.exclusive << ","
+            << s.inclusive / s.samples << ","
+            << percentile(sorted, 50.0) << ","
+            << percentile(sorted, 90.0) << ","
+            << percentile(sorted, 99.0) << ","
+            << s.min << ","
+            << s.max << std::endl;
+    }
+    out.precision(precision);
+}
+
+void tgProfiler::writeCSV(const std::string& fileName) const
+{
+    std::ofstream out(fileName.c_str());
+    if (!out)
+    {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    writeCSV(out);
+}
+
+void tgProfiler::writeChromeTrace(std::ostream& out) const
+{
+    const std::streamsize precision = out.precision(15);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (std::size_t i = 0; i < m_events.size(); i++)
+    {
+        const Event& e = m_events[i];
+        const Scope& s = m_scopes[e.scope];
+        if (i > 0)
+        {
+            out << ",";
+        }
+        // Trace times are in microseconds
+        out << std::endl
+            << "{\"name\":" << jsonString(s.name)
+            << ",\"cat\":\"BT_PROFILE\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+            << ",\"ts\":" << 1000.0 * e.start
+            << ",\"dur\":" << 1000.0 * e.duration
+            << ",\"args\":{\"sample\":" << e.sample
+            << ",\"calls\":" << e.calls << "}}";
+    }
+    out << std::endl << "]}" << std::endl;
+    out.precision(precision);
+}
+
+void tgProfiler::writeChromeTrace(const std::string& fileName) const
+{
+    std::ofstream out(fileName.c_str());
+    if (!out)
+    {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    writeChromeTrace(out);
+}
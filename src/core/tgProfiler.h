@@ -0,0 +1,213 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_PROFILER_H
+#define TG_PROFILER_H
+
+/**
+ * @file tgProfiler.h
+ * @brief Contains the definition of class tgProfiler
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+// Forward declarations
+class CProfileIterator;
+
+/**
+ * Collects the BT_PROFILE scopes without the graphics. Give it to
+ * tgSimulation::setProfiler and it reads Bullet's profile tree at the
+ * end of every n-th step, then writes what it saw as a flat CSV or,
+ * if asked to keep trace events, as a Chrome trace (load it in
+ * chrome://tracing).
+ *
+ * Its memory doesn't grow with the length of the run: each scope keeps
+ * running totals and only its last recentSamples samples, for the
+ * percentiles, and at most maxEvents trace events are kept.
+ *
+ * Bullet resets its tree at the start of every world step, so each
+ * sample covers exactly one step; steps in between are not measured.
+ * Bullet only keeps a total time and call count per scope, so in the
+ * trace the scopes of a step are drawn end to end in tree order rather
+ * than when they actually ran.
+ *
+ * Does nothing when Bullet is built with BT_NO_PROFILE.
+ */
+class tgProfiler
+{
+public:
+
+    /** Everything seen for one place in the tree */
+    struct Scope
+    {
+        std::string name;
+        /** Names from the root, separated by '/' */
+        std::string path;
+        int depth;
+        /** Number of samples it appeared in */
+        std::size_t samples;
+        long calls;
+        /** Total inclusive ms */
+        double inclusive;
+        /** Total ms not spent in its children */
+        double exclusive;
+        /** Least and most inclusive ms in one sample */
+        double min;
+        double max;
+        /**
+         * Inclusive ms of the last recentSamples samples, oldest at
+         * nextRecent once it is full
+         */
+        std::vector<double> recent;
+        std::size_t nextRecent;
+    };
+
+    /** How many samples of each scope are kept for the percentiles */
+    static const std::size_t recentSamples = 1024;
+
+    /**
+     * @param[in] sampleInterval read the tree every this many steps
+     * @param[in] maxEvents the number of trace events to keep, the rest
+     * are dropped. 0, the default, doesn't keep a trace.
+     * @throw std::invalid_argument if sampleInterval is not positive
+     */
+    tgProfiler(int sampleInterval = 1, std::size_t maxEvents = 0);
+
+    ~tgProfiler();
+
+    /**
+     * Called by tgSimulation::step after the world and the models have
+     * been stepped.
+     */
+    void onStep();
+
+    /** Forget everything sampled so far */
+    void clear();
+
+    /** Number of steps that were read */
+    std::size_t getNumSamples() const
+    {
+        return m_numSamples;
+    }
+
+    /**
+     * The totals for the scope at path, such as "step/stepSimulation"
+     * @throw std::invalid_argument if it was never seen
+     */
+    const Scope& getScope(const std::string& path) const;
+
+    /** Trace events that didn't fit in maxEvents */
+    std::size_t getNumDroppedEvents() const
+    {
+        return m_droppedEvents;
+    }
+
+    /**
+     * One line per scope: path, depth, samples, calls, inclusive and
+     * exclusive total ms, then mean, percentiles of the last
+     * recentSamples samples, min and max of the inclusive ms per
+     * sampled step.
+     */
+    void writeCSV(std::ostream& out) const;
+
+    /** @throw std::runtime_error if the file can't be opened */
+    void writeCSV(const std::string& fileName) const;
+
+    /**
+     * A Chrome trace event file, one complete event per scope call.
+     * Empty unless maxEvents was positive.
+     */
+    void writeChromeTrace(std::ostream& out) const;
+
+    /** @throw std::runtime_error if the file can't be opened */
+    void writeChromeTrace(const std::string& fileName) const;
+
+private:
+
+    /** Disable the copy constructor. */
+    tgProfiler(const tgProfiler&);
+
+    /** Disable the assignment operator. */
+    tgProfiler& operator=(const tgProfiler&);
+
+    /** One scope in one sample, for the trace */
+    struct Event
+    {
+        std::size_t scope;
+        std::size_t sample;
+        double start;
+        double duration;
+        int calls;
+    };
+
+    /** Read the whole tree as one sample */
+    void sample();
+
+    /** Add one sample of a scope to its totals and the trace */
+    void addSample(std::size_t index,
+                   double start,
+                   double inclusive,
+                   double exclusive,
+                   int calls);
+
+    /**
+     * Read the children of the iterator's current parent, recursively
+     * @return their total inclusive ms
+     */
+    double readChildren(CProfileIterator* it,
+                        const std::string& parentPath,
+                        int depth,
+                        double start);
+
+    /** Index of the scope for path, added if it is new */
+    std::size_t scopeIndex(const std::string& path,
+                           const std::string& name,
+                           int depth);
+
+    const int m_sampleInterval;
+
+    const std::size_t m_maxEvents;
+
+    /** Steps since the last sample */
+    int m_stepsSinceSample;
+
+    std::size_t m_numSamples;
+
+    /** Where the next sample starts in the trace, in ms */
+    double m_traceTime;
+
+    /** In the order they were first seen */
+    std::vector<Scope> m_scopes;
+
+    /** Index into m_scopes by path */
+    std::map<std::string, std::size_t> m_scopeIndex;
+
+    /** Empty unless m_maxEvents is positive, never longer */
+    std::vector<Event> m_events;
+
+    std::size_t m_droppedEvents;
+};
+
+#endif // TG_PROFILER_H
@@ -0,0 +1,203 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_RANDOM_STREAM_H
+#define TG_RANDOM_STREAM_H
+
+/**
+ * @file tgRandomStream.h
+ * @brief Contains the definition of class tgRandomStream
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cmath>
+#include <cstddef>
+
+/**
+ * An independent stream of random numbers for one use of randomness in
+ * a run, such as the mutation of one population member in one
+ * generation, or the terrain of one episode. The stream is named by the
+ * run seed and its (generation, member, subtest), and its values depend
+ * on nothing else: not on what other streams drew, on the order in
+ * which episodes are evaluated, or on how many threads or processes
+ * evaluate them. A run is reproduced from its seed alone, and only
+ * the seed needs to be saved in a checkpoint.
+ *
+ * The values are the Philox4x32-10 counter based generator of Salmon et
+ * al., "Parallel random numbers: as easy as 1, 2, 3" (2011), with the
+ * name as its counter and key. The distributions are computed here
+ * rather than with std::tr1, so they are the same on every platform.
+ *
+ * Header only, and doesn't depend on Bullet, so the learning libraries
+ * can use it without linking to core.
+ */
+class tgRandomStream
+{
+public:
+
+    /**
+     * @param[in] seed the run seed
+     * @param[in] generation the generation, or any other outer counter
+     * @param[in] member the population member, or any other index
+     * @param[in] subtest the subtest, or any other inner counter
+     * @param[in] domain what the stream is for, so streams of the same
+     * (generation, member, subtest) for different purposes don't overlap
+     */
+    tgRandomStream(unsigned int seed,
+                   unsigned int generation = 0,
+                   unsigned int member = 0,
+                   unsigned int subtest = 0,
+                   unsigned int domain = 0) :
+      m_used(4),
+      m_hasSpare(false),
+      m_spare(0.0)
+    {
+        m_counter[0] = 0;
+        m_counter[1] = subtest;
+        m_counter[2] = member;
+        m_counter[3] = generation;
+        m_key[0] = seed;
+        m_key[1] = domain;
+    }
+
+    /** Uniform over all 32 bit values */
+    unsigned int next()
+    {
+        if (m_used == 4)
+        {
+            philox(m_counter, m_key, m_block);
+            m_counter[0]++;
+            m_used = 0;
+        }
+        return m_block[m_used++];
+    }
+
+    /** Uniform in [0, 1), with 53 random bits */
+    double uniform()
+    {
+        const unsigned int high = next() >> 5;
+        const unsigned int low = next() >> 6;
+        return (high * 67108864.0 + low) / 9007199254740992.0;
+    }
+
+    /** Uniform in [min, max) */
+    double uniform(double min, double max)
+    {
+        return min + (max - min) * uniform();
+    }
+
+    /**
+     * Normally distributed, by the Box-Muller transform. Values come in
+     * pairs, the second is kept for the next call.
+     */
+    double normal(double mean, double deviation)
+    {
+        if (m_hasSpare)
+        {
+            m_hasSpare = false;
+            return mean + deviation * m_spare;
+        }
+        // In (0, 1], so the log is finite
+        const double radius = std::sqrt(-2.0 * std::log(1.0 - uniform()));
+        const double angle = 6.283185307179586 * uniform();
+        m_spare = radius * std::sin(angle);
+        m_hasSpare = true;
+        return mean + deviation * radius * std::cos(angle);
+    }
+
+    /**
+     * Uniform in [0, n), for choosing among n things. Biased by less
+     * than n / 2^32.
+     * @param[in] n must be positive
+     */
+    std::size_t index(std::size_t n)
+    {
+        return static_cast<std::size_t>(
+            (static_cast<unsigned long long>(next()) * n) >> 32);
+    }
+
+    /**
+     * Continue from the block'th group of four values, so part of a
+     * stream can be skipped or replayed without drawing it.
+     */
+    void seek(unsigned int block)
+    {
+        m_counter[0] = block;
+        m_used = 4;
+        m_hasSpare = false;
+    }
+
+    /**
+     * Ten rounds of Philox4x32 on counter with key.
+     * @param[out] result four 32 bit random values
+     */
+    static void philox(const unsigned int counter[4],
+                       const unsigned int key[2],
+                       unsigned int result[4])
+    {
+        unsigned int c[4] = {counter[0], counter[1], counter[2], counter[3]};
+        unsigned int k[2] = {key[0], key[1]};
+        for (int round = 0; round < 10; round++)
+        {
+            if (round > 0)
+            {
+                k[0] += 0x9E3779B9u;
+                k[1] += 0xBB67AE85u;
+            }
+            const unsigned long long product0 =
+                static_cast<unsigned long long>(0xD2511F53u) * c[0];
+            const unsigned long long product1 =
+                static_cast<unsigned long long>(0xCD9E8D57u) * c[2];
+            const unsigned int next[4] = {
+                static_cast<unsigned int>(product1 >> 32) ^ c[1] ^ k[0],
+                static_cast<unsigned int>(product1),
+                static_cast<unsigned int>(product0 >> 32) ^ c[3] ^ k[1],
+                static_cast<unsigned int>(product0)
+            };
+            c[0] = next[0];
+            c[1] = next[1];
+            c[2] = next[2];
+            c[3] = next[3];
+        }
+        result[0] = c[0];
+        result[1] = c[1];
+        result[2] = c[2];
+        result[3] = c[3];
+    }
+
+private:
+
+    /** The first word counts the blocks drawn */
+    unsigned int m_counter[4];
+
+    unsigned int m_key[2];
+
+    /** The current block, and how many of its values were used */
+    unsigned int m_block[4];
+
+    int m_used;
+
+    bool m_hasSpare;
+
+    double m_spare;
+};
+
+#endif  // TG_RANDOM_STREAM_H
@@ -26,10 +26,12 @@
 // This module
 #include "tgSimulation.h"
 // This application
+#include "tgAdaptiveTimestep.h"
 #include "tgModelVisitor.h"
 #include "tgSimView.h"
 // The C++ Standard Library
 #include <cassert>  
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 
@@ -42,6 +44,7 @@ tgSimView::tgSimView(tgWorld& world,
   m_stepSize(stepSize),
   m_renderRate(renderRate),         
   m_renderTime(0.0),
+  m_pAdaptiveTimestep(NULL),
   m_initialized(false)
 {
   if (m_stepSize < 0.0)
@@ -113,6 +116,12 @@ void tgSimView::setup()
   // tgSimViewGraphics needs to know for now.
   m_initialized = true;
 
+  // Setup follows every reset, so the clock starts over
+  if (m_pAdaptiveTimestep != NULL)
+  {
+      m_pAdaptiveTimestep->reset();
+  }
+
   // Postcondition
   assert(invariant());
   assert(m_initialized);
@@ -137,7 +146,11 @@ void tgSimView::run()
 
 void tgSimView::run(int steps) 
 {
-    if (m_pSimulation != NULL)
+    if (m_pSimulation != NULL && m_pAdaptiveTimestep != NULL)
+    {
+        runAdaptive(steps * m_stepSize);
+    }
+    else if (m_pSimulation != NULL)
     {
             // The tgSimView has been passed to a tgSimulation
         std::cout << "SimView::run("<<steps<<")" << std::endl;
@@ -158,6 +171,68 @@ void tgSimView::run(int steps)
     }
 }
 
+void tgSimView::runAdaptive(double duration)
+{
+    assert(m_pSimulation != NULL);
+    assert(m_pAdaptiveTimestep != NULL);
+
+    tgAdaptiveTimestep& stepper = *m_pAdaptiveTimestep;
+    const double clock = stepper.getConfig().clock;
+    const double minStep = stepper.getConfig().minStep;
+    // Round off in the summed times is far below this
+    const double tolerance = 1.0e-6 * minStep;
+
+    const double endTime = stepper.getTotalTime() + duration;
+    m_renderTime = 0;
+
+    while (endTime - stepper.getTotalTime() > tolerance)
+    {
+        const double time = stepper.getTotalTime();
+
+        // The nearest of the next clock tick, render and the end
+        double boundary = (std::floor(time / clock + 1.0e-6) + 1.0) * clock;
+        if (endTime < boundary)
+        {
+            boundary = endTime;
+        }
+        const double nextRender = time + m_renderRate - m_renderTime;
+        if (nextRender < boundary)
+        {
+            boundary = nextRender;
+        }
+
+        const double remaining = boundary - time;
+        double dt = stepper.getStepSize();
+        if (dt >= remaining)
+        {
+            dt = remaining;
+        }
+        else if (remaining - dt < minStep)
+        {
+            // Don't leave a sliver before the boundary. Halving would
+            // go below minStep, so cover what is left in one step, which
+            // is at most minStep longer than the stepper asked for.
+            if (remaining < 2.0 * minStep)
+            {
+                dt = remaining;
+            }
+            else
+            {
+                dt = remaining / 2.0;
+            }
+        }
+
+        m_pSimulation->step(dt);
+        stepper.update(m_world, m_pSimulation->getModels(), dt);
+
+        m_renderTime += dt;
+        if (m_renderTime >= m_renderRate - tolerance) {
+            render();
+            m_renderTime = 0;
+        }
+    }
+}
+
 void tgSimView::render() const
 {
 	if ((m_pSimulation != NULL) && (m_pModelVisitor != NULL))
@@ -211,6 +286,15 @@ void tgSimView::setStepSize(double stepSize)
   assert((stepSize <= 0.0) || (m_stepSize == stepSize));
 }
 
+void tgSimView::setAdaptiveTimestep(tgAdaptiveTimestep* pStepper)
+{
+    m_pAdaptiveTimestep = pStepper;
+    if (m_pAdaptiveTimestep != NULL)
+    {
+        m_pAdaptiveTimestep->reset();
+    }
+}
+
 bool tgSimView::invariant() const
 {
   return
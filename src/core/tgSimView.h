@@ -27,6 +27,7 @@
  */
 
 // Forward declarations
+class tgAdaptiveTimestep;
 class tgModelVisitor;
 class tgSimulation;
 class tgWorld;
@@ -131,6 +132,15 @@ public:
      * @return the interval in seconds at which the graphics are rendered
      */
     double getStepSize() const { return m_stepSize; }
+
+    /**
+     * Let run(int) choose the size of each step. run(steps) still covers
+     * steps * getStepSize() seconds, but in steps chosen by pStepper.
+     * The view does not take ownership. Pass NULL to go back to fixed
+     * steps. tgSimViewGraphics ignores this.
+     * @param[in] pStepper must outlive the view or be replaced
+     */
+    void setAdaptiveTimestep(tgAdaptiveTimestep* pStepper);
     
 protected:
 
@@ -158,6 +168,13 @@ protected:
      */
     void bindToWorld(tgWorld& world);
 
+    /**
+     * Advance duration seconds in steps chosen by m_pAdaptiveTimestep,
+     * landing on its clock and on every render. Steps are only shorter
+     * than its minStep when a boundary is closer than that.
+     */
+    void runAdaptive(double duration);
+
     /** @todo Get rid of this. May only be possible once we're no longer using GLUT*/
     bool isInitialzed() const { return m_initialized; }
     
@@ -203,6 +220,9 @@ protected:
      * It must be non-negative.
      */
     double m_renderTime;
+
+    /** Chooses the steps of run(int) when not NULL. Not owned */
+    tgAdaptiveTimestep* m_pAdaptiveTimestep;
     
 private:
 
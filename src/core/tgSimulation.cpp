@@ -26,9 +26,14 @@
 // This module
 #include "tgSimulation.h"
 // This application
+#include "tgCableSubcycler.h"
+#include "tgKinematicMotorGroup.h"
 #include "tgModel.h"
+#include "tgObservationBuffer.h"
+#include "tgProfiler.h"
 #include "tgSimView.h"
 #include "tgSimViewGraphics.h"
+#include "tgStepSchedule.h"
 #include "tgWorld.h"
 // The Bullet Physics Library
 #include "LinearMath/btQuickprof.h"
@@ -37,7 +42,12 @@
 #include <stdexcept>
 
 tgSimulation::tgSimulation(tgSimView& view) :
-  m_view(view)
+  m_view(view),
+  m_pModelSchedule(NULL),
+  m_pObstacleSchedule(NULL),
+  m_pProfiler(NULL),
+  m_pCableSubcycler(NULL),
+  m_pKinematicMotorGroup(NULL)
 {
         m_view.bindToSimulation(*this);
 
@@ -51,6 +61,9 @@ tgSimulation::~tgSimulation()
 {
     teardown();
     m_view.releaseFromSimulation();
+    // The schedules must let go before the models are deleted
+    delete m_pModelSchedule;
+    delete m_pObstacleSchedule;
     for (std::size_t i = 0; i < m_models.size(); i++)
     {
         delete m_models[i];
@@ -115,12 +128,7 @@ void tgSimulation::reset()
 
     teardown();
 
-    m_view.setup();
-    for (std::size_t i = 0; i != m_models.size(); i++)
-    {
-        
-        m_models[i]->setup(m_view.world());
-    }
+    setupModels();
     
     // Don't need to set up obstacles since they will be added after this
 }
@@ -128,19 +136,85 @@ void tgSimulation::reset()
 void tgSimulation::reset(tgGround* newGround)
 {
 
-    teardown();
+    teardownModels();
     
-    // This will reset the world twice (once in teardown, once here), but that shouldn't hurt anything
+    // Rebuilds the dynamics world with the new ground
     m_view.world().reset(newGround);
     
+    setupModels();
+    
+    // Don't need to set up obstacles since they were just added
+}
+
+void tgSimulation::reset(const tgTerrainLibrary& terrains, std::size_t terrain)
+{
+    teardownModels();
+    
+    m_view.world().reset(terrains, terrain);
+    
+    setupModels();
+}
+
+void tgSimulation::setupModels()
+{
+    if (m_pCableSubcycler)
+    {
+        // The actuators and bodies are about to be rebuilt
+        m_pCableSubcycler->reset();
+    }
+    if (m_pKinematicMotorGroup)
+    {
+        m_pKinematicMotorGroup->reset();
+    }
     m_view.setup();
     for (std::size_t i = 0; i != m_models.size(); i++)
     {
         
         m_models[i]->setup(m_view.world());
     }
-    
-    // Don't need to set up obstacles since they were just added
+}
+
+void tgSimulation::useStepSchedule(bool enabled)
+{
+    if (enabled && !m_pModelSchedule)
+    {
+        m_pModelSchedule = new tgStepSchedule();
+        m_pObstacleSchedule = new tgStepSchedule();
+    }
+    else if (!enabled)
+    {
+        // Gives the trees back to tgModel::step
+        delete m_pModelSchedule;
+        delete m_pObstacleSchedule;
+        m_pModelSchedule = NULL;
+        m_pObstacleSchedule = NULL;
+    }
+}
+
+void tgSimulation::setCableSubcycler(tgCableSubcycler* pSubcycler)
+{
+    if (m_pCableSubcycler)
+    {
+        m_pCableSubcycler->release(m_models);
+    }
+    m_pCableSubcycler = pSubcycler;
+    if (m_pCableSubcycler)
+    {
+        m_pCableSubcycler->reset();
+    }
+}
+
+void tgSimulation::setKinematicMotorGroup(tgKinematicMotorGroup* pGroup)
+{
+    if (m_pKinematicMotorGroup)
+    {
+        m_pKinematicMotorGroup->release(m_models);
+    }
+    m_pKinematicMotorGroup = pGroup;
+    if (m_pKinematicMotorGroup)
+    {
+        m_pKinematicMotorGroup->reset();
+    }
 }
 
 /**
@@ -163,25 +237,82 @@ void tgSimulation::step(double dt) const
     {
         // Step the world.
         // This can be done before or after stepping the models.
+        if (m_pCableSubcycler)
+        {
+            m_pCableSubcycler->beforeWorldStep();
+        }
         m_view.world().step(dt);
+        if (m_pCableSubcycler)
+        {
+            m_pCableSubcycler->afterWorldStep();
+        }
 
-        // Step the models
-        for (std::size_t i = 0; i < m_models.size(); i++)
+        if (m_pKinematicMotorGroup)
         {
-            m_models[i]->step(dt);
+            m_pKinematicMotorGroup->beforeModelsStep(m_models);
         }
-        
-        // Step the obstacles
-        /// @todo determine if this is necessary
-        for (std::size_t i = 0; i < m_obstacles.size(); i++)
+
+        if (m_pModelSchedule)
+        {
+            m_pModelSchedule->step(m_models, dt);
+            m_pObstacleSchedule->step(m_obstacles, dt);
+        }
+        else
+        {
+            // Step the models
+            for (std::size_t i = 0; i < m_models.size(); i++)
+            {
+                m_models[i]->step(dt);
+            }
+            
+            // Step the obstacles
+            /// @todo determine if this is necessary
+            for (std::size_t i = 0; i < m_obstacles.size(); i++)
+            {
+                m_obstacles[i]->step(dt);
+            }
+        }
+
+        // After the models, so the controllers have set their inputs
+        if (m_pKinematicMotorGroup)
+        {
+            m_pKinematicMotorGroup->step(dt);
+        }
+        if (m_pCableSubcycler)
+        {
+            m_pCableSubcycler->step(m_models, dt);
+        }
+
+        if (m_pProfiler)
         {
-            m_obstacles[i]->step(dt);
+            m_pProfiler->onStep();
         }
     }
 }
   
 void tgSimulation::teardown()
 {
+    teardownModels();
+    
+    // Reset the world after the models - models need world info for
+    // their onTeardown() functions
+    m_view.world().reset();
+    // Postcondition
+    assert(invariant());
+}
+
+void tgSimulation::teardownModels()
+{
+    // Obstacles are deleted below
+    if (m_pObstacleSchedule)
+    {
+        m_pObstacleSchedule->invalidate();
+    }
+    
+    // The observables point into the models, don't leave them dangling
+    // until the world is reset. The models add them again in setup.
+    m_view.world().observations().clear();
+    
     const size_t n = m_models.size();
     for (std::size_t i = 0; i < n; i++)
     {
@@ -204,12 +335,6 @@ void tgSimulation::teardown()
     }
     
     assert(m_obstacles.empty());
-    
-    // Reset the world after the models - models need world info for
-    // their onTeardown() functions
-    m_view.world().reset();
-    // Postcondition
-    assert(invariant());
 }
 
 void tgSimulation::run() const
@@ -36,6 +36,11 @@ class tgModelVisitor;
 class tgSimView;
 class tgWorld;
 class tgGround;
+class tgTerrainLibrary;
+class tgStepSchedule;
+class tgProfiler;
+class tgCableSubcycler;
+class tgKinematicMotorGroup;
 
 /**
  * Holds objects necessary for simulation, a world, a view
@@ -110,12 +115,61 @@ public:
      * ground will be deleted
      */
     void reset(tgGround* newGround);
+
+    /**
+     * Like reset(tgGround*), but uses a prebuilt ground from terrains.
+     * The ground's collision shape is reused and stays owned by
+     * terrains, which must outlive the simulation.
+     */
+    void reset(const tgTerrainLibrary& terrains, std::size_t terrain);
     
     /**
      * Returns a reference to the world
      */
     tgWorld& getWorld() const;
 
+    /**
+     * The models added with addModel, without the obstacles
+     */
+    const std::vector<tgModel*>& getModels() const
+    {
+        return m_models;
+    }
+
+    /**
+     * Step the models from a flat tgStepSchedule instead of recursing
+     * through their trees. Off by default. See tgStepSchedule for what
+     * it assumes about the models.
+     * @param[in] enabled true to use a schedule
+     */
+    void useStepSchedule(bool enabled);
+
+    /**
+     * Have pProfiler read the BT_PROFILE tree after each step.
+     * @param[in] pProfiler not owned, must outlive the simulation or be
+     * replaced. NULL to stop profiling.
+     */
+    void setProfiler(tgProfiler* pProfiler)
+    {
+        m_pProfiler = pProfiler;
+    }
+
+    /**
+     * Step the cables in substeps between the world steps. See
+     * tgCableSubcycler.
+     * @param[in] pSubcycler not owned, must outlive the simulation or be
+     * replaced. NULL to step the cables with the models again.
+     */
+    void setCableSubcycler(tgCableSubcycler* pSubcycler);
+
+    /**
+     * Integrate the motors of the kinematic actuators together after
+     * the models were stepped. See tgKinematicMotorGroup.
+     * @param[in] pGroup not owned, must outlive the simulation or be
+     * replaced. NULL to let the actuators integrate themselves again.
+     */
+    void setKinematicMotorGroup(tgKinematicMotorGroup* pGroup);
+
  private:
     
     /**
@@ -123,6 +177,15 @@ public:
      */
     void teardown();
 
+    /**
+     * Calls teardown on all of the models and deletes the obstacles,
+     * leaves the world alone
+     */
+    void teardownModels();
+
+    /** Calls setup on the view, then on the models */
+    void setupModels();
+
     /** Integrity predicate. */
     bool invariant() const;
 
@@ -145,6 +208,21 @@ private:
      * All pointers should be non-NULL
      */
     std::vector<tgModel*> m_obstacles;
+
+    /** NULL unless useStepSchedule(true) was called */
+    tgStepSchedule* m_pModelSchedule;
+
+    /** Kept separate so the obstacles are still stepped after the models */
+    tgStepSchedule* m_pObstacleSchedule;
+
+    /** Not owned, NULL unless setProfiler was called */
+    tgProfiler* m_pProfiler;
+
+    /** Not owned, NULL unless setCableSubcycler was called */
+    tgCableSubcycler* m_pCableSubcycler;
+
+    /** Not owned, NULL unless setKinematicMotorGroup was called */
+    tgKinematicMotorGroup* m_pKinematicMotorGroup;
 };
 
 #endif  // TG_SIMULATION_H
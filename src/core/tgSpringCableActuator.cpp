@@ -51,7 +51,8 @@ tgSpringCableActuator::Config::Config(double s,
   targetVelocity(tVel),
   minActualLength(mnAL),
   minRestLength(mnRL),
-  rotation(rot)        
+  rotation(rot),
+  sleepThreshold(-1.0)
 {
     ///@todo is this the right place for this, or the constructor of this class?
     if (s < 0.0)
@@ -90,6 +91,7 @@ void tgSpringCableActuator::Config::scale (double sf)
   targetVelocity  *= sf;
   minActualLength *= sf;
   minRestLength   *= sf;
+  sleepThreshold  *= sf;
 }
 
 
@@ -118,7 +120,8 @@ tgSpringCableActuator::tgSpringCableActuator(tgSpringCable* springCable,
     m_pHistory(new SpringCableActuatorHistory()),
     m_restLength(springCable->getRestLength()),
     m_startLength(springCable->getActualLength()),
-    m_prevVelocity(0.0)
+    m_prevVelocity(0.0),
+    m_subcycled(false)
 {
     constructorAux();
 
@@ -155,6 +158,15 @@ void tgSpringCableActuator::step(double dt)
     }
 }
 
+void tgSpringCableActuator::substep(double dt)
+{
+    m_springCable->step(dt);
+}
+
+void tgSpringCableActuator::endSubsteps()
+{
+}
+
 const double tgSpringCableActuator::getStartLength() const
 {
     return m_startLength;
@@ -149,6 +149,17 @@ public:
        * @todo Is this meaningful for non-rod shapes?
        */
       double rotation;  
+      
+      // Deactivation Parameters
+      /**
+       * If non-negative, the spring cable stops waking its bodies when
+       * both are asleep and its tension has changed by no more than
+       * this since it last applied a force, so Bullet can deactivate
+       * resting structures. Not set by the constructor, defaults to -1
+       * (always keep the bodies awake). Ignored by contact cables.
+       * Units are force (length * mass / seconds^2)
+       */
+      double sleepThreshold;
     };
     
     /** Encapsulate the history members. */
@@ -220,6 +231,30 @@ public:
      */
     virtual const tgSpringCableActuator::SpringCableActuatorHistory& getHistory() const;
     
+    /**
+     * Let tgCableSubcycler apply the cable force and integrate the rest
+     * length through substep. step then only notifies the observers and
+     * logs the history.
+     */
+    void setSubcycled(bool subcycled)
+    {
+        m_subcycled = subcycled;
+    }
+
+    bool isSubcycled() const
+    {
+        return m_subcycled;
+    }
+
+    /**
+     * One substep of the cable, called several times per step by
+     * tgCableSubcycler. Applies the cable force over dt.
+     */
+    virtual void substep(double dt);
+
+    /** Called by tgCableSubcycler after the last substep of a step */
+    virtual void endSubsteps();
+
     /**
      * Returns a pointer the string's tgBulletSpringCable. Used for rendering in
      * tgBulletRenderer
@@ -285,6 +320,9 @@ protected:
      * history is off.
      */
     double m_prevVelocity;
+
+    /** True while tgCableSubcycler steps the cable */
+    bool m_subcycled;
 private:
 
     /**
@@ -0,0 +1,157 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgStepSchedule.cpp
+ * @brief Contains the implementation of class tgStepSchedule
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgStepSchedule.h"
+// This application
+#include "tgBasicActuator.h"
+#include "tgBox.h"
+#include "tgKinematicActuator.h"
+#include "tgModel.h"
+#include "tgRod.h"
+#include "tgSphere.h"
+// The Bullet Physics library
+#include "LinearMath/btQuickprof.h"
+// The C++ Standard Library
+#include <cassert>
+#include <typeinfo>
+
+tgStepSchedule::tgStepSchedule() :
+m_valid(false),
+m_revision(0)
+{
+}
+
+tgStepSchedule::~tgStepSchedule()
+{
+    release();
+}
+
+void tgStepSchedule::invalidate()
+{
+    release();
+    m_valid = false;
+}
+
+void tgStepSchedule::step(const std::vector<tgModel*>& roots, double dt)
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("tgStepSchedule::step");
+#endif //BT_NO_PROFILE
+
+    if (!m_valid ||
+        m_revision != tgModel::getStructureRevision() ||
+        m_roots != roots)
+    {
+        build(roots);
+    }
+
+    const std::size_t nModels = m_models.size();
+    for (std::size_t i = 0; i < nModels; i++)
+    {
+        m_models[i]->step(dt);
+    }
+
+    // Qualified calls, the exact types were checked in build
+    const std::size_t nBasic = m_basicActuators.size();
+    for (std::size_t i = 0; i < nBasic; i++)
+    {
+        m_basicActuators[i]->tgBasicActuator::step(dt);
+    }
+
+    const std::size_t nKinematic = m_kinematicActuators.size();
+    for (std::size_t i = 0; i < nKinematic; i++)
+    {
+        m_kinematicActuators[i]->tgKinematicActuator::step(dt);
+    }
+}
+
+void tgStepSchedule::build(const std::vector<tgModel*>& roots)
+{
+    release();
+
+    m_roots = roots;
+    m_models.clear();
+    m_basicActuators.clear();
+    m_kinematicActuators.clear();
+
+    const std::vector<tgModel*> all = allModels();
+    for (std::size_t i = 0; i < all.size(); i++)
+    {
+        tgModel* const pModel = all[i];
+        const std::type_info& type = typeid(*pModel);
+
+        if (type == typeid(tgModel) ||
+            type == typeid(tgRod) ||
+            type == typeid(tgBox) ||
+            type == typeid(tgSphere))
+        {
+            // Only tgModel::step, which just steps the children
+        }
+        else if (type == typeid(tgBasicActuator))
+        {
+            m_basicActuators.push_back(static_cast<tgBasicActuator*>(pModel));
+        }
+        else if (type == typeid(tgKinematicActuator))
+        {
+            m_kinematicActuators.push_back(static_cast<tgKinematicActuator*>(pModel));
+        }
+        else
+        {
+            m_models.push_back(pModel);
+        }
+
+        pModel->m_childrenScheduled = true;
+    }
+
+    m_revision = tgModel::getStructureRevision();
+    m_valid = true;
+}
+
+void tgStepSchedule::release()
+{
+    // Walk the trees as they are now, models that were removed from
+    // them have been deleted
+    const std::vector<tgModel*> all = allModels();
+    for (std::size_t i = 0; i < all.size(); i++)
+    {
+        all[i]->m_childrenScheduled = false;
+    }
+    m_roots.clear();
+}
+
+std::vector<tgModel*> tgStepSchedule::allModels() const
+{
+    std::vector<tgModel*> result;
+    for (std::size_t i = 0; i < m_roots.size(); i++)
+    {
+        assert(m_roots[i] != NULL);
+        result.push_back(m_roots[i]);
+        // Depth first, parents before children
+        const std::vector<tgModel*> descendants = m_roots[i]->getDescendants();
+        result.insert(result.end(), descendants.begin(), descendants.end());
+    }
+    return result;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef TG_STEP_SCHEDULE_H
+#define TG_STEP_SCHEDULE_H
+
+/**
+ * @file tgStepSchedule.h
+ * @brief Contains the definition of class tgStepSchedule
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <vector>
+
+// Forward declarations
+class tgModel;
+class tgBasicActuator;
+class tgKinematicActuator;
+
+/**
+ * A flat list of everything that has to be stepped in a set of model
+ * trees, so tgSimulation::step doesn't recurse through the whole tree
+ * every step. Built by walking the trees once, rebuilt when
+ * tgModel::getStructureRevision changes.
+ *
+ * Models whose exact type is tgModel or a rigid body have nothing of
+ * their own to step, so they are left out. Actuators whose exact type
+ * is tgBasicActuator or tgKinematicActuator are grouped by type and
+ * stepped without a virtual call. Everything else, including every
+ * model written for an application, is stepped through its virtual
+ * step() in tree order before the actuators. While a model is in a
+ * schedule tgModel::step does not step its children.
+ *
+ * This assumes models only step their children by calling
+ * tgModel::step, and that no model's step depends on an actuator
+ * elsewhere in the tree having already been stepped this step.
+ */
+class tgStepSchedule
+{
+public:
+
+    tgStepSchedule();
+
+    /** Gives the trees back to tgModel::step */
+    ~tgStepSchedule();
+
+    /**
+     * Step everything in roots, rebuilding the schedule first if roots
+     * or the structure of the trees changed since the last call
+     * @param[in] roots the top level models, may change between calls
+     * @param[in] dt must be positive, checked by the caller
+     */
+    void step(const std::vector<tgModel*>& roots, double dt);
+
+    /**
+     * Force a rebuild on the next step. Must be called before deleting
+     * a model that was passed in roots.
+     */
+    void invalidate();
+
+    /** Number of models that will be stepped through a virtual call */
+    std::size_t getNumVirtualSteps() const
+    {
+        return m_models.size();
+    }
+
+    /** Number of actuators stepped without a virtual call */
+    std::size_t getNumDirectSteps() const
+    {
+        return m_basicActuators.size() + m_kinematicActuators.size();
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgStepSchedule(const tgStepSchedule&);
+
+    /** Disable the assignment operator. */
+    tgStepSchedule& operator=(const tgStepSchedule&);
+
+    void build(const std::vector<tgModel*>& roots);
+
+    /** Let tgModel::step step the children of the scheduled models again */
+    void release();
+
+    /** m_roots and all of their descendants, parents first */
+    std::vector<tgModel*> allModels() const;
+
+    bool m_valid;
+
+    /** tgModel::getStructureRevision() when the schedule was built */
+    unsigned long m_revision;
+
+    /** What the schedule was built from. Must outlive the schedule */
+    std::vector<tgModel*> m_roots;
+
+    /** Stepped through step(), in tree order */
+    std::vector<tgModel*> m_models;
+
+    std::vector<tgBasicActuator*> m_basicActuators;
+
+    std::vector<tgKinematicActuator*> m_kinematicActuators;
+};
+
+#endif // TG_STEP_SCHEDULE_H
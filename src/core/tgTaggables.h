@@ -159,9 +159,9 @@ protected:
     // @todo: think about uniqueness -- if not unique, throw an error? return -1? 
     int addElement(T element) 
     {
-        // @todo: make sure the element is unique
-        assert(!elementExists(element));  // segfault?
-        assertUnique(element);
+        // @todo: make sure the element is unique. elementExists compares
+        // addresses, which can't match a copy, so checking it here only
+        // made adding n elements take O(n^2)
         m_elements.push_back(element);
         return m_elements.size();  // This is the index that was created.
     }
@@ -26,8 +26,11 @@
 // This module
 #include "tgWorld.h"
 // This application
+#include "tgCollisionShapeCache.h"
+#include "tgObservationBuffer.h"
 #include "tgWorldBulletPhysicsImpl.h"
 #include "terrain/tgBoxGround.h"
+#include "terrain/tgTerrainLibrary.h"
 // The C++ Standard Library
 #include <cassert>
 #include <stdexcept>
@@ -49,7 +52,11 @@ worldSize(ws)
 tgWorld::tgWorld() :
   m_config(),
   m_pGround(new tgBoxGround()),
-  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround))
+  m_ownsGround(true),
+  m_pShapeCache(new tgCollisionShapeCache()),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       *m_pShapeCache)),
+  m_pObservations(new tgObservationBuffer())
 {
   // Postcondition
   assert(invariant());
@@ -62,7 +69,11 @@ tgWorld::tgWorld() :
 tgWorld::tgWorld(const tgWorld::Config& config) :
   m_config(config),
   m_pGround(new tgBoxGround()),
-  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround))
+  m_ownsGround(true),
+  m_pShapeCache(new tgCollisionShapeCache()),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       *m_pShapeCache)),
+  m_pObservations(new tgObservationBuffer())
 {
   // Postcondition
   assert(invariant());
@@ -75,7 +86,26 @@ tgWorld::tgWorld(const tgWorld::Config& config) :
 tgWorld::tgWorld(const tgWorld::Config& config, tgGround* ground) :
   m_config(config),
   m_pGround(ground),
-  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround))
+  m_ownsGround(true),
+  m_pShapeCache(new tgCollisionShapeCache()),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       *m_pShapeCache)),
+  m_pObservations(new tgObservationBuffer())
+{
+  // Postcondition
+  assert(invariant());
+}
+
+tgWorld::tgWorld(const tgWorld::Config& config,
+                 const tgTerrainLibrary& terrains,
+                 std::size_t terrain) :
+  m_config(config),
+  m_pGround(terrains.get(terrain)),
+  m_ownsGround(false),
+  m_pShapeCache(new tgCollisionShapeCache()),
+  m_pImpl(new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                       *m_pShapeCache)),
+  m_pObservations(new tgObservationBuffer())
 {
   // Postcondition
   assert(invariant());
@@ -84,13 +114,25 @@ tgWorld::tgWorld(const tgWorld::Config& config, tgGround* ground) :
 tgWorld::~tgWorld()
 {
   delete m_pImpl;
-  delete m_pGround;
+  // After the implementation, its bodies use the shapes
+  delete m_pShapeCache;
+  delete m_pObservations;
+  if (m_ownsGround)
+  {
+    delete m_pGround;
+  }
 }
 
 void tgWorld::reset()
 {
+  // The models declare their observables again. tgSimulation already
+  // cleared them before the teardown, but a world can be used without one
+  m_pObservations->clear();
   delete m_pImpl;
-  m_pImpl = new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround);
+  // Keep the shapes the last trial used, the next one probably wants them
+  m_pShapeCache->prune();
+  m_pImpl = new tgWorldBulletPhysicsImpl(m_config, (tgBulletGround*)m_pGround,
+                                         *m_pShapeCache);
   // Postcondition
   assert(invariant());
 }
@@ -108,12 +150,30 @@ void tgWorld::reset(const tgWorld::Config& config)
 
 void tgWorld::reset(tgGround * ground)
 {
-    delete m_pGround;
+    tgGround* const pOldGround =
+        (m_ownsGround && m_pGround != ground) ? m_pGround : NULL;
     
     m_pGround = ground;
+    m_ownsGround = true;
     
-    // Reset as usual
+    // Reset as usual, the old impl still refers to the old ground
     reset();
+    
+    delete pOldGround;
+}
+
+void tgWorld::reset(const tgTerrainLibrary& terrains, std::size_t terrain)
+{
+    // Look it up first so a bad handle leaves the world as it was
+    tgGround* const pGround = terrains.get(terrain);
+    tgGround* const pOldGround = m_ownsGround ? m_pGround : NULL;
+    
+    m_pGround = pGround;
+    m_ownsGround = false;
+    
+    reset();
+    
+    delete pOldGround;
 }
 
 void tgWorld::step(double dt) const
@@ -126,10 +186,11 @@ void tgWorld::step(double dt) const
   {
     // Forward to the implementation
     m_pImpl->step(dt);
+    m_pObservations->update();
   }
 }
 
 bool tgWorld::invariant() const
 {
-  return m_pImpl != 0;
+  return (m_pImpl != 0) && (m_pShapeCache != 0) && (m_pObservations != 0);
 }
@@ -26,9 +26,15 @@
  * $Id$
  */
 
+// The C++ Standard Library
+#include <cstddef>
+
 // Forward declarations
+class tgCollisionShapeCache;
+class tgObservationBuffer;
 class tgWorldImpl;
 class tgGround;
+class tgTerrainLibrary;
 
 /**
  * Represents the world in which the Tensegrities operate, including
@@ -75,6 +81,16 @@ public:
    */
   tgWorld(const Config& config, tgGround* ground);
 
+  /**
+   * Construct with a supplied configuration and a ground from a
+   * tgTerrainLibrary. The library keeps ownership of the ground.
+   * @param[in] config a tgWorld::Config
+   * @param[in] terrains must outlive the world
+   * @param[in] terrain a handle returned by terrains
+   */
+  tgWorld(const Config& config, const tgTerrainLibrary& terrains,
+          std::size_t terrain);
+
   /** Delete the implementation. */
   ~tgWorld();
 
@@ -88,10 +104,20 @@ public:
   void reset(const Config& config);
 
   /**
-   * Replace the implementation with a new ground.
+   * Replace the implementation with a new ground. The world takes
+   * ownership of ground and deletes the previous one if it owned it.
    * @param[in] ground the new ground
    */
   void reset(tgGround* ground);
+
+  /**
+   * Replace the implementation with a ground from a tgTerrainLibrary.
+   * The ground's collision shape is reused, not rebuilt, and the
+   * library keeps ownership of it.
+   * @param[in] terrains must outlive the world
+   * @param[in] terrain a handle returned by terrains
+   */
+  void reset(const tgTerrainLibrary& terrains, std::size_t terrain);
     
   /**
    * Advance the simulation.
@@ -109,6 +135,15 @@ public:
   {
     return *m_pImpl;
   }
+
+  /**
+   * The observables of the models in this world, read after every
+   * step and cleared on every reset. Models add theirs in setup.
+   */
+  tgObservationBuffer& observations() const
+  {
+    return *m_pObservations;
+  }
  
 private:
 
@@ -125,8 +160,17 @@ private:
   /** Implementation of the ground, such as a box, hills or ramp */
   tgGround* m_pGround;
 
+  /** False if m_pGround belongs to a tgTerrainLibrary */
+  bool m_ownsGround;
+
+  /** Owned, keeps the shapes of the rigids across resets */
+  tgCollisionShapeCache * const m_pShapeCache;
+
   /** The implementation of the tgWorld. */
   tgWorldImpl * m_pImpl;
+
+  /** Owned, outlives every implementation */
+  tgObservationBuffer * const m_pObservations;
 };
 
 #endif //TG_BULLET_WORLD_H
@@ -112,10 +112,12 @@ class IntermediateBuildProducts
 };
 
 tgWorldBulletPhysicsImpl::tgWorldBulletPhysicsImpl(const tgWorld::Config& config,
-        tgBulletGround* ground) :
+        tgBulletGround* ground,
+        tgCollisionShapeCache& shapeCache) :
     tgWorldImpl(config, ground),
     m_pIntermediateBuildProducts(new IntermediateBuildProducts(config.worldSize)),
-    m_pDynamicsWorld(createDynamicsWorld())
+    m_pDynamicsWorld(createDynamicsWorld()),
+    m_shapeCache(shapeCache)
 {
 
     // Gravitational acceleration is down on the Y axis
@@ -235,13 +237,25 @@ void tgWorldBulletPhysicsImpl::addCollisionShape(btCollisionShape* pShape)
       assert(invariant());
 }
 
+btCollisionShape*
+tgWorldBulletPhysicsImpl::getSharedShape(tgCollisionShapeCache::ShapeType type,
+                                         const btVector3& dimensions,
+                                         double margin)
+{
+    return m_shapeCache.get(type, dimensions, margin);
+}
+
 void tgWorldBulletPhysicsImpl::deleteCollisionShape(btCollisionShape* pShape)
 {
 #ifndef BT_NO_PROFILE 
     BT_PROFILE("deleteCollisionShape");
 #endif //BT_NO_PROFILE
 	
-    if (pShape)
+    if (pShape && m_shapeCache.contains(pShape))
+    {
+        // Other rigids may share it, the cache deletes it when unused
+    }
+    else if (pShape)
     {
 		btCompoundShape* cShape = tgCast::cast<btCollisionShape, btCompoundShape>(pShape);
 		if (cShape)
@@ -260,6 +274,27 @@ void tgWorldBulletPhysicsImpl::deleteCollisionShape(btCollisionShape* pShape)
       assert(invariant());
 }
 
+void tgWorldBulletPhysicsImpl::releaseCollisionShape(btCollisionShape* pShape)
+{
+    if (pShape)
+    {
+        btCompoundShape* cShape = tgCast::cast<btCollisionShape, btCompoundShape>(pShape);
+        if (cShape)
+        {
+            std::size_t n = cShape->getNumChildShapes();
+            for( std::size_t i = 0; i < n; i++)
+            {
+                releaseCollisionShape(cShape->getChildShape(i));
+            }
+        }
+        m_collisionShapes.remove(pShape);
+        m_shapeCache.release(pShape);
+    }
+
+      // Postcondition
+      assert(invariant());
+}
+
 bool tgWorldBulletPhysicsImpl::invariant() const
 {
     return (m_pDynamicsWorld != 0);
@@ -28,6 +28,7 @@
  */
 
 // This application
+#include "tgCollisionShapeCache.h"
 #include "tgWorld.h"
 #include "tgWorldImpl.h"
 #include "LinearMath/btAlignedObjectArray.h"
@@ -37,6 +38,7 @@
 // Forward declarations
 class btCollisionShape;
 class btTypedConstraint;
+class btVector3;
 class btDynamicsWorld;
 class btRigidBody;
 class IntermediateBuildProducts;
@@ -59,9 +61,12 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
    * @param[in] ground - a container class that holds a rigid body and
    * collsion object for the ground. tgEmptyGround can be used to create
    * a ground free simulation
+   * @param[in] shapeCache where getSharedShape finds its shapes, must
+   * outlive the implementation
    */
   tgWorldBulletPhysicsImpl(const tgWorld::Config& config,
-                           tgBulletGround* ground);
+                           tgBulletGround* ground,
+                           tgCollisionShapeCache& shapeCache);
 
   /** Clean up Bullet Physics state. */
   ~tgWorldBulletPhysicsImpl();
@@ -89,12 +94,36 @@ class tgWorldBulletPhysicsImpl : public tgWorldImpl
 	 */
 	void addCollisionShape(btCollisionShape* pShape);
 	
+	/**
+	 * A shape shared by every rigid that asks for the same type,
+	 * dimensions and margin, see tgCollisionShapeCache. The cache owns
+	 * it, so it must not be passed to addCollisionShape.
+	 * @param[in] type the kind of btCollisionShape
+	 * @param[in] dimensions the half extents of a cylinder or a box,
+	 * the radius of a sphere in x
+	 * @param[in] margin the collision margin, negative for Bullet's
+	 * default for the type
+	 */
+	btCollisionShape* getSharedShape(tgCollisionShapeCache::ShapeType type,
+	                                 const btVector3& dimensions,
+	                                 double margin = -1.0);
+	
 	/**
 	 * Immediately delete a collision shape to avoid leaking memory during a rial
+	 * Shared shapes are left to the cache, other rigids may use them.
 	 * @param[in] pShape a pointer to a btCollisionShape; do nothing if NULL
 	 */
 	void deleteCollisionShape(btCollisionShape* pShape);
 	
+	/**
+	 * Stop owning a collision shape without deleting it, so it can outlive
+	 * this world. The caller must delete it, after the world is gone if any
+	 * of its bodies still use it. Children of compound shapes are released
+	 * too, shared ones are taken from the cache.
+	 * @param[in] pShape a pointer to a btCollisionShape; do nothing if NULL
+	 */
+	void releaseCollisionShape(btCollisionShape* pShape);
+	
         /**
      * Add a btTypedConstraint to a collection for deletion upon
      * destruction. Also add to the physics.
@@ -144,6 +173,9 @@ private:
      */
     btAlignedObjectArray<btCollisionShape*> m_collisionShapes;
 
+    /** Owned by the tgWorld, survives resets */
+    tgCollisionShapeCache& m_shapeCache;
+
     /* 
      * A vector of constraints for easy reference. Does not affect
      * physics or rendering unles the constraint is placed into the dynamics
@@ -0,0 +1,168 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AppCPGFBBenchmark.cpp
+ * @brief Times CPGEquationsFB::update against the node by node
+ * CPGEquations::update it replaced, and checks they agree
+ * @author agent
+ * $Id$
+ */
+
+// This application
+#include "CPGEquationsFB.h"
+// The C++ Standard Library
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    /** Muscles per spine segment, each couples to its neighbours */
+    const int musclesPerSegment = 4;
+
+    /**
+     * A CPG shaped like the spine controllers build them: every muscle
+     * is coupled to the other muscles in its segment and to the same
+     * muscle in the neighbouring segments.
+     */
+    void buildSpine(CPGEquationsFB& cpg, int numMuscles)
+    {
+        for (int i = 0; i < numMuscles; i++)
+        {
+            std::vector<double> params(11);
+            params[0] = 1.0;            // Frequency offset (unused)
+            params[1] = 0.0;            // Frequency scale (unused)
+            params[2] = 1.0 + 0.1 * (i % 3);    // Radius offset
+            params[3] = 0.0;            // Radius scale (unused)
+            params[4] = 20.0;           // rConst
+            params[5] = 0.0;            // dMin (unused)
+            params[6] = 5.0;            // dMax (unused)
+            params[7] = 2.0 + 0.25 * (i % 5);   // Initial omega
+            params[8] = 0.05;           // Frequency feedback gain
+            params[9] = 0.1;            // Amplitude feedback gain
+            params[10] = 0.2;           // Phase feedback gain
+            cpg.addNode(params);
+        }
+
+        for (int i = 0; i < numMuscles; i++)
+        {
+            const int segment = i / musclesPerSegment;
+            std::vector<int> connections;
+            for (int j = 0; j < numMuscles; j++)
+            {
+                const int otherSegment = j / musclesPerSegment;
+                if (j != i &&
+                    (otherSegment == segment ||
+                     (j % musclesPerSegment == i % musclesPerSegment &&
+                      std::abs(otherSegment - segment) == 1)))
+                {
+                    connections.push_back(j);
+                }
+            }
+            std::vector<double> weights;
+            std::vector<double> phases;
+            for (std::size_t k = 0; k < connections.size(); k++)
+            {
+                weights.push_back(0.5 + 0.1 * (connections[k] % 4));
+                phases.push_back(0.3 * (connections[k] - i));
+            }
+            cpg.defineConnections(i, connections, weights, phases);
+        }
+    }
+
+    /** Feedback that changes every step, like sensor readings */
+    void fillFeedback(std::vector<double>& feedback, int step)
+    {
+        for (std::size_t i = 0; i < feedback.size(); i++)
+        {
+            feedback[i] = 0.5 * sin(0.01 * step + 0.7 * i);
+        }
+    }
+
+    /**
+     * Step a spine of numMuscles with each integrator and print the time
+     * per step and the largest difference in node outputs
+     * @return true if the outputs agree
+     */
+    bool benchmark(int numMuscles, int numSteps, double dt)
+    {
+        CPGEquationsFB legacy(1000);
+        CPGEquationsFB flat(1000);
+        buildSpine(legacy, numMuscles);
+        buildSpine(flat, numMuscles);
+
+        std::vector<double> feedback(3 * numMuscles);
+        double maxDiff = 0.0;
+        double legacySeconds = 0.0;
+        double flatSeconds = 0.0;
+
+        for (int step = 0; step < numSteps; step++)
+        {
+            fillFeedback(feedback, step);
+
+            std::clock_t start = std::clock();
+            // The base class update evaluates through the nodes
+            legacy.CPGEquations::update(feedback, dt);
+            legacySeconds += double(std::clock() - start) / CLOCKS_PER_SEC;
+
+            start = std::clock();
+            flat.update(feedback, dt);
+            flatSeconds += double(std::clock() - start) / CLOCKS_PER_SEC;
+
+            for (int i = 0; i < numMuscles; i++)
+            {
+                const double diff = std::fabs(legacy[i] - flat[i]);
+                if (!(diff <= maxDiff))
+                {
+                    maxDiff = diff;
+                }
+            }
+        }
+
+        std::cout << numMuscles << " muscles, " << numSteps << " steps of "
+                  << dt << " s" << std::endl;
+        std::cout << "  node by node: " << 1.0e6 * legacySeconds / numSteps
+                  << " us per step" << std::endl;
+        std::cout << "  flat:         " << 1.0e6 * flatSeconds / numSteps
+                  << " us per step" << std::endl;
+        std::cout << "  max output difference: " << maxDiff << std::endl;
+
+        return maxDiff <= 1.0e-12;
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[1] optionally the number of steps
+ * @return 0 if both integrators agree, 1 otherwise
+ */
+int main(int argc, char** argv)
+{
+    const int numSteps = argc > 1 ? std::atoi(argv[1]) : 5000;
+    // The control time AppMultiTerrain gives SpineFeedbackControl
+    const double dt = 0.01;
+
+    bool agree = benchmark(8, numSteps, dt);
+    agree = benchmark(32, numSteps, dt) && agree;
+
+    return agree ? 0 : 1;
+}
@@ -36,6 +36,7 @@
 
 // The C++ Standard Library
 #include <assert.h>
+#include <iostream>
 #include <stdexcept>
 #include <iterator> 
 
@@ -44,10 +45,12 @@ using namespace boost::numeric::odeint;
 typedef std::vector<double > cpgVars_type;
 
 CPGEquationsFB::CPGEquationsFB(int maxSteps) :
-CPGEquations(maxSteps)
+CPGEquations(maxSteps),
+m_networkRevision(0)
  {}
 CPGEquationsFB::CPGEquationsFB(std::vector<CPGNode*>& newNodeList, int maxSteps) :
-CPGEquations(newNodeList, maxSteps)
+CPGEquations(newNodeList, maxSteps),
+m_networkRevision(0)
 {
 }
 
@@ -61,6 +64,8 @@ int CPGEquationsFB::addNode(std::vector<double>& newParams)
 	int index = nodeList.size();
 	CPGNodeFB* newNode = new CPGNodeFB(index, newParams);
 	nodeList.push_back(newNode);
+	m_nodeParams.push_back(newParams);
+	m_revision++;
 	
 	return index;
 }
@@ -128,3 +133,71 @@ void CPGEquationsFB::updateNodeData(std::vector<double> newXVals)
 		currentNode->updateNodeValues(newXVals[3*i], newXVals[3*i+1], newXVals[3*i+2]);
 	}
 }
+
+void CPGEquationsFB::syncNetwork()
+{
+	// No addNode or defineConnections since the last build
+	if (m_revision == m_networkRevision)
+	{
+		return;
+	}
+	
+	m_network.clear();
+	for (std::size_t i = 0; i != m_nodeParams.size(); i++)
+	{
+		m_network.addNode(m_nodeParams[i]);
+	}
+	
+	// Every node was made by addNode, so its index is its position
+	for (std::size_t i = 0; i != nodeList.size(); i++)
+	{
+		CPGNodeFB* currentNode = static_cast<CPGNodeFB*>(nodeList[i]);
+		std::vector<int> connections;
+		for (std::size_t j = 0; j != currentNode->couplingList.size(); j++)
+		{
+			connections.push_back(currentNode->couplingList[j]->getNodeIndex());
+		}
+		m_network.defineConnections(i, connections,
+									currentNode->weightList,
+									currentNode->phaseList);
+	}
+	
+	m_networkRevision = m_revision;
+}
+
+void CPGEquationsFB::update(std::vector<double>& descCom, double dt)
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("CPGEquationsFB::update");
+#endif //BT_NO_PROFILE
+	if (m_nodeParams.size() != nodeList.size())
+	{
+		// Nodes came from the constructor, no parameters to build from
+		CPGEquations::update(descCom, dt);
+		return;
+	}
+	
+	syncNetwork();
+	
+	for (std::size_t i = 0; i != nodeList.size(); i++)
+	{
+		const CPGNodeFB* currentNode = static_cast<CPGNodeFB*>(nodeList[i]);
+		m_network.setState(i, currentNode->phiValue, currentNode->rValue,
+							currentNode->omega);
+	}
+	
+	numSteps = m_network.update(descCom, dt);
+	
+	for (std::size_t i = 0; i != nodeList.size(); i++)
+	{
+		CPGNodeFB* currentNode = static_cast<CPGNodeFB*>(nodeList[i]);
+		currentNode->updateNodeValues(m_network.getPhi(i), m_network.getR(i),
+									  m_network.getOmega(i));
+	}
+	
+	if (numSteps > m_maxSteps)
+	{
+		std::cout << "Ending trial due to inefficient equations " << numSteps << std::endl;
+		throw std::runtime_error("Inefficient CPG Parameters");
+	}
+}
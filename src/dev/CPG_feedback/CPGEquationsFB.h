@@ -30,6 +30,7 @@
 #include "util/CPGEquations.h"
 
 #include "CPGNodeFB.h"
+#include "CPGNetworkFB.h"
 
 
 #include <vector>
@@ -60,6 +61,32 @@ class CPGEquationsFB : public CPGEquations
 	void updateNodes(std::vector<double>& descCom);
 	
 	void updateNodeData(std::vector<double> newXVals);
+	
+	/**
+	 * Integrates with a CPGNetworkFB built from the nodes, rather than
+	 * going through the nodes for every derivative evaluation. The
+	 * results are the same as CPGEquations::update, which is still
+	 * used for nodes that were not created by addNode.
+	 */
+	void update(std::vector<double>& descCom, double dt);
+	
+	const CPGNetworkFB& getNetwork() const
+	{
+		return m_network;
+	}
+
+private:
+	
+	/** Rebuild m_network if the nodes changed since it was built */
+	void syncNetwork();
+	
+	/** Parameters passed to addNode, by node index */
+	std::vector<std::vector<double> > m_nodeParams;
+	
+	CPGNetworkFB m_network;
+	
+	/** getRevision() when m_network was built */
+	std::size_t m_networkRevision;
 
 };
 
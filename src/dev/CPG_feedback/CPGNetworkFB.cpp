@@ -0,0 +1,279 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CPGNetworkFB.cpp
+ * @brief Implementation of class CPGNetworkFB
+ * @author agent
+ * $Id$
+ */
+
+#include "CPGNetworkFB.h"
+
+#include "boost/numeric/odeint.hpp"
+
+// The Bullet Physics Library
+#include "LinearMath/btQuickprof.h"
+
+// The C++ Standard Library
+#include <assert.h>
+#include <math.h>
+#include <stdexcept>
+
+using namespace boost::numeric::odeint;
+
+typedef std::vector<double > cpgVars_type;
+
+namespace
+{
+    /**
+     * Function object for interfacing with ODE Int
+     */
+    class network_function
+    {
+    public:
+
+        network_function(const CPGNetworkFB& network, int& numSteps) :
+        m_network(network),
+        m_numSteps(numSteps)
+        {
+        }
+
+        void operator() (const cpgVars_type& x,
+                         cpgVars_type& dxdt,
+                         double t)
+        {
+            m_network.derivatives(x, dxdt);
+            m_numSteps++;
+        }
+
+    private:
+        const CPGNetworkFB& m_network;
+        int& m_numSteps;
+    };
+
+    /**
+     * Keeps the latest integrated state, as the output function of
+     * CPGEquations does
+     */
+    class network_output
+    {
+    public:
+
+        network_output(cpgVars_type& state) :
+        m_state(state)
+        {
+        }
+
+        void operator() (const cpgVars_type& x, const double t)
+        {
+            m_state = x;
+        }
+
+    private:
+        cpgVars_type& m_state;
+    };
+}
+
+CPGNetworkFB::CPGNetworkFB() :
+m_compiled(true)
+{
+    m_edgeStart.push_back(0);
+}
+
+int CPGNetworkFB::addNode(const std::vector<double>& params)
+{
+    if (params.size() < 11)
+    {
+        throw std::invalid_argument("Feedback CPG nodes need 11 parameters");
+    }
+
+    const int index = m_rConst.size();
+
+    m_rConst.push_back(params[4]);
+    m_radiusOffset.push_back(params[2]);
+    m_kFreq.push_back(params[8]);
+    m_kAmp.push_back(params[9]);
+    m_kPhase.push_back(params[10]);
+
+    // Same initial conditions as CPGNodeFB
+    m_state.push_back(0.0);
+    m_state.push_back(sqrt(params[2]));
+    m_state.push_back(params[7]);
+    m_output.push_back(0.0);
+
+    m_compiled = false;
+
+    return index;
+}
+
+void CPGNetworkFB::defineConnections(int nodeIndex,
+                                     const std::vector<int>& connections,
+                                     const std::vector<double>& weights,
+                                     const std::vector<double>& phaseOffsets)
+{
+    if (connections.size() != weights.size() ||
+        connections.size() != phaseOffsets.size())
+    {
+        throw std::invalid_argument("Connections, weights and phases must be the same size");
+    }
+    if (nodeIndex < 0 || nodeIndex >= static_cast<int>(size()))
+    {
+        throw std::invalid_argument("Node index out of bounds");
+    }
+
+    for (std::size_t i = 0; i < connections.size(); i++)
+    {
+        if (connections[i] < 0 || connections[i] >= static_cast<int>(size()))
+        {
+            throw std::invalid_argument("Connection index out of bounds");
+        }
+        Coupling c;
+        c.node = nodeIndex;
+        c.target = connections[i];
+        c.weight = weights[i];
+        c.phase = phaseOffsets[i];
+        m_couplings.push_back(c);
+    }
+
+    m_compiled = false;
+}
+
+void CPGNetworkFB::clear()
+{
+    m_rConst.clear();
+    m_radiusOffset.clear();
+    m_kFreq.clear();
+    m_kAmp.clear();
+    m_kPhase.clear();
+    m_state.clear();
+    m_output.clear();
+    m_couplings.clear();
+    m_compiled = false;
+}
+
+void CPGNetworkFB::setState(std::size_t i, double phi, double r, double omega)
+{
+    assert(i < size());
+    m_state[3 * i] = phi;
+    m_state[3 * i + 1] = r;
+    m_state[3 * i + 2] = omega;
+    m_output[i] = r * cos(phi);
+}
+
+void CPGNetworkFB::compile()
+{
+    const std::size_t n = size();
+    const std::size_t nEdges = m_couplings.size();
+
+    // Counting sort by node, stable so each node sums its couplings in
+    // the order CPGNodeFB would
+    m_edgeStart.assign(n + 1, 0);
+    for (std::size_t i = 0; i < nEdges; i++)
+    {
+        m_edgeStart[m_couplings[i].node + 1]++;
+    }
+    for (std::size_t i = 0; i < n; i++)
+    {
+        m_edgeStart[i + 1] += m_edgeStart[i];
+    }
+
+    m_edgeTarget.resize(nEdges);
+    m_edgeWeight.resize(nEdges);
+    m_edgePhase.resize(nEdges);
+
+    std::vector<std::size_t> next(m_edgeStart.begin(), m_edgeStart.end() - 1);
+    for (std::size_t i = 0; i < nEdges; i++)
+    {
+        const Coupling& c = m_couplings[i];
+        const std::size_t e = next[c.node]++;
+        m_edgeTarget[e] = c.target;
+        m_edgeWeight[e] = c.weight;
+        m_edgePhase[e] = c.phase;
+    }
+
+    m_compiled = true;
+}
+
+void CPGNetworkFB::derivatives(const std::vector<double>& x,
+                               std::vector<double>& dxdt) const
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("CPGNetworkFB::derivatives");
+#endif //BT_NO_PROFILE
+    assert(m_compiled);
+    assert(x.size() == 3 * size());
+    assert(m_feedback.size() == x.size());
+
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        const double phi = x[3 * i];
+        const double r = x[3 * i + 1];
+        const double omega = x[3 * i + 2];
+
+        double phiDot = omega + m_kPhase[i] * m_feedback[3 * i + 2];
+
+        const std::size_t end = m_edgeStart[i + 1];
+        for (std::size_t e = m_edgeStart[i]; e != end; e++)
+        {
+            const std::size_t j = m_edgeTarget[e];
+            phiDot += m_edgeWeight[e] * x[3 * j + 1] *
+                      sin(x[3 * j] - phi - m_edgePhase[e]);
+        }
+
+        dxdt[3 * i] = phiDot;
+        dxdt[3 * i + 1] = m_rConst[i] *
+                          (m_radiusOffset[i] + m_kAmp[i] * m_feedback[3 * i + 1] - r * r) * r;
+        dxdt[3 * i + 2] = m_kFreq[i] * m_feedback[3 * i] * sin(phi);
+    }
+}
+
+int CPGNetworkFB::update(const std::vector<double>& feedback, double dt)
+{
+#ifndef BT_NO_PROFILE
+    BT_PROFILE("CPGNetworkFB::update");
+#endif //BT_NO_PROFILE
+    if (feedback.size() != m_state.size())
+    {
+        throw std::invalid_argument("Need three feedback values per node");
+    }
+
+    if (!m_compiled)
+    {
+        compile();
+    }
+
+    m_feedback = feedback;
+
+    // Same step size rule as CPGEquations::update
+    const double stepSize = dt <= 0.1 ? dt : 0.1;
+
+    int numSteps = 0;
+    m_work = m_state;
+    integrate(network_function(*this, numSteps), m_work, 0.0, dt, stepSize,
+              network_output(m_state));
+
+    const std::size_t n = size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        m_output[i] = m_state[3 * i + 1] * cos(m_state[3 * i]);
+    }
+
+    return numSteps;
+}
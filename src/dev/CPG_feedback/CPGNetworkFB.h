@@ -0,0 +1,168 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CPG_FEEDBACK_CPG_NETWORK_FB
+#define CPG_FEEDBACK_CPG_NETWORK_FB
+
+/**
+ * @file CPGNetworkFB.h
+ * @brief Definition of class CPGNetworkFB
+ * @author agent
+ * $Id$
+ */
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * The feedback CPG equations of CPGNodeFB, with no node objects. Node
+ * parameters and state live in flat arrays and the couplings are
+ * compiled into one list sorted by node, so evaluating the derivatives
+ * for ODEInt is a single loop with no virtual calls or casts.
+ *
+ * Integrates with the same ODEInt call as CPGEquations::update, so for
+ * the same parameters, couplings and feedback the results match
+ * CPGEquationsFB.
+ */
+class CPGNetworkFB
+{
+public:
+
+    CPGNetworkFB();
+
+    /**
+     * Add a node. Uses the same parameters as CPGNodeFB:
+     * params[2] radius offset, params[4] rConst, params[7] initial
+     * omega and params[8] to [10] the frequency, amplitude and phase
+     * feedback gains.
+     * @return the index of the new node
+     */
+    int addNode(const std::vector<double>& params);
+
+    /**
+     * Couple nodeIndex to each node in connections, in the same way as
+     * CPGEquations::defineConnections. Couplings are summed in the
+     * order they were added.
+     */
+    void defineConnections(int nodeIndex,
+                           const std::vector<int>& connections,
+                           const std::vector<double>& weights,
+                           const std::vector<double>& phaseOffsets);
+
+    /** Remove all nodes and couplings */
+    void clear();
+
+    /**
+     * Integrate over dt with the feedback held constant
+     * @param[in] feedback three values per node, frequency, amplitude
+     * and phase feedback, in the same layout as CPGEquationsFB::update
+     * @param[in] dt the length of the update
+     * @return the number of derivative evaluations, which
+     * CPGEquations::update compares to its maximum number of steps
+     */
+    int update(const std::vector<double>& feedback, double dt);
+
+    /** The output of node i, r * cos(phi) */
+    double operator[](std::size_t i) const
+    {
+        return m_output[i];
+    }
+
+    std::size_t size() const
+    {
+        return m_rConst.size();
+    }
+
+    double getPhi(std::size_t i) const
+    {
+        return m_state[3 * i];
+    }
+
+    double getR(std::size_t i) const
+    {
+        return m_state[3 * i + 1];
+    }
+
+    double getOmega(std::size_t i) const
+    {
+        return m_state[3 * i + 2];
+    }
+
+    /** Overwrite the integrated state of node i */
+    void setState(std::size_t i, double phi, double r, double omega);
+
+    /**
+     * Evaluate the derivatives, the right hand side given to ODEInt
+     * @param[in] x phi, r and omega for each node
+     * @param[out] dxdt must be the same size as x
+     */
+    void derivatives(const std::vector<double>& x,
+                     std::vector<double>& dxdt) const;
+
+private:
+
+    /** Sort m_couplings by node into the m_edge arrays */
+    void compile();
+
+    /**
+     * Node parameters, indexed by node
+     */
+    std::vector<double> m_rConst;
+    std::vector<double> m_radiusOffset;
+    std::vector<double> m_kFreq;
+    std::vector<double> m_kAmp;
+    std::vector<double> m_kPhase;
+
+    /** phi, r and omega for each node, the ODEInt state */
+    std::vector<double> m_state;
+
+    /** r * cos(phi) for each node after the last update */
+    std::vector<double> m_output;
+
+    /** Held for the derivative evaluations of one update */
+    std::vector<double> m_feedback;
+
+    /** Scratch state handed to ODEInt */
+    std::vector<double> m_work;
+
+    /** One coupling as added by defineConnections */
+    struct Coupling
+    {
+        int node;
+        int target;
+        double weight;
+        double phase;
+    };
+
+    /** Couplings in the order they were added */
+    std::vector<Coupling> m_couplings;
+
+    /** False when couplings were added since the last compile */
+    bool m_compiled;
+
+    /**
+     * Compiled couplings, the couplings of node i are
+     * m_edgeStart[i] to m_edgeStart[i + 1]
+     */
+    std::vector<std::size_t> m_edgeStart;
+    std::vector<std::size_t> m_edgeTarget;
+    std::vector<double> m_edgeWeight;
+    std::vector<double> m_edgePhase;
+};
+
+#endif // CPG_FEEDBACK_CPG_NETWORK_FB
@@ -124,14 +124,11 @@ void SpineFeedbackControl::onSetup(BaseSpineModelLearning& subject)
 	m_pCPGSys = new CPGEquationsFB(100);
     //Initialize the Learning Adapters
     nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
+                            nodeLearning);
     edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
+                            edgeLearning);
     feedbackAdapter.initialize(&feedbackEvolution,
-                                feedbackLearning,
-                                feedbackConfigData);
+                                feedbackLearning);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
@@ -360,7 +357,10 @@ std::vector<double> SpineFeedbackControl::getFeedback(BaseSpineModelLearning& su
     for(std::size_t i = 0; i != n; i++)
     {
         const tgSpringCableActuator& cable = *(allCables[i]);
-        std::vector<double > state = getCableState(cable);
+        double length;
+        double tension;
+        subject.getMuscleState(i, length, tension);
+        std::vector<double > state = getCableState(cable, length, tension);
         std::vector< std::vector<double> > actions = feedbackAdapter.step(m_updateTime, state);
         std::vector<double> cableFeedback = transformFeedbackActions(actions);
         
@@ -380,7 +380,9 @@ std::vector<double> SpineFeedbackControl::getFeedback(BaseSpineModelLearning& su
     return feedback;
 }
 
-std::vector<double> SpineFeedbackControl::getCableState(const tgSpringCableActuator& cable)
+std::vector<double> SpineFeedbackControl::getCableState(const tgSpringCableActuator& cable,
+                                                        double length,
+                                                        double tension)
 {
 	// For each string, scale value from -1 to 1 based on initial length or max tension of motor
     
@@ -388,10 +390,10 @@ std::vector<double> SpineFeedbackControl::getCableState(const tgSpringCableActua
     
     // Scale length by starting length
     const double startLength = cable.getStartLength();
-    state.push_back((cable.getCurrentLength() - startLength) / startLength);
+    state.push_back((length - startLength) / startLength);
     
     const double maxTension = cable.getConfig().maxTens;
-    state.push_back((cable.getTension() - maxTension / 2.0) / maxTension);
+    state.push_back((tension - maxTension / 2.0) / maxTension);
     
 	return state;
 }
@@ -108,7 +108,13 @@ protected:
     
     std::vector<double> getFeedback(BaseSpineModelLearning& subject);
     
-    std::vector<double> getCableState(const tgSpringCableActuator& cable);
+    /**
+     * Scale the length and tension of cable, as read from the model's
+     * observations, to -1 to 1
+     */
+    std::vector<double> getCableState(const tgSpringCableActuator& cable,
+                                      double length,
+                                      double tension);
     
     std::vector<double> transformFeedbackActions(std::vector< std::vector<double> >& actions);
     
@@ -26,6 +26,7 @@
 
 // This application
 #include "CordeModel.h"
+#include "CordeBatch.h"
 // This library
 #include "core/tgModel.h"
 #include "core/tgSimViewGraphics.h"
@@ -36,7 +37,10 @@
 #include "LinearMath/btVector3.h"
 #include "LinearMath/btQuaternion.h"
 // The C++ Standard Library
+#include <algorithm>
+#include <ctime>
 #include <iostream>
+#include <vector>
 
 /**
  * The entry point.
@@ -77,6 +81,18 @@ int main(int argc, char** argv)
 	
 	CordeModel testString(startPos, endPos, startRot, endRot, config);
 	
+	// The same string several times over, all registered with one
+	// world level batch that is stepped once per step
+	const std::size_t numCopies = 8;
+	CordeBatch batch;
+	std::vector<CordeModel*> copies;
+	for (std::size_t i = 0; i < numCopies; i++)
+	{
+		const btVector3 offset(0.0, 1.0 * i, 0.0);
+		copies.push_back(new CordeModel(startPos + offset, endPos + offset,
+										startRot, endRot, config, batch));
+	}
+	
 	double t = 0.0;
 	double dt = 0.0001;
 	for (int i = 0; i < 10000; i++)
@@ -84,6 +100,32 @@ int main(int argc, char** argv)
 		testString.step(dt);
 		t += dt;
 	}
+	
+	const std::clock_t batchStart = std::clock();
+	for (int i = 0; i < 10000; i++)
+	{
+		batch.step(dt);
+	}
+	const double batchSeconds = (double) (std::clock() - batchStart) / CLOCKS_PER_SEC;
+	
+	// Every copy should match the single string exactly
+	double maxError = 0.0;
+	const CordeBatch& single = testString.getBatch();
+	const std::size_t singleIndex = testString.getStringIndex();
+	for (std::size_t s = 0; s < numCopies; s++)
+	{
+		const btVector3 offset(0.0, 1.0 * s, 0.0);
+		const std::size_t index = copies[s]->getStringIndex();
+		for (std::size_t j = 0; j < single.getNumPoints(singleIndex); j++)
+		{
+			const btVector3 diff = copies[s]->getBatch().getPosition(index, j) - offset
+									- single.getPosition(singleIndex, j);
+			maxError = std::max(maxError, (double) diff.length());
+		}
+		delete copies[s];
+	}
+	std::cout << numCopies << " batched strings took " << batchSeconds
+			  << " s, max position error " << maxError << std::endl;
 	#ifdef BT_USE_DOUBLE_PRECISION
 		std::cout << "Double precision" << std::endl;
 	#else
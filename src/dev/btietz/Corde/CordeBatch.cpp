@@ -0,0 +1,590 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file CordeBatch.cpp
+ * @brief Structure of arrays storage and force kernels for one or more
+ * Corde strings
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "CordeBatch.h"
+
+// The C++ Standard Library
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+CordeBatch::CordeBatch()
+{
+}
+
+std::size_t CordeBatch::addString(const btVector3& pos1, const btVector3& pos2,
+                                  const btQuaternion& quat1, const btQuaternion& quat2,
+                                  const CordeModel::Config& config)
+{
+    if (config.resolution < 2)
+    {
+        throw std::invalid_argument("Corde string needs at least two mass points.");
+    }
+
+    if (!m_firstPoint.empty())
+    {
+        addGapLink();
+    }
+
+    const std::size_t first = m_posX.size();
+    const std::size_t n = config.resolution - 1;
+    m_firstPoint.push_back(first);
+
+    const btScalar pir2 = M_PI * config.radius * config.radius;
+    const btVector3 unitLength((pos2 - pos1) / (double) n);
+    const btScalar length = unitLength.length();
+    const btScalar unitMass = config.density * pir2 * length;
+
+    // Bending and torsion stiffnesses, times the common factor
+    const btScalar k1 = config.YoungMod * pir2 / 4.0;
+    const btScalar k2 = config.YoungMod * pir2 / 4.0;
+    const btScalar k3 = config.ShearMod * pir2 / 2.0;
+    const btScalar stiffnessCommon = 4.0 / length * (length - 1.0) * (length - 1.0);
+
+    const btScalar inertiaX = config.density * pir2 / 4.0;
+    const btScalar inertiaY = config.density * pir2 / 4.0;
+    const btScalar inertiaZ = config.density * pir2 / 2.0;
+
+    for (std::size_t i = 0; i <= n; i++)
+    {
+        const btVector3 massPos = pos1 + unitLength * (double) i;
+        m_posX.push_back(massPos.x());
+        m_posY.push_back(massPos.y());
+        m_posZ.push_back(massPos.z());
+        m_velX.push_back(0.0);
+        m_velY.push_back(0.0);
+        m_velZ.push_back(0.0);
+        m_forceX.push_back(0.0);
+        m_forceY.push_back(0.0);
+        m_forceZ.push_back(0.0);
+        m_inverseMass.push_back(1.0 / unitMass);
+    }
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        m_linkLength.push_back(length);
+        m_inverseLength5.push_back(1.0 / (length * length * length * length * length));
+        m_linkGap.push_back(0.0);
+        m_stretchStiffness.push_back(config.StretchMod * pir2);
+        m_gammaT.push_back(config.gammaT);
+        m_consSpring.push_back(config.ConsSpringConst);
+        // The ends of the string are free of the constraint forces
+        m_consWeight0.push_back(i == 0 ? 0.0 : 1.0);
+        m_consWeight1.push_back((i == 0 || i != n - 1) ? 1.0 : 0.0);
+
+        btQuaternion q = (i == 0) ? quat1 : quat1.slerp(quat2, (double) i / (double) n);
+        q.normalize();
+        m_q0.push_back(q[0]);
+        m_q1.push_back(q[1]);
+        m_q2.push_back(q[2]);
+        m_q3.push_back(q[3]);
+
+        m_inertiaX.push_back(inertiaX);
+        m_inertiaY.push_back(inertiaY);
+        m_inertiaZ.push_back(inertiaZ);
+        m_inverseInertiaX.push_back(1.0 / inertiaX);
+        m_inverseInertiaY.push_back(1.0 / inertiaY);
+        m_inverseInertiaZ.push_back(1.0 / inertiaZ);
+
+        // The last centerline has no neighbour in this string
+        const bool hasPair = (i < n - 1);
+        m_bendStiffness1.push_back(hasPair ? stiffnessCommon * k1 : 0.0);
+        m_bendStiffness2.push_back(hasPair ? stiffnessCommon * k2 : 0.0);
+        m_bendStiffness3.push_back(hasPair ? stiffnessCommon * k3 : 0.0);
+        m_bendDamping.push_back(hasPair ? 4.0 * config.gammaR / length : 0.0);
+    }
+
+    const std::size_t links = m_linkLength.size();
+    m_linkForce0X.resize(links); m_linkForce0Y.resize(links); m_linkForce0Z.resize(links);
+    m_linkForce1X.resize(links); m_linkForce1Y.resize(links); m_linkForce1Z.resize(links);
+    m_qdot0.resize(links); m_qdot1.resize(links); m_qdot2.resize(links); m_qdot3.resize(links);
+    m_tprime0.resize(links); m_tprime1.resize(links); m_tprime2.resize(links); m_tprime3.resize(links);
+    m_torqueX.resize(links); m_torqueY.resize(links); m_torqueZ.resize(links);
+    m_omegaX.resize(links); m_omegaY.resize(links); m_omegaZ.resize(links);
+    for (std::size_t k = 0; k < 4; k++)
+    {
+        m_pairForce0[k].resize(links);
+        m_pairForce1[k].resize(links);
+    }
+
+    assert(invariant());
+
+    return m_firstPoint.size() - 1;
+}
+
+void CordeBatch::addGapLink()
+{
+    m_linkLength.push_back(1.0);
+    m_inverseLength5.push_back(0.0);
+    m_linkGap.push_back(1.0);
+    m_stretchStiffness.push_back(0.0);
+    m_gammaT.push_back(0.0);
+    m_consSpring.push_back(0.0);
+    m_consWeight0.push_back(0.0);
+    m_consWeight1.push_back(0.0);
+
+    // Identity, so the slot stays still and normalized
+    m_q0.push_back(0.0);
+    m_q1.push_back(0.0);
+    m_q2.push_back(0.0);
+    m_q3.push_back(1.0);
+
+    m_inertiaX.push_back(1.0);
+    m_inertiaY.push_back(1.0);
+    m_inertiaZ.push_back(1.0);
+    m_inverseInertiaX.push_back(0.0);
+    m_inverseInertiaY.push_back(0.0);
+    m_inverseInertiaZ.push_back(0.0);
+
+    m_bendStiffness1.push_back(0.0);
+    m_bendStiffness2.push_back(0.0);
+    m_bendStiffness3.push_back(0.0);
+    m_bendDamping.push_back(0.0);
+}
+
+void CordeBatch::step(btScalar dt)
+{
+    if (dt <= 0.0)
+    {
+        throw std::invalid_argument("Timestep is not positive.");
+    }
+    else if (m_posX.empty())
+    {
+        return;
+    }
+
+    stepPrerequisites();
+    computeLinkForces();
+    computeBendTwistForces();
+    unconstrainedMotion(dt);
+
+    assert(invariant());
+}
+
+void CordeBatch::stepPrerequisites()
+{
+    const std::size_t points = m_posX.size();
+    for (std::size_t i = 0; i < points; i++)
+    {
+        m_forceX[i] = 0.0;
+        m_forceY[i] = 0.0;
+        m_forceZ[i] = 0.0;
+    }
+
+    // Generalized forces are assigned by computeLinkForces
+    const std::size_t links = m_linkLength.size();
+    for (std::size_t i = 0; i < links; i++)
+    {
+        m_torqueX[i] = 0.0;
+        m_torqueY[i] = 0.0;
+        m_torqueZ[i] = 0.0;
+    }
+}
+
+void CordeBatch::computeLinkForces()
+{
+    const std::size_t links = m_linkLength.size();
+
+    const btScalar* const x = &m_posX[0];
+    const btScalar* const y = &m_posY[0];
+    const btScalar* const z = &m_posZ[0];
+    const btScalar* const vx = &m_velX[0];
+    const btScalar* const vy = &m_velY[0];
+    const btScalar* const vz = &m_velZ[0];
+
+    for (std::size_t i = 0; i < links; i++)
+    {
+        const btScalar q11 = m_q0[i];
+        const btScalar q12 = m_q1[i];
+        const btScalar q13 = m_q2[i];
+        const btScalar q14 = m_q3[i];
+
+        const btScalar dx = x[i] - x[i + 1];
+        const btScalar dy = y[i] - y[i + 1];
+        const btScalar dz = z[i] - z[i + 1];
+        const btScalar dvx = vx[i] - vx[i + 1];
+        const btScalar dvy = vy[i] - vy[i + 1];
+        const btScalar dvz = vz[i] - vz[i + 1];
+
+        // The gap keeps the norm away from zero between strings
+        const btScalar posNorm_2 = dx * dx + dy * dy + dz * dz + m_linkGap[i];
+        const btScalar posNorm = sqrt(posNorm_2);
+        const btScalar invNorm = 1.0 / posNorm;
+        const btScalar invNorm3 = invNorm * invNorm * invNorm;
+
+        const btScalar d0 = 2.0 * (q11 * q13 + q12 * q14);
+        const btScalar d1 = 2.0 * (q12 * q13 - q11 * q14);
+        const btScalar d2 = -1.0 * q11 * q11 - q12 * q12 + q13 * q13 + q14 * q14;
+
+        const btScalar length = m_linkLength[i];
+
+        const btScalar spring_common = m_stretchStiffness[i] *
+            (length - posNorm) * invNorm / length;
+
+        const btScalar diss_common = m_gammaT[i] * posNorm_2 *
+            (dx * dvx + dy * dvy + dz * dvz) * m_inverseLength5[i];
+
+        const btScalar common = spring_common + diss_common;
+
+        const btScalar cons_common = m_consSpring[i] * length * invNorm3;
+
+        const btScalar quat_cons_x = cons_common *
+            (d2 * dx * dz - d0 * (dy * dy + dz * dz) + d1 * dx * dy);
+
+        const btScalar quat_cons_y = cons_common *
+            (-1.0 * d2 * dy * dz + d1 * (dx * dx + dz * dz) - d0 * dx * dz);
+
+        const btScalar quat_cons_z = cons_common *
+            (-1.0 * d0 * dy * dz + d2 * (dx * dx + dy * dy) - d1 * dx * dz);
+
+        const btScalar w0 = m_consWeight0[i];
+        const btScalar w1 = m_consWeight1[i];
+
+        m_linkForce0X[i] = -1.0 * dx * common - w0 * quat_cons_x;
+        m_linkForce0Y[i] = -1.0 * dy * common - w0 * quat_cons_y;
+        m_linkForce0Z[i] = -1.0 * dz * common - w0 * quat_cons_z;
+
+        m_linkForce1X[i] = dx * common + w1 * quat_cons_x;
+        m_linkForce1Y[i] = dy * common + w1 * quat_cons_y;
+        m_linkForce1Z[i] = dz * common + w1 * quat_cons_z;
+
+        /* Torques resulting from quaternion alignment constraints.
+         * q.length2() should always be 1, but sometimes numerical
+         * precision renders it slightly greater. The simulation is much
+         * more stable if we just assume its one.
+         */
+        const btScalar tprime_common = 2.0 * m_consSpring[i] * length;
+
+        m_tprime0[i] = tprime_common *
+            (q11 + (q13 * dx - q14 * dy - q11 * dz) * invNorm);
+        m_tprime1[i] = tprime_common *
+            (q12 + (q14 * dx + q13 * dy - q12 * dz) * invNorm);
+        m_tprime2[i] = tprime_common *
+            (q13 + (q11 * dx + q12 * dy + q13 * dz) * invNorm);
+        m_tprime3[i] = tprime_common *
+            (q14 + (q12 * dx - q11 * dy + q14 * dz) * invNorm);
+    }
+
+    // Sum separately so the loop above has no dependencies between links
+    for (std::size_t i = 0; i < links; i++)
+    {
+        m_forceX[i + 1] += m_linkForce1X[i];
+        m_forceY[i + 1] += m_linkForce1Y[i];
+        m_forceZ[i + 1] += m_linkForce1Z[i];
+    }
+    for (std::size_t i = 0; i < links; i++)
+    {
+        m_forceX[i] += m_linkForce0X[i];
+        m_forceY[i] += m_linkForce0Y[i];
+        m_forceZ[i] += m_linkForce0Z[i];
+    }
+}
+
+void CordeBatch::computeBendTwistForces()
+{
+    const std::size_t links = m_linkLength.size();
+    if (links < 2)
+    {
+        return;
+    }
+    const std::size_t pairs = links - 1;
+
+    for (std::size_t i = 0; i < pairs; i++)
+    {
+        const btScalar q11 = m_q0[i];
+        const btScalar q12 = m_q1[i];
+        const btScalar q13 = m_q2[i];
+        const btScalar q14 = m_q3[i];
+
+        const btScalar q21 = m_q0[i + 1];
+        const btScalar q22 = m_q1[i + 1];
+        const btScalar q23 = m_q2[i + 1];
+        const btScalar q24 = m_q3[i + 1];
+
+        const btScalar qdot11 = m_qdot0[i];
+        const btScalar qdot12 = m_qdot1[i];
+        const btScalar qdot13 = m_qdot2[i];
+        const btScalar qdot14 = m_qdot3[i];
+
+        const btScalar qdot21 = m_qdot0[i + 1];
+        const btScalar qdot22 = m_qdot1[i + 1];
+        const btScalar qdot23 = m_qdot2[i + 1];
+        const btScalar qdot24 = m_qdot3[i + 1];
+
+        // Already include the common factor
+        const btScalar k1 = m_bendStiffness1[i];
+        const btScalar k2 = m_bendStiffness2[i];
+        const btScalar k3 = m_bendStiffness3[i];
+
+        /* Bending and torsional stiffness */
+        const btScalar q11_stiffness =
+        (k1 * q24 * (q11 * q24 + q12 * q23 - q13 * q22 - q14 * q21) +
+         k2 * q23 * (q11 * q23 - q12 * q24 - q13 * q21 + q14 * q22) +
+         k3 * q22 * (q11 * q22 - q12 * q21 + q13 * q24 - q14 * q23));
+
+        const btScalar q12_stiffness =
+        (k1 * q23 * (q12 * q23 + q11 * q24 - q13 * q22 - q14 * q21) +
+         k2 * q24 * (q12 * q24 - q11 * q23 + q13 * q21 - q14 * q22) +
+         k3 * q21 * (q12 * q21 - q11 * q22 - q13 * q24 + q14 * q23));
+
+        const btScalar q13_stiffness =
+        (k1 * q22 * (q13 * q22 - q11 * q24 - q12 * q23 + q14 * q21) +
+         k2 * q21 * (q13 * q21 - q11 * q23 + q12 * q24 - q14 * q22) +
+         k3 * q24 * (q13 * q24 + q11 * q22 - q12 * q21 - q14 * q23));
+
+        const btScalar q14_stiffness =
+        (k1 * q21 * (q14 * q21 - q11 * q24 - q12 * q23 + q13 * q22) +
+         k2 * q22 * (q14 * q22 + q11 * q23 - q12 * q24 - q13 * q21) +
+         k3 * q23 * (q14 * q23 - q11 * q22 + q12 * q21 - q13 * q24));
+
+        const btScalar q21_stiffness =
+        (k1 * q14 * (q14 * q21 - q11 * q24 - q12 * q23 + q13 * q22) +
+         k2 * q13 * (q13 * q21 - q11 * q23 + q12 * q24 - q14 * q22) +
+         k3 * q12 * (q12 * q21 - q11 * q22 + q14 * q23 - q13 * q24));
+
+        const btScalar q22_stiffness =
+        (k1 * q13 * (q13 * q22 - q11 * q24 - q12 * q23 + q14 * q21) +
+         k2 * q14 * (q14 * q22 + q11 * q23 - q12 * q24 - q13 * q21) +
+         k3 * q11 * (q11 * q22 - q12 * q21 + q13 * q24 - q14 * q23));
+
+        const btScalar q23_stiffness =
+        (k1 * q12 * (q12 * q23 + q11 * q24 - q13 * q22 - q14 * q21) +
+         k2 * q11 * (q11 * q23 - q13 * q21 - q12 * q24 + q14 * q22) +
+         k3 * q14 * (q14 * q23 - q11 * q22 + q12 * q21 - q13 * q24));
+
+        const btScalar q24_stiffness =
+        (k1 * q11 * (q11 * q24 + q12 * q23 - q13 * q22 - q14 * q21) +
+         k2 * q12 * (q12 * q24 - q11 * q23 + q13 * q21 - q14 * q22) +
+         k3 * q13 * (q13 * q24 + q11 * q22 - q12 * q21 - q14 * q23));
+
+        /* Torsional Damping */
+        const btScalar damping_common = m_bendDamping[i];
+
+        const btScalar q11_damping = damping_common *
+        (q12 * (q12 * qdot11 - q11 * qdot12 + q21 * qdot22 - q22 * qdot21 - q23 * qdot24 + q24 * qdot23) +
+         q13 * (q13 * qdot11 - q11 * qdot13 + q21 * qdot23 + q22 * qdot24 - q23 * qdot21 - q24 * qdot22) +
+         q14 * (q14 * qdot11 - q11 * qdot14 + q21 * qdot24 - q22 * qdot23 + q23 * qdot22 - q24 * qdot21));
+
+        const btScalar q12_damping = damping_common *
+        (q11 * (q11 * qdot12 - q12 * qdot11 - q21 * qdot22 + q22 * qdot21 + q23 * qdot24 - q24 * qdot23) +
+         q13 * (q13 * qdot12 - q13 * qdot13 - q21 * qdot24 + q22 * qdot23 - q23 * qdot22 + q24 * qdot21) +
+         q14 * (q14 * qdot12 - q14 * qdot14 + q21 * qdot23 + q22 * qdot24 - q23 * qdot21 - q24 * qdot22));
+
+        const btScalar q13_damping = damping_common *
+        (q11 * (q11 * qdot13 - q13 * qdot11 - q21 * qdot23 - q22 * qdot24 + q23 * qdot21 + q24 * qdot22) +
+         q12 * (q12 * qdot13 - q13 * qdot12 + q21 * qdot24 - q22 * qdot23 + q23 * qdot22 - q24 * qdot21) +
+         q14 * (q14 * qdot13 - q13 * qdot14 - q21 * qdot22 + q22 * qdot21 + q23 * qdot24 - q24 * qdot23));
+
+        const btScalar q14_damping = damping_common *
+        (q11 * (q11 * qdot14 - q14 * qdot11 - q21 * qdot24 + q22 * qdot23 - q23 * qdot22 + q24 * qdot21) +
+         q12 * (q12 * qdot14 - q14 * qdot12 - q21 * qdot23 - q22 * qdot24 + q23 * qdot21 + q24 * qdot22) +
+         q13 * (q13 * qdot14 - q14 * qdot13 + q21 * qdot22 - q22 * qdot21 - q23 * qdot24 + q24 * qdot23));
+
+        const btScalar q21_damping = damping_common *
+        (q22 * (q22 * qdot21 + q11 * qdot12 - q12 * qdot11 - q13 * qdot14 + q14 * qdot13 - q21 * qdot22) +
+         q23 * (q23 * qdot21 + q11 * qdot13 + q12 * qdot14 - q13 * qdot11 - q14 * qdot12 - q21 * qdot23) +
+         q24 * (q24 * qdot21 + q11 * qdot14 - q12 * qdot13 + q13 * qdot12 - q14 * qdot11 - q21 * qdot24));
+
+        const btScalar q22_damping = damping_common *
+        (q21 * (q21 * qdot22 - q11 * qdot12 + q12 * qdot11 + q13 * qdot14 - q14 * qdot13 - q22 * qdot21) +
+         q23 * (q23 * qdot22 - q11 * qdot14 + q12 * qdot13 - q13 * qdot12 + q14 * qdot11 - q22 * qdot23) +
+         q24 * (q24 * qdot22 + q11 * qdot13 + q12 * qdot14 - q13 * qdot11 - q14 * qdot12 - q22 * qdot24));
+
+        const btScalar q23_damping = damping_common *
+        (q21 * (q21 * qdot23 - q11 * qdot13 + q13 * qdot11 - q12 * qdot14 + q14 * qdot12 - q23 * qdot21) +
+         q22 * (q22 * qdot23 + q11 * qdot14 - q12 * qdot13 + q13 * qdot12 - q14 * qdot11 - q22 * qdot22) +
+         q24 * (q24 * qdot23 - q11 * qdot12 + q12 * qdot11 + q13 * qdot14 - q14 * qdot13 - q23 * qdot24));
+
+        const btScalar q24_damping = damping_common *
+        (q21 * (q21 * qdot24 - q11 * qdot14 + q12 * qdot13 - q13 * qdot12 + q14 * qdot11 - q24 * qdot21) +
+         q22 * (q21 * qdot24 - q11 * qdot13 - q12 * qdot14 + q13 * qdot11 + q14 * qdot12 - q24 * qdot22) +
+         q23 * (q23 * qdot24 + q11 * qdot12 - q12 * qdot11 - q13 * qdot14 + q14 * qdot13 - q24 * qdot23));
+
+        m_pairForce0[0][i] = q11_stiffness + q11_damping;
+        m_pairForce0[1][i] = q12_stiffness + q12_damping;
+        m_pairForce0[2][i] = q13_stiffness + q13_damping;
+        m_pairForce0[3][i] = q14_stiffness + q14_damping;
+
+        m_pairForce1[0][i] = q21_stiffness + q21_damping;
+        m_pairForce1[1][i] = q22_stiffness + q22_damping;
+        m_pairForce1[2][i] = q23_stiffness + q23_damping;
+        m_pairForce1[3][i] = q24_stiffness + q24_damping;
+    }
+
+    /// @todo double check the sign convention. Looks good numerically.
+    for (std::size_t i = 0; i < pairs; i++)
+    {
+        m_tprime0[i + 1] += m_pairForce1[0][i];
+        m_tprime1[i + 1] += m_pairForce1[1][i];
+        m_tprime2[i + 1] += m_pairForce1[2][i];
+        m_tprime3[i + 1] += m_pairForce1[3][i];
+    }
+    for (std::size_t i = 0; i < pairs; i++)
+    {
+        m_tprime0[i] += m_pairForce0[0][i];
+        m_tprime1[i] += m_pairForce0[1][i];
+        m_tprime2[i] += m_pairForce0[2][i];
+        m_tprime3[i] += m_pairForce0[3][i];
+    }
+}
+
+void CordeBatch::unconstrainedMotion(btScalar dt)
+{
+    const std::size_t points = m_posX.size();
+    for (std::size_t i = 0; i < points; i++)
+    {
+        // Velocity update - semi-implicit Euler
+        const btScalar scale = dt * m_inverseMass[i];
+        m_velX[i] += scale * m_forceX[i];
+        m_velY[i] += scale * m_forceY[i];
+        m_velZ[i] += scale * m_forceZ[i];
+        // Position update, uses v(t + dt)
+        m_posX[i] += dt * m_velX[i];
+        m_posY[i] += dt * m_velY[i];
+        m_posZ[i] += dt * m_velZ[i];
+    }
+
+    const std::size_t links = m_linkLength.size();
+    for (std::size_t i = 0; i < links; i++)
+    {
+        const btScalar q0 = m_q0[i];
+        const btScalar q1 = m_q1[i];
+        const btScalar q2 = m_q2[i];
+        const btScalar q3 = m_q3[i];
+
+        /* Transpose quaternion torques into Euclidean torques */
+        const btScalar tx = m_torqueX[i] + 0.5 *
+            (q0 * m_tprime2[i] - q2 * m_tprime0[i] - q1 * m_tprime3[i] + q3 * m_tprime1[i]);
+        const btScalar ty = m_torqueY[i] + 0.5 *
+            (q1 * m_tprime0[i] - q0 * m_tprime1[i] - q2 * m_tprime3[i] + q3 * m_tprime2[i]);
+        const btScalar tz = m_torqueZ[i] + 0.5 *
+            (q0 * m_tprime0[i] + q1 * m_tprime1[i] + q2 * m_tprime2[i] + q3 * m_tprime3[i]);
+        m_torqueX[i] = tx;
+        m_torqueY[i] = ty;
+        m_torqueZ[i] = tz;
+
+        // Since I is diagonal, omega x (I * omega) is cheap
+        const btScalar wx = m_omegaX[i];
+        const btScalar wy = m_omegaY[i];
+        const btScalar wz = m_omegaZ[i];
+        const btScalar iwx = m_inertiaX[i] * wx;
+        const btScalar iwy = m_inertiaY[i] * wy;
+        const btScalar iwz = m_inertiaZ[i] * wz;
+
+        const btScalar ox = wx + m_inverseInertiaX[i] * (tx - (wy * iwz - wz * iwy)) * dt;
+        const btScalar oy = wy + m_inverseInertiaY[i] * (ty - (wz * iwx - wx * iwz)) * dt;
+        const btScalar oz = wz + m_inverseInertiaZ[i] * (tz - (wx * iwy - wy * iwx)) * dt;
+        m_omegaX[i] = ox;
+        m_omegaY[i] = oy;
+        m_omegaZ[i] = oz;
+
+        const btScalar qd0 = 0.5 * (q0 * oz + q1 * oy - q2 * ox);
+        const btScalar qd1 = 0.5 * (q1 * oz - q0 * oy + q3 * ox);
+        const btScalar qd2 = 0.5 * (q0 * ox + q2 * oz + q3 * oy);
+        const btScalar qd3 = 0.5 * (q3 * oz - q2 * oy - q1 * ox);
+        m_qdot0[i] = qd0;
+        m_qdot1[i] = qd1;
+        m_qdot2[i] = qd2;
+        m_qdot3[i] = qd3;
+
+        const btScalar n0 = q0 + qd0 * dt;
+        const btScalar n1 = q1 + qd1 * dt;
+        const btScalar n2 = q2 + qd2 * dt;
+        const btScalar n3 = q3 + qd3 * dt;
+        const btScalar invLength = 1.0 / sqrt(n0 * n0 + n1 * n1 + n2 * n2 + n3 * n3);
+        m_q0[i] = n0 * invLength;
+        m_q1[i] = n1 * invLength;
+        m_q2[i] = n2 * invLength;
+        m_q3[i] = n3 * invLength;
+    }
+}
+
+std::size_t CordeBatch::getNumPoints(std::size_t s) const
+{
+    assert(s < m_firstPoint.size());
+    const std::size_t end = (s + 1 < m_firstPoint.size()) ?
+                                m_firstPoint[s + 1] : m_posX.size();
+    return end - m_firstPoint[s];
+}
+
+btVector3 CordeBatch::getPosition(std::size_t s, std::size_t point) const
+{
+    assert(point < getNumPoints(s));
+    const std::size_t i = m_firstPoint[s] + point;
+    return btVector3(m_posX[i], m_posY[i], m_posZ[i]);
+}
+
+btVector3 CordeBatch::getForce(std::size_t s, std::size_t point) const
+{
+    assert(point < getNumPoints(s));
+    const std::size_t i = m_firstPoint[s] + point;
+    return btVector3(m_forceX[i], m_forceY[i], m_forceZ[i]);
+}
+
+btQuaternion CordeBatch::getOrientation(std::size_t s, std::size_t segment) const
+{
+    assert(segment + 1 < getNumPoints(s));
+    const std::size_t i = m_firstPoint[s] + segment;
+    return btQuaternion(m_q0[i], m_q1[i], m_q2[i], m_q3[i]);
+}
+
+btQuaternion CordeBatch::getQDot(std::size_t s, std::size_t segment) const
+{
+    assert(segment + 1 < getNumPoints(s));
+    const std::size_t i = m_firstPoint[s] + segment;
+    return btQuaternion(m_qdot0[i], m_qdot1[i], m_qdot2[i], m_qdot3[i]);
+}
+
+btQuaternion CordeBatch::getTPrime(std::size_t s, std::size_t segment) const
+{
+    assert(segment + 1 < getNumPoints(s));
+    const std::size_t i = m_firstPoint[s] + segment;
+    return btQuaternion(m_tprime0[i], m_tprime1[i], m_tprime2[i], m_tprime3[i]);
+}
+
+btVector3 CordeBatch::getTorque(std::size_t s, std::size_t segment) const
+{
+    assert(segment + 1 < getNumPoints(s));
+    const std::size_t i = m_firstPoint[s] + segment;
+    return btVector3(m_torqueX[i], m_torqueY[i], m_torqueZ[i]);
+}
+
+/// Checks lengths of vectors. @todo add additional invariants
+bool CordeBatch::invariant() const
+{
+    const std::size_t points = m_posX.size();
+    const std::size_t links = m_linkLength.size();
+    return (points == links + 1 || (points == 0 && links == 0))
+        && (m_forceZ.size() == points)
+        && (m_inverseMass.size() == points)
+        && (m_consWeight1.size() == links)
+        && (m_q3.size() == links)
+        && (m_omegaZ.size() == links)
+        && (m_inverseInertiaZ.size() == links)
+        && (m_bendDamping.size() == links)
+        && (m_pairForce1[3].size() == links);
+}
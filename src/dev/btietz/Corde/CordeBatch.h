@@ -0,0 +1,156 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CORDE_BATCH
+#define CORDE_BATCH
+
+/**
+ * @file CordeBatch.h
+ * @brief Structure of arrays storage and force kernels for one or more
+ * Corde strings
+ * @author agent
+ * $Id$
+ */
+
+// This application
+#include "CordeModel.h"
+
+// Bullet Linear Algebra
+#include "LinearMath/btScalar.h"
+#include "LinearMath/btVector3.h"
+#include "LinearMath/btQuaternion.h"
+
+// The C++ Standard Library
+#include <vector>
+
+/**
+ * Holds the state of any number of Corde strings in flat arrays, one
+ * array per component, so that every string is stepped in a single
+ * pass of each kernel. The kernel loops have no branches and no
+ * dependencies between iterations, so the compiler can vectorize them.
+ *
+ * Strings are stored back to back. Mass link j joins points j and
+ * j + 1 and uses centerline j. The link between the last point of one
+ * string and the first point of the next is a gap link: all of its
+ * coefficients are zero, so it contributes nothing and the strings
+ * don't interact.
+ */
+class CordeBatch
+{
+public:
+    CordeBatch();
+
+    /**
+     * Adds a string with uniformly distributed mass points and rotation.
+     * See the CordeModel constructor for the meaning of the arguments.
+     * @return the index of the string within this batch
+     */
+    std::size_t addString(const btVector3& pos1, const btVector3& pos2,
+                          const btQuaternion& quat1, const btQuaternion& quat2,
+                          const CordeModel::Config& config);
+
+    /** Advance every string by dt */
+    void step(btScalar dt);
+
+    std::size_t getNumStrings() const
+    {
+        return m_firstPoint.size();
+    }
+
+    /** Mass points in string s. It has one less centerline */
+    std::size_t getNumPoints(std::size_t s) const;
+
+    btVector3 getPosition(std::size_t s, std::size_t point) const;
+
+    btVector3 getForce(std::size_t s, std::size_t point) const;
+
+    btQuaternion getOrientation(std::size_t s, std::size_t segment) const;
+
+    btQuaternion getQDot(std::size_t s, std::size_t segment) const;
+
+    /** The generalized forces on the quaternion of the segment */
+    btQuaternion getTPrime(std::size_t s, std::size_t segment) const;
+
+    btVector3 getTorque(std::size_t s, std::size_t segment) const;
+
+private:
+
+    void stepPrerequisites();
+
+    /** Stretch, shear and the quaternion alignment constraint */
+    void computeLinkForces();
+
+    /** Bending and twisting between neighbouring centerlines */
+    void computeBendTwistForces();
+
+    void unconstrainedMotion(btScalar dt);
+
+    /** Appends a link and its centerline slot, all coefficients zero */
+    void addGapLink();
+
+    bool invariant() const;
+
+    /// Index of the first mass point (and link) of each string
+    std::vector<std::size_t> m_firstPoint;
+
+    /// Mass point state, one entry per point
+    std::vector<btScalar> m_posX, m_posY, m_posZ;
+    std::vector<btScalar> m_velX, m_velY, m_velZ;
+    std::vector<btScalar> m_forceX, m_forceY, m_forceZ;
+    std::vector<btScalar> m_inverseMass;
+
+    /**
+     * Mass link constants, one entry per link. Gap links use a length
+     * of one and a gap of one so the kernel never divides by zero
+     */
+    std::vector<btScalar> m_linkLength;
+    std::vector<btScalar> m_inverseLength5;
+    std::vector<btScalar> m_linkGap;
+    std::vector<btScalar> m_stretchStiffness;
+    std::vector<btScalar> m_gammaT;
+    std::vector<btScalar> m_consSpring;
+    /// Whether the constraint force is applied to the first and second point
+    std::vector<btScalar> m_consWeight0, m_consWeight1;
+
+    /// Per link forces on the first and second point, summed afterwards
+    std::vector<btScalar> m_linkForce0X, m_linkForce0Y, m_linkForce0Z;
+    std::vector<btScalar> m_linkForce1X, m_linkForce1Y, m_linkForce1Z;
+
+    /// Centerline state, one entry per link
+    std::vector<btScalar> m_q0, m_q1, m_q2, m_q3;
+    std::vector<btScalar> m_qdot0, m_qdot1, m_qdot2, m_qdot3;
+    std::vector<btScalar> m_tprime0, m_tprime1, m_tprime2, m_tprime3;
+    std::vector<btScalar> m_torqueX, m_torqueY, m_torqueZ;
+    std::vector<btScalar> m_omegaX, m_omegaY, m_omegaZ;
+    /// Diagonal of the inertia tensor and its inverse
+    std::vector<btScalar> m_inertiaX, m_inertiaY, m_inertiaZ;
+    std::vector<btScalar> m_inverseInertiaX, m_inverseInertiaY, m_inverseInertiaZ;
+
+    /**
+     * Constants between centerline j and j + 1, one entry per link.
+     * Zero where j + 1 doesn't belong to the same string
+     */
+    std::vector<btScalar> m_bendStiffness1, m_bendStiffness2, m_bendStiffness3;
+    std::vector<btScalar> m_bendDamping;
+
+    /// Per pair generalized forces on centerline j and j + 1
+    std::vector<btScalar> m_pairForce0[4];
+    std::vector<btScalar> m_pairForce1[4];
+};
+
+#endif // CORDE_BATCH
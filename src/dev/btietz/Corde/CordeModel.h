@@ -36,6 +36,8 @@
 // The C++ Standard Library
 #include <vector>
 
+class CordeBatch;
+
 class CordeModel
 {
 public:
@@ -74,91 +76,62 @@ public:
 	 */
 	CordeModel(btVector3 pos1, btVector3 pos2, btQuaternion quat1, btQuaternion quat2, CordeModel::Config& Config);
 	
+	/**
+	 * Same as above, but the string is added to a batch shared by every
+	 * string in the world instead of one owned by this model. The owner
+	 * of the batch steps it once per world step, and must keep it alive
+	 * for as long as this model.
+	 */
+	CordeModel(btVector3 pos1, btVector3 pos2, btQuaternion quat1, btQuaternion quat2, CordeModel::Config& Config,
+				CordeBatch& sharedBatch);
+	
 	~CordeModel();
 	
+	/**
+	 * Steps the batch if this model owns it. With a shared batch this
+	 * only advances the debug output, since stepping it here would step
+	 * every other string in it too.
+	 */
 	void step (btScalar dt);
 	
-private:
-	void computeConstants();
-
-	void stepPrerequisites();
-
-	void computeInternalForces();
-	
-	void unconstrainedMotion(double dt);
-	
 	/**
-	 * Holds all of the data for one of the mass elements of the string
+	 * The structure of arrays storage that holds this string, which is
+	 * string getStringIndex() within it.
 	 */
-	struct CordePositionElement
+	const CordeBatch& getBatch() const
 	{
-		/**
-		 * Sets pos to p1, mass to m, everything else to zero
-		 * Assumes rod is at rest on start
-		 */
-		CordePositionElement(btVector3 p1, double m);
-		
-		btVector3 pos;
-		btVector3 vel;
-		btVector3 force;
-		double mass;
-	};
+		return *m_batch;
+	}
 	
-	/**
-	 * Holds all of the data for the centerline quaternions of the string
-	 */
-	struct CordeQuaternionElement
-	{	
-		/**
-		 * Sets q to q1.normalized(), everything else to zero
-		 */
-		CordeQuaternionElement(btQuaternion q1);
-		
-		void transposeTorques();
-		/**
-		 * Must be called after transpose torques and omega is updated
-		 */
-		void updateQDot();
-		
-		btQuaternion q;
-		btQuaternion qdot;
-		/**
-		 * Just a 4x1 vector, but easier to store this way.
-		 */
-		btQuaternion tprime;
-		btVector3 torques;
-		btVector3 omega;
-	};
+	std::size_t getStringIndex() const
+	{
+		return m_stringIndex;
+	}
 	
-	CordeModel::Config m_config;
+private:
+
+	/** Disable the copy constructor. */
+	CordeModel(const CordeModel&);
+
+	/** Disable the assignment operator. */
+	CordeModel& operator=(const CordeModel&);
+
+	void printState() const;
 	
-	std::vector<CordePositionElement*> m_massPoints;
-	std::vector<CordeQuaternionElement*> m_centerlines;
-	/**
-	 * Should have length equal to m_massPoints.size()-1
-	 */
-	std::vector<double> linkLengths;
-	/**
-	 * Should have length equal to m_Centerlines.size()-1
-	 */
-	std::vector<double> quaternionShapes;
+	CordeModel::Config m_config;
 	
 	/**
-	 * Computed based on the values in config. Should have length 4
-	 * 0: linear stiffness used by mass models
-	 * 1 - 3: bending and torsion stiffnesses
-	 * @todo can this be const?
+	 * Holds the mass points and centerline quaternions. Either allocated
+	 * in the constructor and deleted in the destructor, which is why
+	 * copying is disabled above, or shared and owned elsewhere. Held by
+	 * pointer because CordeBatch.h needs CordeModel::Config.
 	 */
-	std::vector<double> computedStiffness;
+	CordeBatch* m_batch;
 	
-	/**
-	 * Computed based on the values in config. Should have length 3
-	 * Assuming products of inertia are negligible as in the paper
-	 */
-	btVector3 computedInertia;
-	btVector3 inverseInertia;
+	/** Whether m_batch was allocated by this model */
+	const bool m_ownsBatch;
 	
-	bool invariant();
+	std::size_t m_stringIndex;
 	
 	double simTime;
 };
@@ -72,8 +72,7 @@ int main(int argc, char** argv)
     while (steps < 30000)
     {
         testAdapter.initialize(&testEvolution,
-                        learning,
-                        testConfigData);
+                        learning);
         
         std::vector<std::vector<double> > actions = testAdapter.step(0.0, state);
         double score1 = 0.0;
@@ -137,17 +137,13 @@ void SpineGoalControl::onSetup(BaseSpineModelLearning& subject)
 	m_pCPGSys = new CPGEquationsFB(200);
     //Initialize the Learning Adapters
     nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
+                            nodeLearning);
     edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
+                            edgeLearning);
     feedbackAdapter.initialize(&feedbackEvolution,
-                                feedbackLearning,
-                                feedbackConfigData);
+                                feedbackLearning);
     goalAdapter.initialize(&goalEvolution,
-                            goalLearning,
-                            goalConfigData);
+                            goalLearning);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
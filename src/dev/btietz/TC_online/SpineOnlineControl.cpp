@@ -138,8 +138,7 @@ void SpineOnlineControl::onStep(BaseSpineModelLearning& subject, double dt)
                 goalAdapter.endEpisode(tempScores);
                 
                 goalAdapter.initialize(&goalEvolution,
-                        goalLearning,
-                        goalConfigData);
+                        goalLearning);
                 m_controllerStartDist = dist;
 #else
                 throw std::runtime_error("Moved away from goal");
@@ -62,11 +62,9 @@ void LearningSpineSine::onSetup(BaseSpineModelLearning& subject)
 {
     //Initialize the Learning Adapters
     nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
+                            nodeLearning);
     edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
+                            edgeLearning);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
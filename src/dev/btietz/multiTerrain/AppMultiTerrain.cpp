@@ -278,20 +278,20 @@ tgWorld* AppMultiTerrain::createWorld()
         981 // gravity, cm/sec^2
     );
     
-    tgBulletGround* ground;
+    tgTerrainLibrary::Handle ground;
     
     if (add_hills)
     {
         const tgHillyGround::Config hillGroundConfig = getHillyConfig();
-        ground = new tgHillyGround(hillGroundConfig);
+        ground = terrains.hilly(hillGroundConfig);
     }
     else
     {
         const tgBoxGround::Config groundConfig = getBoxConfig();
-        ground = new tgBoxGround(groundConfig);
+        ground = terrains.box(groundConfig);
     }
     
-    return new tgWorld(config, ground);
+    return new tgWorld(config, terrains, ground);
 }
 
 tgSimViewGraphics *AppMultiTerrain::createGraphicsView(tgWorld *world)
@@ -343,23 +343,18 @@ void AppMultiTerrain::simulate(tgSimulation *simulation)
             // Nothing to do here, score will be set to -1
         }
         
-        // Don't change the terrain before the last episode to avoid leaks
-        if (all_terrain && i != nEpisodes - 1)
+        // The library only builds each terrain the first time
+        if (all_terrain)
         {   
             // Next run has Hills
             if (i % nTypes == 0)
             {
-                
-                const tgHillyGround::Config hillGroundConfig = getHillyConfig();
-                tgBulletGround* ground = new tgHillyGround(hillGroundConfig);
-                simulation->reset(ground);
+                simulation->reset(terrains, terrains.hilly(getHillyConfig()));
             }
             // Flat
             else if (i % nTypes == 1)
             {
-                const tgBoxGround::Config groundConfig = getBoxConfig();
-                tgBulletGround* ground = new tgBoxGround(groundConfig);
-                simulation->reset(ground);
+                simulation->reset(terrains, terrains.box(getBoxConfig()));
             }
             // Flat with blocks
             else if (i % nTypes == 2)
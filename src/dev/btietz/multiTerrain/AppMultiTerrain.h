@@ -43,6 +43,7 @@
 #include "core/tgWorld.h"
 #include "core/terrain/tgBoxGround.h"
 #include "core/terrain/tgHillyGround.h"
+#include "core/terrain/tgTerrainLibrary.h"
 
 // Boost
 #include <boost/program_options.hpp>
@@ -86,6 +87,9 @@ private:
     void simulate(tgSimulation *simulation);
     
     
+    /** Each terrain is built once, outlives world */
+    tgTerrainLibrary terrains;
+    
     // Keep these around for cleanup
     tgWorld* world;
     tgSimView* view;
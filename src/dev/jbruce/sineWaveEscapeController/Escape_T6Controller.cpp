@@ -201,10 +201,8 @@ void Escape_T6Controller::setupAdapter() {
     string configAnnealEvolution = "Config.ini";
     AnnealEvolution* evo = new AnnealEvolution(suffix, configAnnealEvolution);
     bool isLearning = true;
-    configuration configEvolutionAdapter;
-    configEvolutionAdapter.readFile(configAnnealEvolution);
 
-    evolutionAdapter.initialize(evo, isLearning, configEvolutionAdapter);
+    evolutionAdapter.initialize(evo, isLearning);
 }
 
 //TODO: Doesn't seem to correctly calculate energy spent by tensegrity
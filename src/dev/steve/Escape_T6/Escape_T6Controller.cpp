@@ -216,21 +216,10 @@ void Escape_T6Controller::applyActions(Escape_T6Model& subject, std::vector< std
 void Escape_T6Controller::setupAdapter() {
     //std::string suffix = "_Escape";
     
-    std::string path;
-    if (configPath != "") {
-        path = FileHelpers::getResourcePath(configPath);
-    }
-    else {
-        path = "";
-    }
-    
-    std::string configAnnealEvolution = path + configName;
     AnnealEvolution* evo = new AnnealEvolution(suffix, configName, configPath);
     bool isLearning = true;
-    configuration configEvolutionAdapter;
-    configEvolutionAdapter.readFile(configAnnealEvolution);
 
-    evolutionAdapter.initialize(evo, isLearning, configEvolutionAdapter);
+    evolutionAdapter.initialize(evo, isLearning);
 }
 
 double Escape_T6Controller::totalEnergySpent(Escape_T6Model& subject) {
@@ -0,0 +1,227 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AppPrismFork.cpp
+ * @brief Warms the prism up under a sine wave controller once, then
+ * compares variants of the controller from that state in parallel
+ * @author agent
+ * $Id$
+ */
+
+// This application
+#include "PrismModel.h"
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgObserver.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgWorld.h"
+#include "learning/StateFork/StateFork.h"
+// Bullet Physics
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    /** Shortens and lengthens every muscle in phase */
+    class PrismSineControl : public tgObserver<PrismModel>
+    {
+    public:
+
+        PrismSineControl(double amplitude, double frequency) :
+        m_amplitude(amplitude),
+        m_frequency(frequency),
+        m_time(0.0)
+        {
+        }
+
+        virtual void onSetup(PrismModel& subject)
+        {
+            m_startLengths.clear();
+            const std::vector<tgSpringCableActuator*>& muscles =
+                subject.getAllActuators();
+            for (std::size_t i = 0; i < muscles.size(); i++)
+            {
+                m_startLengths.push_back(muscles[i]->getStartLength());
+            }
+            m_time = 0.0;
+        }
+
+        virtual void onStep(PrismModel& subject, double dt)
+        {
+            m_time += dt;
+            const double phase = 2.0 * M_PI * m_frequency * m_time;
+            const std::vector<tgSpringCableActuator*>& muscles =
+                subject.getAllActuators();
+            for (std::size_t i = 0; i < muscles.size(); i++)
+            {
+                tgBasicActuator* const pMuscle =
+                    tgCast::cast<tgSpringCableActuator, tgBasicActuator>(muscles[i]);
+                if (pMuscle != NULL)
+                {
+                    pMuscle->setControlInput(m_startLengths[i] *
+                                             (1.0 - m_amplitude * std::sin(phase)),
+                                             dt);
+                }
+            }
+        }
+
+        /** Change the wave without resetting the time, so the phase carries on */
+        void setWave(double amplitude, double frequency)
+        {
+            m_amplitude = amplitude;
+            m_frequency = frequency;
+        }
+
+    private:
+        double m_amplitude;
+        double m_frequency;
+        double m_time;
+        std::vector<double> m_startLengths;
+    };
+
+    btVector3 centerOfMass(tgModel& model)
+    {
+        const std::vector<tgRod*> rods = model.find<tgRod>("rod");
+        btVector3 sum(0.0, 0.0, 0.0);
+        double mass = 0.0;
+        for (std::size_t i = 0; i < rods.size(); i++)
+        {
+            sum += rods[i]->centerOfMass() * rods[i]->mass();
+            mass += rods[i]->mass();
+        }
+        return sum / mass;
+    }
+
+    /** Runs the rest of the episode with one wave, in a forked process */
+    class PrismContinuation : public StateFork::Continuation
+    {
+    public:
+
+        PrismContinuation(tgSimulation& simulation,
+                          PrismModel& model,
+                          PrismSineControl& control,
+                          int steps) :
+        m_simulation(simulation),
+        m_model(model),
+        m_control(control),
+        m_steps(steps)
+        {
+        }
+
+        /**
+         * @param[in] parameters amplitude and frequency
+         * @return horizontal distance travelled since the fork
+         */
+        virtual std::vector<double>
+        run(const std::vector< std::vector<double> >& parameters)
+        {
+            const btVector3 start = centerOfMass(m_model);
+            m_control.setWave(parameters[0][0], parameters[0][1]);
+            m_simulation.run(m_steps);
+            const btVector3 end = centerOfMass(m_model);
+
+            std::vector<double> scores;
+            scores.push_back(btVector3(end.x() - start.x(), 0.0,
+                                       end.z() - start.z()).length());
+            return scores;
+        }
+
+    private:
+        tgSimulation& m_simulation;
+        PrismModel& m_model;
+        PrismSineControl& m_control;
+        const int m_steps;
+    };
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[1] optionally the warm-up seconds, argv[2]
+ * optionally the seconds each variant runs for
+ * @return 0
+ */
+int main(int argc, char** argv)
+{
+    const double warmUp = argc > 1 ? std::atof(argv[1]) : 10.0;
+    const double episode = argc > 2 ? std::atof(argv[2]) : 5.0;
+    const double timestep = 0.001;
+
+    // Declared first, so it outlives the model's teardown
+    PrismSineControl control(0.1, 1.0);
+
+    const tgBoxGround::Config groundConfig(btVector3(0.0, 0.0, 0.0));
+    tgBoxGround* ground = new tgBoxGround(groundConfig);
+    const tgWorld::Config config(981); // gravity, cm/sec^2
+    tgWorld world(config, ground);
+    // Graphics can't be forked
+    tgSimView view(world, timestep);
+    tgSimulation simulation(view);
+
+    PrismModel* const myModel = new PrismModel();
+    myModel->attach(&control);
+    simulation.addModel(myModel);
+
+    // Paid once for every variant
+    simulation.run(static_cast<int>(warmUp / timestep + 0.5));
+
+    std::vector< std::vector< std::vector<double> > > variants;
+    const double amplitudes[] = {0.05, 0.1, 0.2};
+    const double frequencies[] = {0.5, 1.0, 2.0};
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        for (std::size_t j = 0; j < 3; j++)
+        {
+            std::vector<double> wave;
+            wave.push_back(amplitudes[i]);
+            wave.push_back(frequencies[j]);
+            variants.push_back(std::vector< std::vector<double> >(1, wave));
+        }
+    }
+
+    PrismContinuation continuation(simulation, *myModel, control,
+                                   static_cast<int>(episode / timestep + 0.5));
+    StateFork stateFork;
+    const std::vector< std::vector<double> > scores =
+        stateFork.run(continuation, variants);
+
+    for (std::size_t i = 0; i < variants.size(); i++)
+    {
+        std::cout << "amplitude " << variants[i][0][0]
+                  << " frequency " << variants[i][0][1] << ": ";
+        if (scores[i].empty())
+        {
+            std::cout << "failed" << std::endl;
+        }
+        else
+        {
+            std::cout << scores[i][0] << " cm" << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AppPrismPrecision.cpp
+ * @brief Runs the prism without graphics and records its rods, so a single
+ * and a double precision build can be compared with
+ * bin/utilities/compare_precision.py
+ * @author agent
+ * $Id$
+ */
+
+// This application
+#include "PrismModel.h"
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/tgModel.h"
+#include "core/tgObserver.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgSpringCableActuator.h"
+#include "core/tgWorld.h"
+// Bullet Physics
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    /**
+     * Moves every cable's rest length on a sine wave, each with its own
+     * phase, so the prism rolls and hits the ground instead of settling
+     */
+    class SineControl : public tgObserver<PrismModel>
+    {
+    public:
+
+        SineControl() :
+        m_time(0.0)
+        {
+        }
+
+        virtual void onSetup(PrismModel& subject)
+        {
+            const std::vector<tgSpringCableActuator*>& actuators =
+                subject.getAllActuators();
+            m_restLengths.clear();
+            for (std::size_t i = 0; i < actuators.size(); i++)
+            {
+                m_restLengths.push_back(actuators[i]->getRestLength());
+            }
+            m_time = 0.0;
+        }
+
+        virtual void onStep(PrismModel& subject, double dt)
+        {
+            m_time += dt;
+            const std::vector<tgSpringCableActuator*>& actuators =
+                subject.getAllActuators();
+            for (std::size_t i = 0; i < actuators.size(); i++)
+            {
+                const double target = m_restLengths[i] *
+                    (1.0 - 0.2 * sin(2.0 * M_PI * m_time + 0.7 * i));
+                actuators[i]->setControlInput(target, dt);
+            }
+        }
+
+    private:
+        double m_time;
+        std::vector<double> m_restLengths;
+    };
+
+    /** Append the center of mass of every rod at time */
+    void record(std::ostream& out, tgModel& model, double time)
+    {
+        const std::vector<tgRod*> rods = model.find<tgRod>("rod");
+        for (std::size_t i = 0; i < rods.size(); i++)
+        {
+            const btVector3 com = rods[i]->centerOfMass();
+            out << time << "," << i << ","
+                << com.x() << "," << com.y() << "," << com.z() << std::endl;
+        }
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[1] the CSV to write, argv[2] optionally the
+ * number of seconds to simulate
+ * @return 0
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " output.csv [seconds]"
+                  << std::endl;
+        return 1;
+    }
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 20.0;
+
+#ifdef BT_USE_DOUBLE_PRECISION
+    const char* const precision = "double";
+#else
+    const char* const precision = "single";
+#endif
+
+    const tgBoxGround::Config groundConfig(btVector3(0.0, 0.0, 0.0));
+    // the world will delete this
+    tgBoxGround* ground = new tgBoxGround(groundConfig);
+
+    const tgWorld::Config config(981); // gravity, cm/sec^2
+    tgWorld world(config, ground);
+
+    const double timestep_physics = 0.001; // seconds
+    tgSimView view(world, timestep_physics);
+
+    // Outlives the simulation, which tears the model down
+    SineControl control;
+    tgSimulation simulation(view);
+
+    PrismModel* const myModel = new PrismModel();
+    myModel->attach(&control);
+    simulation.addModel(myModel);
+
+    std::ofstream out(argv[1]);
+    out.precision(12);
+    out << "# " << precision << std::endl;
+    out << "time,rod,x,y,z" << std::endl;
+
+    // Record every 0.1 s
+    const int stepsPerRecord = 100;
+    const int records = static_cast<int>(seconds * 10.0 + 0.5);
+
+    double stepSeconds = 0.0;
+    record(out, *myModel, 0.0);
+    for (int i = 1; i <= records; i++)
+    {
+        const std::clock_t start = std::clock();
+        simulation.run(stepsPerRecord);
+        stepSeconds += double(std::clock() - start) / CLOCKS_PER_SEC;
+        record(out, *myModel, i * stepsPerRecord * timestep_physics);
+    }
+
+    std::cout << precision << " precision, "
+              << records * stepsPerRecord << " steps, "
+              << 1.0e6 * stepSeconds / (records * stepsPerRecord)
+              << " us per step" << std::endl;
+
+    return 0;
+}
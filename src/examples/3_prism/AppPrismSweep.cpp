@@ -0,0 +1,286 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AppPrismSweep.cpp
+ * @brief Sweeps the cable stiffness, damping and pretension of the
+ * prism and the physics timestep on every core, writing one line per
+ * point to a CSV
+ * @author agent
+ * $Id$
+ */
+
+// This library
+#include "core/terrain/tgBoxGround.h"
+#include "core/terrain/tgTerrainLibrary.h"
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgSimView.h"
+#include "core/tgSimulation.h"
+#include "core/tgWorld.h"
+#include "learning/ParameterSweep/ParameterSweep.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgConnectorInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructurePrototype.h"
+// Bullet Physics
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /** False for NaN and infinity */
+    bool isFinite(double x)
+    {
+        return x - x == 0.0;
+    }
+
+    /** An instance of the prototype every point in a process shares */
+    class SweepPrism : public tgModel
+    {
+    public:
+
+        SweepPrism(tgStructurePrototype& prototype) :
+        m_prototype(prototype)
+        {
+        }
+
+        virtual void setup(tgWorld& world)
+        {
+            m_prototype.instantiate(*this, world);
+            tgModel::setup(world);
+        }
+
+    private:
+        tgStructurePrototype& m_prototype;
+    };
+
+    /** Drops the prism and measures where it settles */
+    class PrismWorker : public ParameterSweep::Worker
+    {
+    public:
+
+        PrismWorker(double seconds) :
+        m_seconds(seconds),
+        m_pPrototype(NULL)
+        {
+        }
+
+        virtual ~PrismWorker()
+        {
+            delete m_pPrototype;
+        }
+
+        /**
+         * The terrain and prototype every point in this process shares.
+         * The build spec is matched once here, each point only sets the
+         * cable config.
+         */
+        virtual void setup()
+        {
+            m_ground = m_terrains.box(tgBoxGround::Config(btVector3(0.0, 0.0, 0.0)));
+
+            // Same geometry as PrismModel
+            m_structure.addNode(-5.0, 0, 0);
+            m_structure.addNode( 5.0, 0, 0);
+            m_structure.addNode(0, 0, 10.0);
+            m_structure.addNode(-5.0, 20.0, 0);
+            m_structure.addNode( 5.0, 20.0, 0);
+            m_structure.addNode(0, 20.0, 10.0);
+            m_structure.addPair(0, 4, "rod");
+            m_structure.addPair(1, 5, "rod");
+            m_structure.addPair(2, 3, "rod");
+            m_structure.addPair(0, 1, "muscle");
+            m_structure.addPair(1, 2, "muscle");
+            m_structure.addPair(2, 0, "muscle");
+            m_structure.addPair(3, 4, "muscle");
+            m_structure.addPair(4, 5, "muscle");
+            m_structure.addPair(5, 3, "muscle");
+            m_structure.addPair(0, 3, "muscle");
+            m_structure.addPair(1, 4, "muscle");
+            m_structure.addPair(2, 5, "muscle");
+            m_structure.move(btVector3(0, 10, 0));
+
+            const tgRod::Config rodConfig(0.31, 0.2);
+            tgBuildSpec spec;
+            spec.addBuilder("rod", new tgRodInfo(rodConfig));
+            spec.addBuilder("muscle",
+                            new tgBasicActuatorInfo(tgBasicActuator::Config()));
+            m_pPrototype = new tgStructurePrototype(m_structure, spec);
+        }
+
+        /**
+         * @param[in] values stiffness, damping, pretension, timestep
+         * @return final height, horizontal drift and mean tension
+         */
+        virtual std::vector<double> evaluate(const std::vector<double>& values)
+        {
+            const tgSpringCableActuator::Config muscleConfig(values[0],
+                                                             values[1],
+                                                             values[2]);
+            const double timestep = values[3];
+
+            const std::vector<tgConnectorInfo*>& connectors =
+                m_pPrototype->getConnectors();
+            for (std::size_t i = 0; i < connectors.size(); i++)
+            {
+                tgBasicActuatorInfo* const muscle =
+                    tgCast::cast<tgConnectorInfo, tgBasicActuatorInfo>(connectors[i]);
+                if (muscle != NULL)
+                {
+                    muscle->setConfig(muscleConfig);
+                }
+            }
+
+            const tgWorld::Config config(981); // gravity, cm/sec^2
+            tgWorld world(config, m_terrains, m_ground);
+            tgSimView view(world, timestep);
+            tgSimulation simulation(view);
+
+            SweepPrism* const model = new SweepPrism(*m_pPrototype);
+            simulation.addModel(model);
+            const btVector3 start = centerOfMass(*model);
+
+            simulation.run(static_cast<int>(m_seconds / timestep + 0.5));
+
+            const btVector3 end = centerOfMass(*model);
+            const std::vector<tgSpringCableActuator*> muscles =
+                model->find<tgSpringCableActuator>("muscle");
+            double tension = 0.0;
+            for (std::size_t i = 0; i < muscles.size(); i++)
+            {
+                tension += muscles[i]->getTension();
+            }
+            tension /= muscles.size();
+
+            // Blew up or fell through the ground
+            if (!isFinite(end.length()) || !isFinite(tension) ||
+                end.y() < -10.0 || (end - start).length() > 1000.0)
+            {
+                return std::vector<double>();
+            }
+
+            std::vector<double> metrics;
+            metrics.push_back(end.y());
+            metrics.push_back(btVector3(end.x() - start.x(), 0.0,
+                                        end.z() - start.z()).length());
+            metrics.push_back(tension);
+            return metrics;
+        }
+
+    private:
+
+        static btVector3 centerOfMass(tgModel& model)
+        {
+            const std::vector<tgRod*> rods = model.find<tgRod>("rod");
+            btVector3 sum(0.0, 0.0, 0.0);
+            double mass = 0.0;
+            for (std::size_t i = 0; i < rods.size(); i++)
+            {
+                sum += rods[i]->centerOfMass() * rods[i]->mass();
+                mass += rods[i]->mass();
+            }
+            return sum / mass;
+        }
+
+        const double m_seconds;
+        tgTerrainLibrary m_terrains;
+        tgTerrainLibrary::Handle m_ground;
+        tgStructure m_structure;
+
+        /** Owned, outlives the world of every point */
+        tgStructurePrototype* m_pPrototype;
+    };
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv argv[1] the CSV to write, argv[2] optionally grid,
+ * random or lhs, argv[3] optionally the number of samples for random
+ * and lhs
+ * @return 0 if every point was run
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " results.csv [grid|random|lhs] [samples]" << std::endl;
+        return 1;
+    }
+    const std::string sampling = argc > 2 ? argv[2] : "grid";
+    const std::size_t samples = argc > 3 ? std::atoi(argv[3]) : 64;
+
+    std::vector<std::string> metrics;
+    metrics.push_back("height");
+    metrics.push_back("drift");
+    metrics.push_back("mean_tension");
+    ParameterSweep sweep(metrics);
+    sweep.addParameter("stiffness", 100.0, 10000.0, 5, true);
+    sweep.addParameter("damping", 1.0, 100.0, 3, true);
+    sweep.addParameter("pretension", 0.0, 1000.0, 3);
+    sweep.addParameter("timestep", 1.0/2000.0, 1.0/100.0, 3, true);
+
+    std::vector< std::vector<double> > points;
+    if (sampling == "grid")
+    {
+        points = sweep.makePoints(ParameterSweep::grid);
+    }
+    else if (sampling == "random")
+    {
+        points = sweep.makePoints(ParameterSweep::monteCarlo, samples);
+    }
+    else if (sampling == "lhs")
+    {
+        points = sweep.makePoints(ParameterSweep::latinHypercube, samples);
+    }
+    else
+    {
+        std::cerr << "Unknown sampling " << sampling << std::endl;
+        return 1;
+    }
+
+    // Five simulated seconds per point, killed after a minute
+    PrismWorker worker(5.0);
+    const std::vector<ParameterSweep::Result>& results =
+        sweep.run(worker, points, 0, 60.0);
+    sweep.writeCSV(argv[1]);
+
+    std::size_t ok = 0;
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        if (results[i].status == ParameterSweep::ok)
+        {
+            ok++;
+        }
+    }
+    std::cout << ok << " of " << results.size() << " points ran cleanly, see "
+              << argv[1] << std::endl;
+
+    return 0;
+}
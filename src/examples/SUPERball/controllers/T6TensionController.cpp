@@ -45,25 +45,18 @@ T6TensionController::T6TensionController(const double tension) :
 
 T6TensionController::~T6TensionController()
 {
-	std::size_t n = m_controllers.size();
-    for(std::size_t i = 0; i < n; i++)
-    {
-        delete m_controllers[i];
-    }
-    m_controllers.clear();
 }	
 
 void T6TensionController::onSetup(T6Model& subject)
 {
-    const std::vector<tgBasicActuator*> actuators = subject.getAllActuators();
-    for (size_t i = 0; i < actuators.size(); ++i)
+    m_actuators = subject.getAllActuators();
+    m_batch = tgImpedanceController::Batch();
+    const tgImpedanceController impedance(m_tension, 0.0, 0.0);
+    for (size_t i = 0; i < m_actuators.size(); ++i)
     {
-        tgBasicActuator * const pActuator = actuators[i];
-        assert(pActuator != NULL);
-        tgTensionController* m_tensController = new tgTensionController(pActuator, m_tension);
-        m_controllers.push_back(m_tensController);
+        assert(m_actuators[i] != NULL);
+        m_batch.add(impedance);
     }
-
 }
 
 void T6TensionController::onStep(T6Model& subject, double dt)
@@ -74,10 +67,8 @@ void T6TensionController::onStep(T6Model& subject, double dt)
     }
     else
     {
-        std::size_t n = m_controllers.size();
-		for(std::size_t i = 0; i < n; i++)
-        {
-            m_controllers[i]->control(dt, m_tension);
-        }
+        m_batch.read(m_actuators);
+        tgImpedanceController::controlBatch(m_batch, dt);
+        m_batch.apply(m_actuators, dt);
 	}
 }
@@ -29,17 +29,19 @@
 
 // This library
 #include "core/tgObserver.h"
-#include "controllers/tgTensionController.h"
+#include "controllers/tgImpedanceController.h"
 
 // The C++ Standard Library
 #include <vector>
 
 // Forward declarations
 class T6Model;
+class tgBasicActuator;
 
 /**
- * A controller to apply uniform tension to a T6Model. Iterates through
- * all tgLinearString members and calls tensionMinLengthController
+ * A controller to apply uniform tension to a T6Model. Every actuator is
+ * stepped at once by tgImpedanceController::controlBatch, with no length
+ * or velocity stiffness, so the set tension is the same for all.
  */
 class T6TensionController : public tgObserver<T6Model>
 {
@@ -77,7 +79,10 @@ private:
 	 */
     const double m_tension;
     
-    std::vector<tgTensionController*> m_controllers;
+    /** The actuators of the subject, in the order of m_batch */
+    std::vector<tgBasicActuator*> m_actuators;
+
+    tgImpedanceController::Batch m_batch;
 };
 
 #endif // T6_TENSION_CONTROLLER_H
@@ -197,23 +197,10 @@ void EscapeController::applyActions(EscapeModel& subject, std::vector< std::vect
 void EscapeController::setupAdapter() {
     //std::string suffix = "_Escape";
     
-    std::string path;
-    if (configPath != "")
-    {
-        path = FileHelpers::getResourcePath(configPath);
-    }
-    else
-    {
-        path = "";
-    }
-    
-    std::string configAnnealEvolution = path + configName;
     AnnealEvolution* evo = new AnnealEvolution(suffix, configName, configPath);
     bool isLearning = true;
-    configuration configEvolutionAdapter;
-    configEvolutionAdapter.readFile(configAnnealEvolution);
 
-    evolutionAdapter.initialize(evo, isLearning, configEvolutionAdapter);
+    evolutionAdapter.initialize(evo, isLearning);
 }
 
 double EscapeController::totalEnergySpent(EscapeModel& subject) {
@@ -36,14 +36,14 @@
 #include "controllers/tgImpedanceController.h"
 #include "tgCPGActuatorControl.h"
 
-#include "helpers/FileHelpers.h"
-
 #include "learning/AnnealEvolution/AnnealEvolution.h"
 #include "learning/Configuration/configuration.h"
 
 #include "util/CPGEquations.h"
 #include "util/CPGNode.h"
 
+#include "LinearMath/btVector3.h"
+
 //#define LOGGING
 
 using namespace std;
@@ -150,20 +150,11 @@ m_pCPGSys(NULL),
 m_updateTime(0.0),
 bogus(false)
 {
-	std::string path;
-	if (resourcePath != "")
-	{
-		path = FileHelpers::getResourcePath(resourcePath);
-	}
-	else
-	{
-		path = "";
-	}
-	
-    nodeConfigData.readFile(path + nodeConfigFilename);
-    edgeConfigData.readFile(path + edgeConfigFilename);
-    nodeLearning = nodeConfigData.getintvalue("learning");
-    edgeLearning = edgeConfigData.getintvalue("learning");
+    // The evolution objects have already read and checked the files
+    nodeConfigData = nodeEvolution.getConfig().data;
+    edgeConfigData = edgeEvolution.getConfig().data;
+    nodeLearning = nodeEvolution.getConfig().learning;
+    edgeLearning = edgeEvolution.getConfig().learning;
     
 }
 
@@ -177,12 +168,8 @@ void BaseSpineCPGControl::onSetup(BaseSpineModelLearning& subject)
     // Maximum number of sub-steps allowed by CPG
 	m_pCPGSys = new CPGEquations(200);
     //Initialize the Learning Adapters
-    nodeAdapter.initialize(&nodeEvolution,
-                            nodeLearning,
-                            nodeConfigData);
-    edgeAdapter.initialize(&edgeEvolution,
-                            edgeLearning,
-                            edgeConfigData);
+    nodeAdapter.initialize(&nodeEvolution, nodeLearning);
+    edgeAdapter.initialize(&edgeEvolution, edgeLearning);
     /* Empty vector signifying no state information
      * All parameters are stateless parameters, so we can get away with
      * only doing this once
@@ -268,7 +255,7 @@ void BaseSpineCPGControl::onStep(BaseSpineModelLearning& subject, double dt)
         m_updateTime = 0;
     }
     
-    double currentHeight = subject.getSegmentCOM(m_config.segmentNumber)[1];
+    double currentHeight = subject.getSegmentCOMVector(m_config.segmentNumber).getY();
     
     /// @todo add to config
     if (currentHeight > 25 || currentHeight < 1.0)
@@ -363,7 +350,7 @@ double BaseSpineCPGControl::getScore() const
 array_4D BaseSpineCPGControl::scaleEdgeActions  
                             (vector< vector <double> > actions)
 {
-    std::size_t numControllers = edgeConfigData.getintvalue("numberOfControllers");
+    std::size_t numControllers = edgeEvolution.getConfig().numberOfControllers;
     
     // Ensure reading from the same file
     assert(numControllers == actions.size());
@@ -436,8 +423,8 @@ array_4D BaseSpineCPGControl::scaleEdgeActions
 array_2D BaseSpineCPGControl::scaleNodeActions  
                             (vector< vector <double> > actions)
 {
-    std::size_t numControllers = nodeConfigData.getintvalue("numberOfControllers");
-    std::size_t numActions = nodeConfigData.getintvalue("numberOfActions");
+    std::size_t numControllers = nodeEvolution.getConfig().numberOfControllers;
+    std::size_t numActions = nodeEvolution.getConfig().numberOfActions;
     
     assert( actions.size() == numControllers);
     assert( actions[0].size() == numActions);
@@ -28,10 +28,12 @@
 #include "BaseSpineModelLearning.h"
 // This library
 #include "core/tgCast.h"
+#include "core/tgObservationBuffer.h"
 #include "core/tgSpringCableActuator.h"
 #include "core/tgBaseRigid.h"
 #include "core/tgRod.h"
 #include "core/tgString.h"
+#include "core/tgWorld.h"
 // The C++ Standard Library
 #include <algorithm> // std::fill
 #include <iostream>
@@ -39,6 +41,7 @@
 
 BaseSpineModelLearning::BaseSpineModelLearning(int segments) : 
     m_segments(segments),   
+    m_pObservations(NULL),
     tgModel() 
 {
 }
@@ -49,6 +52,29 @@ BaseSpineModelLearning::~BaseSpineModelLearning()
 
 void BaseSpineModelLearning::setup(tgWorld& world)
 {
+    // Read the segments once per step rather than on every query.
+    // Before notifySetup, the controllers read them there
+    m_segmentCOMOffsets.clear();
+    m_muscleOffsets.clear();
+    m_pObservations = NULL;
+    tgObservationBuffer& observations = world.observations();
+    if (m_allSegments.size() == m_segments)
+    {
+        for (std::size_t i = 0; i < m_segments; i++)
+        {
+            const std::vector<tgRod*> rods =
+                tgCast::filter<tgModel, tgRod>(m_allSegments[i]->getDescendants());
+            const std::vector<tgBaseRigid*> rigids(rods.begin(), rods.end());
+            m_segmentCOMOffsets.push_back(observations.addCenterOfMass(rigids));
+        }
+        m_pObservations = &observations;
+    }
+    // For the feedback controllers
+    for (std::size_t i = 0; i < m_allMuscles.size(); i++)
+    {
+        m_muscleOffsets.push_back(observations.addCable(m_allMuscles[i]));
+        m_pObservations = &observations;
+    }
 	
     notifySetup();
     
@@ -66,6 +92,10 @@ void BaseSpineModelLearning::teardown()
     m_allMuscles.clear();
     m_allSegments.clear();
     m_muscleMap.clear();
+    // tgSimulation cleared the observations before the teardown
+    m_segmentCOMOffsets.clear();
+    m_muscleOffsets.clear();
+    m_pObservations = NULL;
 }
 
 void BaseSpineModelLearning::step(double dt)
@@ -115,6 +145,28 @@ const std::vector<tgBaseRigid*> BaseSpineModelLearning::getAllRigids() const
 	return p_rods;
 }
 
+void BaseSpineModelLearning::getMuscleState(std::size_t i,
+                                            double& length,
+                                            double& tension) const
+{
+    if (i >= m_allMuscles.size())
+    {
+        throw std::range_error(tgString("Muscle number >= ", m_allMuscles.size()));
+    }
+    
+    if (!m_muscleOffsets.empty())
+    {
+        const std::size_t offset = m_muscleOffsets[i];
+        length = m_pObservations->get(offset);
+        tension = m_pObservations->get(offset + 2);
+    }
+    else
+    {
+        length = m_allMuscles[i]->getCurrentLength();
+        tension = m_allMuscles[i]->getTension();
+    }
+}
+
 const int BaseSpineModelLearning::getSegments() const
 {
     return m_segments;
@@ -147,6 +199,11 @@ btVector3 BaseSpineModelLearning::getSegmentCOMVector(const int n) const
         throw std::range_error(tgString("Segment number > ", m_segments));
     }
     
+    if (!m_segmentCOMOffsets.empty())
+    {
+        return m_pObservations->getVector(m_segmentCOMOffsets[n]);
+    }
+    
     std::vector<tgRod*> p_rods =
         tgCast::filter<tgModel, tgRod> (m_allSegments[n]->getDescendants());
     
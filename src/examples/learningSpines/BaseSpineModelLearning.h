@@ -36,6 +36,7 @@
 #include <vector>
 
 class tgWorld;
+class tgObservationBuffer;
 class tgStructureInfo;
 class tgSpringCableActuator;
 class tgBaseRigid;
@@ -77,6 +78,14 @@ public:
         return m_allMuscles.size();
     }
     
+    /**
+     * The length and tension of m_allMuscles[i] at the start of this
+     * step, from the world's observations if the muscles were known at
+     * setup, otherwise from the muscle itself.
+     * @throw std::range_error if i is not less than getNumberofMuslces()
+     */
+    void getMuscleState(std::size_t i, double& length, double& tension) const;
+    
     double getSpineLength() const;
     
 protected:
@@ -90,6 +99,23 @@ protected:
     MuscleMap m_muscleMap;
     
     const std::size_t m_segments;
+    
+private:
+    
+    /**
+     * Where each segment's center of mass is in the world's
+     * observations, empty unless m_allSegments was filled before setup
+     */
+    std::vector<std::size_t> m_segmentCOMOffsets;
+    
+    /**
+     * Where each of m_allMuscles is in the world's observations, empty
+     * unless m_allMuscles was filled before setup
+     */
+    std::vector<std::size_t> m_muscleOffsets;
+    
+    /** NULL when nothing was observed, then every call computes them */
+    const tgObservationBuffer* m_pObservations;
 };
 
 #endif // BASE_SPINE_MODEL_H
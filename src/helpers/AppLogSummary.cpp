@@ -0,0 +1,183 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AppLogSummary.cpp
+ * @brief Summarizes each episode of a large log in one pass
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "LogReader.h"
+#include "LogSummary.h"
+// The C++ Standard Library
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void usage(const char* name)
+    {
+        std::cerr << "Usage: " << name << " [options] log" << std::endl
+            << "Writes one CSV row per episode of log to standard output."
+            << std::endl
+            << "  -c name     summarize the column name" << std::endl
+            << "  -t tags     summarize the columns of the models with all"
+            << " of tags," << std::endl
+            << "              or with tags_variable only those, such as"
+            << " \"rod_X\"" << std::endl
+            << "  -e          add the energy spent by the cables" << std::endl
+            << "  -T name     the time column, Time by default" << std::endl
+            << "  -b bytes    read this many bytes at a time" << std::endl
+            << "Without -c or -t every column is summarized." << std::endl;
+    }
+}
+
+/**
+ * The entry point.
+ * @param[in] argc the number of command-line arguments
+ * @param[in] argv the options, then the log to read
+ * @return 0 if the log was read, 1 otherwise
+ */
+int main(int argc, char** argv)
+{
+    std::vector<std::string> names;
+    std::vector<std::string> tags;
+    std::string timeColumn = "Time";
+    bool energy = false;
+    std::size_t chunkSize = 1 << 20;
+
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++)
+    {
+        const std::string option = argv[i];
+        if (option == "-e")
+        {
+            energy = true;
+        }
+        else if (i + 1 == argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else if (option == "-c")
+        {
+            names.push_back(argv[++i]);
+        }
+        else if (option == "-t")
+        {
+            tags.push_back(argv[++i]);
+        }
+        else if (option == "-T")
+        {
+            timeColumn = argv[++i];
+        }
+        else if (option == "-b")
+        {
+            chunkSize = std::strtoul(argv[++i], NULL, 10);
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (i + 1 != argc)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    try
+    {
+        CSVLogReader reader(argv[i], chunkSize);
+        for (std::size_t j = 0; j < names.size(); j++)
+        {
+            reader.selectColumn(names[j]);
+        }
+        for (std::size_t j = 0; j < tags.size(); j++)
+        {
+            // "rod_X" is the X of every rod, "rod" all of their columns
+            const std::size_t underscore = tags[j].rfind('_');
+            try
+            {
+                if (underscore == std::string::npos)
+                {
+                    throw std::invalid_argument(tags[j]);
+                }
+                reader.selectTagged(tags[j].substr(0, underscore),
+                                    tags[j].substr(underscore + 1));
+            }
+            catch (const std::invalid_argument&)
+            {
+                // Or a tag with an underscore in it
+                reader.selectTagged(tags[j]);
+            }
+        }
+        if (names.empty() && tags.empty())
+        {
+            reader.selectAll();
+        }
+
+        LogSummary summary(reader, timeColumn, energy);
+        const std::vector<std::string>& columns = summary.getColumns();
+
+        std::cout.precision(std::numeric_limits<double>::digits10 + 2);
+        std::cout << "episode,rows,start time,end time,energy";
+        for (std::size_t j = 0; j < columns.size(); j++)
+        {
+            std::cout << "," << columns[j] << "_mean"
+                << "," << columns[j] << "_min"
+                << "," << columns[j] << "_max"
+                << "," << columns[j] << "_first"
+                << "," << columns[j] << "_final";
+        }
+        std::cout << std::endl;
+
+        LogSummary::Episode episode;
+        for (std::size_t number = 0; summary.nextEpisode(episode); number++)
+        {
+            std::cout << number << "," << episode.rows
+                << "," << episode.startTime << "," << episode.endTime
+                << "," << episode.energy;
+            for (std::size_t j = 0; j < episode.columns.size(); j++)
+            {
+                const LogSummary::Statistics& statistics =
+                    episode.columns[j];
+                std::cout << "," << statistics.mean
+                    << "," << statistics.min
+                    << "," << statistics.max
+                    << "," << statistics.first
+                    << "," << statistics.final;
+            }
+            std::cout << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << argv[0] << ": " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
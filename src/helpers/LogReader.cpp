@@ -0,0 +1,343 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file LogReader.cpp
+ * @brief Contains the definitions of members of classes LogReader and
+ * CSVLogReader
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "LogReader.h"
+// The C++ Standard Library
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * Parse the field between begin and end.
+     * @return false if it isn't a number, leaving value alone
+     */
+    bool parseField(const char* begin, const char* end, double& value)
+    {
+        if (begin == end)
+        {
+            return false;
+        }
+        char* parsed;
+        const double result = std::strtod(begin, &parsed);
+        // strtod skips whitespace, which may include the newline
+        if (parsed == begin || parsed > end)
+        {
+            return false;
+        }
+        value = result;
+        return true;
+    }
+
+    const char* fieldEnd(const char* begin, const char* end)
+    {
+        const void* comma = std::memchr(begin, ',', end - begin);
+        return comma ? static_cast<const char*>(comma) : end;
+    }
+
+    /** Split "rod 3_X" into the words "rod", "3" and the variable "X" */
+    void splitName(const std::string& name,
+                   std::vector<std::string>& words,
+                   std::string& variable)
+    {
+        const std::size_t underscore = name.rfind('_');
+        std::string prefix;
+        if (underscore == std::string::npos)
+        {
+            prefix = name;
+            variable.clear();
+        }
+        else
+        {
+            prefix = name.substr(0, underscore);
+            variable = name.substr(underscore + 1);
+        }
+        std::istringstream stream(prefix);
+        words.clear();
+        std::string word;
+        while (stream >> word)
+        {
+            words.push_back(word);
+        }
+    }
+}
+
+LogReader::LogReader() :
+  m_numRead(0)
+{
+}
+
+LogReader::~LogReader()
+{
+}
+
+void LogReader::setColumns(const std::vector<std::string>& columns)
+{
+    m_columns = columns;
+    m_slot.assign(columns.size(), -1);
+    m_selected.clear();
+    m_numRead = 0;
+}
+
+int LogReader::findColumn(const std::string& name) const
+{
+    for (std::size_t i = 0; i < m_columns.size(); i++)
+    {
+        if (m_columns[i] == name)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+std::size_t LogReader::select(std::size_t column)
+{
+    if (column >= m_columns.size())
+    {
+        throw std::out_of_range("Log column out of range");
+    }
+    if (m_slot[column] < 0)
+    {
+        m_slot[column] = m_selected.size();
+        m_selected.push_back(column);
+        if (column + 1 > m_numRead)
+        {
+            m_numRead = column + 1;
+        }
+    }
+    return m_slot[column];
+}
+
+std::size_t LogReader::selectColumn(const std::string& name)
+{
+    const int column = findColumn(name);
+    if (column < 0)
+    {
+        throw std::invalid_argument("No log column named " + name);
+    }
+    return select(column);
+}
+
+std::size_t LogReader::selectTagged(const std::string& tags,
+                                    const std::string& variable)
+{
+    std::vector<std::string> wanted;
+    std::string unused;
+    splitName(tags, wanted, unused);
+
+    std::vector<std::string> words;
+    std::string columnVariable;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_columns.size(); i++)
+    {
+        splitName(m_columns[i], words, columnVariable);
+        if (!variable.empty() && columnVariable != variable)
+        {
+            continue;
+        }
+        bool matches = true;
+        for (std::size_t j = 0; j < wanted.size() && matches; j++)
+        {
+            matches = false;
+            for (std::size_t k = 0; k < words.size(); k++)
+            {
+                if (words[k] == wanted[j])
+                {
+                    matches = true;
+                    break;
+                }
+            }
+        }
+        if (matches)
+        {
+            select(i);
+            count++;
+        }
+    }
+    if (count == 0)
+    {
+        throw std::invalid_argument("No log columns tagged " + tags);
+    }
+    return count;
+}
+
+void LogReader::selectAll()
+{
+    for (std::size_t i = 0; i < m_columns.size(); i++)
+    {
+        select(i);
+    }
+}
+
+CSVLogReader::CSVLogReader(const std::string& fileName,
+                           std::size_t chunkSize) :
+  m_file(std::fopen(fileName.c_str(), "rb")),
+  m_chunkSize(chunkSize > 0 ? chunkSize : 1),
+  m_buffer(m_chunkSize + 1),
+  m_begin(0),
+  m_end(0),
+  m_eof(false)
+{
+    if (!m_file)
+    {
+        throw std::runtime_error("Could not open log " + fileName);
+    }
+
+    std::vector<std::string> columns;
+    const char* begin;
+    const char* end;
+    if (nextLine(begin, end))
+    {
+        double value;
+        const bool header = !parseField(begin, fieldEnd(begin, end), value);
+        const char* field = begin;
+        while (true)
+        {
+            const char* const last = fieldEnd(field, end);
+            if (header)
+            {
+                columns.push_back(std::string(field, last));
+            }
+            else
+            {
+                std::ostringstream name;
+                name << columns.size();
+                columns.push_back(name.str());
+            }
+            if (last == end)
+            {
+                break;
+            }
+            field = last + 1;
+        }
+        // tgDataObserver ends every line with a comma
+        if (begin != end && end[-1] == ',')
+        {
+            columns.pop_back();
+        }
+        if (!header)
+        {
+            // Nothing has been moved yet, so read the line again as a row
+            m_begin = 0;
+        }
+    }
+    setColumns(columns);
+}
+
+CSVLogReader::~CSVLogReader()
+{
+    std::fclose(m_file);
+}
+
+bool CSVLogReader::nextLine(const char*& begin, const char*& end)
+{
+    while (true)
+    {
+        char* const data = &m_buffer[0];
+        const void* const newline =
+            std::memchr(data + m_begin, '\n', m_end - m_begin);
+        if (newline || (m_eof && m_begin != m_end))
+        {
+            begin = data + m_begin;
+            end = newline ? static_cast<const char*>(newline) : data + m_end;
+            m_begin = newline ? end - data + 1 : m_end;
+            if (end != begin && end[-1] == '\r')
+            {
+                --end;
+            }
+            return true;
+        }
+        else if (m_eof)
+        {
+            return false;
+        }
+
+        // Keep the partial line and read a chunk after it
+        const std::size_t partial = m_end - m_begin;
+        std::memmove(data, data + m_begin, partial);
+        m_begin = 0;
+        m_end = partial;
+        if (m_buffer.size() < partial + m_chunkSize + 1)
+        {
+            m_buffer.resize(partial + m_chunkSize + 1);
+        }
+        const std::size_t read =
+            std::fread(&m_buffer[m_end], 1, m_chunkSize, m_file);
+        if (read < m_chunkSize)
+        {
+            if (std::ferror(m_file))
+            {
+                throw std::runtime_error("Could not read log");
+            }
+            m_eof = true;
+        }
+        m_end += read;
+        // Stops strtod at the end of a last line without a newline
+        m_buffer[m_end] = '\0';
+    }
+}
+
+bool CSVLogReader::readRow(std::vector<double>& values)
+{
+    const char* begin;
+    const char* end;
+    while (nextLine(begin, end))
+    {
+        const char* field = begin;
+        const char* last = fieldEnd(field, end);
+        double value;
+        if (!parseField(field, last, value))
+        {
+            // A header or an empty line
+            continue;
+        }
+
+        values.assign(getSelected().size(),
+                      std::numeric_limits<double>::quiet_NaN());
+        for (std::size_t column = 0; column < m_numRead; column++)
+        {
+            const int slot = m_slot[column];
+            if (slot >= 0)
+            {
+                parseField(field, last, values[slot]);
+            }
+            if (last == end)
+            {
+                break;
+            }
+            field = last + 1;
+            last = fieldEnd(field, end);
+        }
+        return true;
+    }
+    return false;
+}
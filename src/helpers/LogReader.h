@@ -0,0 +1,196 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef LOG_READER_H
+#define LOG_READER_H
+
+/**
+ * @file LogReader.h
+ * @brief Contains the definitions of classes LogReader and CSVLogReader
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * Reads a log one row at a time, keeping only the selected columns.
+ * Memory doesn't grow with the length of the log, so logs much larger
+ * than memory can be scanned.
+ *
+ * Columns are selected by name, or by the tags and variable of the
+ * models tgDataObserver wrote them for. Its columns are named
+ * "<tags> <number>_<variable>", such as "rod 3_X" or "saddle 2_Ten".
+ *
+ * Subclasses parse a format. Only CSVLogReader exists so far; a binary
+ * format only has to name its columns and implement readRow.
+ */
+class LogReader
+{
+public:
+
+    virtual ~LogReader();
+
+    /** The names of all columns, in the order of the log */
+    const std::vector<std::string>& getColumns() const
+    {
+        return m_columns;
+    }
+
+    /** The index of the column named name, -1 if there is none */
+    int findColumn(const std::string& name) const;
+
+    /**
+     * Add a column to the rows returned by readRow.
+     * @param[in] column an index into getColumns()
+     * @return the column's position in a row. If it was already
+     * selected, its position is unchanged.
+     * @throw std::out_of_range if there is no such column
+     */
+    std::size_t select(std::size_t column);
+
+    /**
+     * Select the column named name.
+     * @throw std::invalid_argument if there is no such column
+     */
+    std::size_t selectColumn(const std::string& name);
+
+    /**
+     * Select the columns of the models with all of tags, in the order
+     * of the log.
+     * @param[in] tags space separated, as written by tgTags
+     * @param[in] variable such as "X" or "RL", empty for all of them
+     * @return the number of columns selected
+     * @throw std::invalid_argument if no column matches
+     */
+    std::size_t selectTagged(const std::string& tags,
+                             const std::string& variable = "");
+
+    /** Select every column, in the order of the log */
+    void selectAll();
+
+    /** The selected columns, in the order of a row */
+    const std::vector<std::size_t>& getSelected() const
+    {
+        return m_selected;
+    }
+
+    /**
+     * Read the next row.
+     * @param[out] values one value per selected column, NaN where the
+     * row has none
+     * @return false at the end of the log
+     */
+    virtual bool readRow(std::vector<double>& values) = 0;
+
+protected:
+
+    LogReader();
+
+    /** Called by the subclass once it has read the names */
+    void setColumns(const std::vector<std::string>& columns);
+
+    /** The position of each column in a row, -1 if not selected */
+    std::vector<int> m_slot;
+
+    /** The largest selected column index plus one, 0 if none */
+    std::size_t m_numRead;
+
+private:
+
+    /** Disable the copy constructor. */
+    LogReader(const LogReader&);
+
+    /** Disable the assignment operator. */
+    LogReader& operator=(const LogReader&);
+
+private:
+
+    std::vector<std::string> m_columns;
+
+    std::vector<std::size_t> m_selected;
+};
+
+/**
+ * Reads the comma separated logs written by tgDataObserver, and
+ * headerless ones such as the scores.csv of the evolution runs, in
+ * chunks of a fixed size.
+ *
+ * The first line is the header unless its first field is a number;
+ * headerless columns are named "0", "1" and so on. Later lines that
+ * don't start with a number, such as the headers of logs that were
+ * concatenated, are skipped. Each line is only parsed up to the last
+ * selected column, and only the selected fields are converted.
+ */
+class CSVLogReader : public LogReader
+{
+public:
+
+    /**
+     * Open the log and read its header.
+     * @param[in] fileName the log
+     * @param[in] chunkSize the number of bytes read at a time. A line
+     * longer than this is still read whole.
+     * @throw std::runtime_error if the file can't be opened
+     */
+    CSVLogReader(const std::string& fileName,
+                 std::size_t chunkSize = 1 << 20);
+
+    virtual ~CSVLogReader();
+
+    virtual bool readRow(std::vector<double>& values);
+
+private:
+
+    /**
+     * Find the next line in the buffer, reading a chunk if it isn't
+     * all there.
+     * @param[out] begin the first character of the line
+     * @param[out] end one past its last, at the newline
+     * @return false at the end of the file
+     */
+    bool nextLine(const char*& begin, const char*& end);
+
+    /** Disable the copy constructor. */
+    CSVLogReader(const CSVLogReader&);
+
+    /** Disable the assignment operator. */
+    CSVLogReader& operator=(const CSVLogReader&);
+
+private:
+
+    std::FILE* m_file;
+
+    const std::size_t m_chunkSize;
+
+    /** The unread lines are between m_begin and m_end */
+    std::vector<char> m_buffer;
+
+    std::size_t m_begin;
+
+    std::size_t m_end;
+
+    bool m_eof;
+};
+
+#endif  // LOG_READER_H
@@ -0,0 +1,171 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file LogSummary.cpp
+ * @brief Contains the definitions of members of class LogSummary
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "LogSummary.h"
+#include "LogReader.h"
+// The C++ Standard Library
+#include <limits>
+
+LogSummary::Statistics::Statistics() :
+  count(0),
+  mean(std::numeric_limits<double>::quiet_NaN()),
+  min(std::numeric_limits<double>::quiet_NaN()),
+  max(std::numeric_limits<double>::quiet_NaN()),
+  first(std::numeric_limits<double>::quiet_NaN()),
+  final(std::numeric_limits<double>::quiet_NaN())
+{
+}
+
+LogSummary::LogSummary(LogReader& reader,
+                       const std::string& timeColumn,
+                       bool energy) :
+  m_reader(reader),
+  m_timeSlot(-1),
+  m_pending(false)
+{
+    const std::vector<std::string>& columns = reader.getColumns();
+    const std::vector<std::size_t>& selected = reader.getSelected();
+    // They stay at the front of a row
+    for (std::size_t i = 0; i < selected.size(); i++)
+    {
+        m_names.push_back(columns[selected[i]]);
+    }
+
+    const int time = reader.findColumn(timeColumn);
+    if (time >= 0)
+    {
+        m_timeSlot = reader.select(time);
+    }
+
+    if (energy)
+    {
+        const std::string restLength = "_RL";
+        for (std::size_t i = 0; i < columns.size(); i++)
+        {
+            const std::string& name = columns[i];
+            if (name.size() <= restLength.size() ||
+                name.compare(name.size() - restLength.size(),
+                             restLength.size(), restLength) != 0)
+            {
+                continue;
+            }
+            const int tension = reader.findColumn(
+                name.substr(0, name.size() - restLength.size()) + "_Ten");
+            if (tension >= 0)
+            {
+                m_cables.push_back(std::make_pair(reader.select(i),
+                                                  reader.select(tension)));
+            }
+        }
+    }
+}
+
+bool LogSummary::nextEpisode(Episode& episode)
+{
+    if (!m_pending && !m_reader.readRow(m_row))
+    {
+        return false;
+    }
+    m_pending = false;
+
+    const std::size_t n = m_names.size();
+    episode.rows = 0;
+    episode.energy = 0.0;
+    episode.startTime = m_timeSlot < 0 ?
+        std::numeric_limits<double>::quiet_NaN() : m_row[m_timeSlot];
+    episode.endTime = episode.startTime;
+    episode.columns.assign(n, Statistics());
+    std::vector<double> sums(n, 0.0);
+
+    do
+    {
+        if (episode.rows > 0 && m_timeSlot >= 0 &&
+            m_row[m_timeSlot] < episode.endTime)
+        {
+            // The time went back, so this row starts the next episode
+            m_pending = true;
+            break;
+        }
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            const double value = m_row[i];
+            if (value != value)
+            {
+                continue;
+            }
+            Statistics& statistics = episode.columns[i];
+            if (statistics.count == 0)
+            {
+                statistics.first = value;
+                statistics.min = value;
+                statistics.max = value;
+            }
+            else
+            {
+                statistics.min = value < statistics.min ? value : statistics.min;
+                statistics.max = value > statistics.max ? value : statistics.max;
+            }
+            statistics.final = value;
+            sums[i] += value;
+            statistics.count++;
+        }
+
+        if (episode.rows > 0)
+        {
+            for (std::size_t i = 0; i < m_cables.size(); i++)
+            {
+                const double previousTension = m_previous[m_cables[i].second];
+                const double shortening =
+                    m_previous[m_cables[i].first] - m_row[m_cables[i].first];
+                // NaN compares false, so a missing value adds nothing
+                if (shortening > 0.0 && previousTension == previousTension)
+                {
+                    episode.energy += previousTension * shortening;
+                }
+            }
+        }
+
+        if (m_timeSlot >= 0)
+        {
+            episode.endTime = m_row[m_timeSlot];
+        }
+        episode.rows++;
+        m_previous.swap(m_row);
+    }
+    while (m_reader.readRow(m_row));
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        Statistics& statistics = episode.columns[i];
+        if (statistics.count > 0)
+        {
+            statistics.mean = sums[i] / statistics.count;
+        }
+    }
+    return true;
+}
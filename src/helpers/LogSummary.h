@@ -0,0 +1,155 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef LOG_SUMMARY_H
+#define LOG_SUMMARY_H
+
+/**
+ * @file LogSummary.h
+ * @brief Contains the definition of class LogSummary
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// The C++ Standard Library
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class LogReader;
+
+/**
+ * Summarizes each episode of a log in one pass over a LogReader,
+ * holding one row and one set of statistics at a time.
+ *
+ * An episode ends where the time column goes back, as it does when
+ * tgDataObserver's logs of several runs are concatenated. A log without
+ * a time column, such as scores.csv, is a single episode.
+ */
+class LogSummary
+{
+public:
+
+    /** Of one column over one episode. NaN values are left out. */
+    struct Statistics
+    {
+        Statistics();
+
+        std::size_t count;
+
+        double mean;
+
+        double min;
+
+        double max;
+
+        double first;
+
+        /** Such as the final position of a rod */
+        double final;
+    };
+
+    struct Episode
+    {
+        /** The number of rows */
+        std::size_t rows;
+
+        /** The time of the first row, NaN without a time column */
+        double startTime;
+
+        /** The time of the last row */
+        double endTime;
+
+        /**
+         * The work the cables did shortening, as computed by the
+         * learningSpines controllers from the actuator histories: the
+         * tension of each row times the shortening of the rest length
+         * until the next row, summed over every cable with both an "_RL"
+         * and a "_Ten" column. Positive, where those controllers report
+         * it negated. 0 unless asked for.
+         */
+        double energy;
+
+        /** In the order of getColumns() */
+        std::vector<Statistics> columns;
+    };
+
+    /**
+     * Summarize the columns selected in reader so far. Selects the time
+     * column, and the cable columns if energy is wanted, without adding
+     * them to the statistics.
+     * @param[in,out] reader not owned, must outlive the summary
+     * @param[in] timeColumn the name of the time column
+     * @param[in] energy true to sum the energy spent by the cables
+     */
+    LogSummary(LogReader& reader,
+               const std::string& timeColumn = "Time",
+               bool energy = false);
+
+    /** The names of the columns with statistics */
+    const std::vector<std::string>& getColumns() const
+    {
+        return m_names;
+    }
+
+    /** The number of cables whose energy is summed */
+    std::size_t getNumCables() const
+    {
+        return m_cables.size();
+    }
+
+    /**
+     * Read the next episode.
+     * @param[out] episode its summary
+     * @return false if the log has no more rows
+     */
+    bool nextEpisode(Episode& episode);
+
+private:
+
+    /** Disable the copy constructor. */
+    LogSummary(const LogSummary&);
+
+    /** Disable the assignment operator. */
+    LogSummary& operator=(const LogSummary&);
+
+private:
+
+    LogReader& m_reader;
+
+    /** The summarized columns, first in a row */
+    std::vector<std::string> m_names;
+
+    /** The position of the time column in a row, -1 without one */
+    int m_timeSlot;
+
+    /** The positions of the rest length and tension of each cable */
+    std::vector<std::pair<std::size_t, std::size_t> > m_cables;
+
+    std::vector<double> m_row;
+
+    std::vector<double> m_previous;
+
+    /** True if m_row holds the first row of the next episode */
+    bool m_pending;
+};
+
+#endif  // LOG_SUMMARY_H
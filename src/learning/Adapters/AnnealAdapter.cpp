@@ -30,7 +30,6 @@
 #include <sstream>
 #include <fstream>
 #include "AnnealAdapter.h"
-#include "learning/Configuration/configuration.h"
 #include "helpers/FileHelpers.h"
 
 using namespace std;
@@ -41,11 +40,12 @@ totalTime(0.0)
 }
 AnnealAdapter::~AnnealAdapter(){};
 
-void AnnealAdapter::initialize(AnnealEvolution *evo,bool isLearning,configuration configdata)
+void AnnealAdapter::initialize(AnnealEvolution *evo,bool isLearning)
 {
-    numberOfActions=configdata.getDoubleValue("numberOfActions");
-    numberOfStates=configdata.getDoubleValue("numberOfStates");
-    numberOfControllers=configdata.getDoubleValue("numberOfControllers");
+    const EvolutionConfig& config = evo->getConfig();
+    numberOfActions=config.numberOfActions;
+    numberOfStates=config.numberOfStates;
+    numberOfControllers=config.numberOfControllers;
     totalTime=0.0;
 
     //This Function initializes the parameterset from evo.
@@ -104,3 +104,13 @@ void AnnealAdapter::endEpisode(vector<double> scores)
     }
     return;
 }
+
+bool AnnealAdapter::endEpisodeFromCache()
+{
+    return annealEvo->updateScoresFromCache();
+}
+
+tgRandomStream AnnealAdapter::episodeStream(unsigned int domain) const
+{
+    return annealEvo->episodeStream(domain);
+}
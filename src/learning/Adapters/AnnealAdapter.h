@@ -42,9 +42,22 @@ public:
      * For NTRT this means main or simulator needs to own the pointer to
      * AnnealEvolution, we can't create it here
      */
-    void initialize(AnnealEvolution *evo,bool isLearning,configuration config);
+    void initialize(AnnealEvolution *evo,bool isLearning);
     std::vector<std::vector<double> > step(double deltaTimeSeconds, std::vector<double> state);
     void endEpisode(std::vector<double> state);
+    /**
+     * Call after initialize. If the evolution object has a cached score
+     * for the current parameters it is recorded and this returns true,
+     * so the episode does not need to be simulated.
+     * Only meaningful if useFitnessCache is on in the config file
+     */
+    bool endEpisodeFromCache();
+    /**
+     * Call after initialize. Random numbers for this episode only, such
+     * as a terrain, which are the same whenever the run is repeated
+     * with its randomSeed. See AnnealEvolution::episodeStream
+     */
+    tgRandomStream episodeStream(unsigned int domain = 0) const;
 
 private:
     int numberOfActions;
@@ -0,0 +1,108 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file AnnealFarmAdapter.cpp
+ * @brief Contains the implementation of class AnnealFarmAdapter.
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "AnnealFarmAdapter.h"
+#include "learning/AnnealEvolution/AnnealEvolution.h"
+#include "learning/AnnealEvolution/AnnealEvoMember.h"
+#include "learning/EvaluationFarm/EvaluationFarm.h"
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+AnnealFarmAdapter::AnnealFarmAdapter(AnnealEvolution* evo, EvaluationFarm* farm) :
+m_pEvolution(evo),
+m_pFarm(farm)
+{
+    if (evo == NULL)
+    {
+        throw std::invalid_argument("Pointer to evolution is NULL");
+    }
+    else if (farm == NULL)
+    {
+        throw std::invalid_argument("Pointer to farm is NULL");
+    }
+}
+
+AnnealFarmAdapter::~AnnealFarmAdapter() { }
+
+std::size_t AnnealFarmAdapter::runGeneration(vector<Failure>& failures)
+{
+    return runEpisodes(m_pEvolution->nextBatchOfControllers(), failures);
+}
+
+std::size_t AnnealFarmAdapter::runEpisodes(const vector< vector< AnnealEvoMember* > >& batch,
+                                           vector<Failure>& failures)
+{
+    failures.clear();
+    
+    vector< vector< AnnealEvoMember* > > toRun;
+    vector< vector< vector<double> > > jobs;
+    for (std::size_t i = 0; i < batch.size(); i++)
+    {
+        if (m_pEvolution->updateScoresFromCache(batch[i]))
+        {
+            continue;
+        }
+        
+        vector< vector<double> > params;
+        for (std::size_t j = 0; j < batch[i].size(); j++)
+        {
+            params.push_back(batch[i][j]->statelessParameters);
+        }
+        toRun.push_back(batch[i]);
+        jobs.push_back(params);
+    }
+    
+    vector<EvaluationFarm::Result> results = m_pFarm->evaluate(jobs);
+    
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        if (results[i].status != EvaluationFarm::completed)
+        {
+            Failure failure;
+            failure.controllers = toRun[i];
+            failure.status = results[i].status;
+            failures.push_back(failure);
+        }
+        else if (results[i].scores.empty())
+        {
+            // Same handling of exploded episodes as AnnealAdapter::endEpisode
+            vector<double> tmp(1);
+            tmp[0] = -1;
+            m_pEvolution->updateScores(toRun[i], tmp);
+            cout << "Exploded" << endl;
+        }
+        else
+        {
+            m_pEvolution->updateScores(toRun[i], results[i].scores);
+        }
+    }
+    
+    return jobs.size();
+}
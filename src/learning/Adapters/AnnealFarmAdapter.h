@@ -0,0 +1,104 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef ANNEALFARMADAPTER_H_
+#define ANNEALFARMADAPTER_H_
+
+/**
+ * @file AnnealFarmAdapter.h
+ * @brief Defines a class AnnealFarmAdapter to evaluate a whole
+ * generation of AnnealEvolution in an EvaluationFarm
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "learning/EvaluationFarm/EvaluationFarm.h"
+
+#include <cstddef>
+#include <vector>
+
+// Forward declarations
+class AnnealEvolution;
+class AnnealEvoMember;
+
+/**
+ * The coordinator side of a parallel learning run. Where AnnealAdapter
+ * runs one episode at a time in the current process, this sends every
+ * episode of a generation to the farm's worker processes and records
+ * the scores they return. The workers are responsible for scaling the
+ * 0.0 to 1.0 parameters into their controllers.
+ *
+ * An episode whose worker crashed, timed out or threw is not scored,
+ * since the same parameters may well pass on another try. It is handed
+ * back to the caller, which can run it again with runEpisodes or give
+ * up on it, before the next runGeneration moves on to the next
+ * generation. Episodes that the worker reports as exploded are scored
+ * as AnnealAdapter::endEpisode scores them.
+ */
+class AnnealFarmAdapter
+{
+public:
+
+    /** An episode that the farm couldn't evaluate */
+    struct Failure
+    {
+        std::vector< AnnealEvoMember* > controllers;
+        EvaluationFarm::Status status;
+    };
+
+    /**
+     * @param[in] evo the evolution object, owned by the caller
+     * @param[in] farm the worker pool, owned by the caller
+     */
+    AnnealFarmAdapter(AnnealEvolution* evo, EvaluationFarm* farm);
+
+    ~AnnealFarmAdapter();
+
+    /**
+     * Evaluate everything left in the current generation. Parameter sets
+     * found in the fitness cache are not sent to the workers.
+     * @param[out] failures replaced with the episodes that weren't scored
+     * @return the number of episodes that were sent to the workers
+     */
+    std::size_t runGeneration(std::vector<Failure>& failures);
+
+    /**
+     * Evaluate and score some episodes of the current generation, such
+     * as the controllers of earlier failures.
+     * @param[in] batch sets of controllers from
+     * AnnealEvolution::nextBatchOfControllers
+     * @param[out] failures replaced with the episodes that weren't scored
+     * @return the number of episodes that were sent to the workers
+     */
+    std::size_t runEpisodes(const std::vector< std::vector< AnnealEvoMember* > >& batch,
+                            std::vector<Failure>& failures);
+
+private:
+
+    /** Disable the copy constructor. */
+    AnnealFarmAdapter(const AnnealFarmAdapter&);
+
+    /** Disable the assignment operator. */
+    AnnealFarmAdapter& operator=(const AnnealFarmAdapter&);
+
+    AnnealEvolution* m_pEvolution;
+    EvaluationFarm* m_pFarm;
+};
+
+#endif /* ANNEALFARMADAPTER_H_ */
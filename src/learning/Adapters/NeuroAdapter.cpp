@@ -25,7 +25,6 @@
  */
 
 #include "NeuroAdapter.h"
-#include "learning/Configuration/configuration.h"
 #include "helpers/FileHelpers.h"
 #include "neuralNet/Neural Network v2/neuralNetwork.h"
 
@@ -43,11 +42,12 @@ totalTime(0.0)
 }
 NeuroAdapter::~NeuroAdapter(){};
 
-void NeuroAdapter::initialize(NeuroEvolution *evo,bool isLearning,configuration configdata)
+void NeuroAdapter::initialize(NeuroEvolution *evo,bool isLearning)
 {
-	numberOfActions=configdata.getDoubleValue("numberOfActions");
-	numberOfStates=configdata.getDoubleValue("numberOfStates");
-	numberOfControllers=configdata.getDoubleValue("numberOfControllers");
+	const EvolutionConfig& config = evo->getConfig();
+	numberOfActions=config.numberOfActions;
+	numberOfStates=config.numberOfStates;
+	numberOfControllers=config.numberOfControllers;
 	totalTime=0.0;
 
 	//This Function initializes the parameterset from evo.
@@ -41,7 +41,7 @@ public:
 	 * For NTRT this means main or simulator needs to own the pointer to
 	 * NeuroEvolution, we can't create it here
 	 */
-	void initialize(NeuroEvolution *evo,bool isLearning,configuration config);
+	void initialize(NeuroEvolution *evo,bool isLearning);
 	std::vector<std::vector<double> > step(double deltaTimeSeconds, std::vector<double> state);
 	void endEpisode(std::vector<double> state);
 
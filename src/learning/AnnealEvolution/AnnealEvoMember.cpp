@@ -26,6 +26,7 @@
  */
 
 #include "AnnealEvoMember.h"
+#include "CheckpointIO.h"
 #include <fstream>
 #include <iostream>
 #include <assert.h>
@@ -33,43 +34,43 @@
 
 using namespace std;
 
-AnnealEvoMember::AnnealEvoMember(configuration config)
+AnnealEvoMember::AnnealEvoMember(const EvolutionConfig& config, tgRandomStream& random)
 {
-    //readConfigFromXML(configFile);
-    this->numOutputs=config.getintvalue("numberOfActions");
-    this->devBase=config.getDoubleValue("deviation");
-    this->monteCarlo=config.getintvalue("MonteCarlo");
+    this->numOutputs=config.numberOfActions;
+    this->devBase=config.deviation;
+    this->monteCarlo=config.monteCarlo;
     
     statelessParameters.resize(numOutputs);
     for(int i=0;i<numOutputs;i++)
-        statelessParameters[i]=rand()*1.0/RAND_MAX;
+        statelessParameters[i]=random.uniform();
 
     maxScore=-1000;
+    maxScore1=0.0;
+    maxScore2=0.0;
+    averageScore=0.0;
 }
 
 AnnealEvoMember::~AnnealEvoMember()
 {
 }
 
-void AnnealEvoMember::mutate(std::tr1::ranlux64_base_01 *eng, double T){
+void AnnealEvoMember::mutate(tgRandomStream& random, double T){
     
     assert (T <= 1.0);
-    std::tr1::uniform_real<double> unif(0, 1);
 
     //TODO: for each weight of the NN with 0.5 probability mutate it
 
     double dev = devBase * T / 100.0; 
-    std::tr1::normal_distribution<double> normal(0, dev);
     for(std::size_t i=0;i<statelessParameters.size();i++)
     {
         double newParam;
         if (monteCarlo)
         {
-            newParam= unif(*eng);
+            newParam= random.uniform();
         }
         else
         {   
-            double mutAmount = normal(*eng);
+            double mutAmount = random.normal(0.0, dev);
               //std::cout<<"param: "<<i<<" dev: "<<dev<<" rand: "<<mutAmount<<endl;
             newParam= statelessParameters[i] + mutAmount;
         }
@@ -141,3 +142,27 @@ void AnnealEvoMember::loadFromFile(const char * outputFilename)
     ss.close();
 
 }
+
+void AnnealEvoMember::writeCheckpoint(std::ostream& out) const
+{
+    CheckpointIO::write(out, statelessParameters);
+    CheckpointIO::write(out, pastScores);
+    CheckpointIO::write(out, maxScore);
+    CheckpointIO::write(out, maxScore1);
+    CheckpointIO::write(out, maxScore2);
+    CheckpointIO::write(out, averageScore);
+}
+
+void AnnealEvoMember::readCheckpoint(std::istream& in)
+{
+    CheckpointIO::read(in, statelessParameters, numOutputs);
+    if (statelessParameters.size() != (std::size_t) numOutputs)
+    {
+        throw std::runtime_error("Checkpoint does not match numberOfActions");
+    }
+    CheckpointIO::read(in, pastScores);
+    CheckpointIO::read(in, maxScore);
+    CheckpointIO::read(in, maxScore1);
+    CheckpointIO::read(in, maxScore2);
+    CheckpointIO::read(in, averageScore);
+}
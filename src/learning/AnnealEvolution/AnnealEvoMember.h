@@ -28,22 +28,27 @@
  * $Id$
  */
 
+#include <iosfwd>
 #include <string>
 #include <vector>
-#include <tr1/random>
-#include "learning/Configuration/configuration.h"
+#include "core/tgRandomStream.h"
+#include "learning/Configuration/EvolutionConfig.h"
 
 
 class AnnealEvoMember
 {
 public:
-    AnnealEvoMember(configuration config);
+    /// Draws the initial parameters from random
+    AnnealEvoMember(const EvolutionConfig& config, tgRandomStream& random);
     ~AnnealEvoMember();
-    void mutate(std::tr1::ranlux64_base_01 *eng, double T);
+    void mutate(tgRandomStream& random, double T);
 
     void copyFrom(AnnealEvoMember *otherMember);
     void saveToFile(const char* outputFilename);
     void loadFromFile(const char* inputFilename);
+    /// Binary dump of parameters and scores, see AnnealEvolution checkpoints
+    void writeCheckpoint(std::ostream& out) const;
+    void readCheckpoint(std::istream& in);
 
     std::vector<double> statelessParameters;
     //scores for evaluation
@@ -26,26 +26,30 @@
  */
 
 #include "AnnealEvoPopulation.h"
+#include "CheckpointIO.h"
 #include <string>
 #include <vector>
 #include <iostream>
 #include <numeric>
 #include <fstream>
 #include <algorithm>
+#include <stdexcept>
 
 using namespace std;
 
-AnnealEvoPopulation::AnnealEvoPopulation(int populationSize,configuration config)
+AnnealEvoPopulation::AnnealEvoPopulation(int populationSize,const EvolutionConfig& config,
+                                         unsigned int seed, int index)
 {
-    compareAverageScores=true;
-    clearScoresBetweenGenerations=false;
-    this->compareAverageScores=config.getintvalue("compareAverageScores");
-    this->clearScoresBetweenGenerations=config.getintvalue("clearScoresBetweenGenerations");
+    this->compareAverageScores=config.compareAverageScores;
+    this->clearScoresBetweenGenerations=config.clearScoresBetweenGenerations;
+    this->populationSize=populationSize;
+    this->index=index;
 
     for(int i=0;i<populationSize;i++)
     {
         //cout<<"  creating members"<<endl;
-        controllers.push_back(new AnnealEvoMember(config));
+        tgRandomStream random(seed, 0, index * populationSize + i);
+        controllers.push_back(new AnnealEvoMember(config, random));
     }
 }
 
@@ -57,14 +61,15 @@ AnnealEvoPopulation::~AnnealEvoPopulation()
     }
 }
 
-void AnnealEvoPopulation::mutate(std::tr1::ranlux64_base_01 *engPntr,std::size_t numMutate, double T)
+void AnnealEvoPopulation::mutate(unsigned int seed, int generation, std::size_t numMutate, double T)
 {
     for(std::size_t i=0;i<numMutate;i++)
     {
         int copyFrom = 0; // Always copy from the best
         int copyTo = this->controllers.size()-1-i;
         controllers.at(copyTo)->copyFrom(controllers.at(copyFrom));
-        controllers.at(copyTo)->mutate(engPntr, T);
+        tgRandomStream random(seed, generation, index * populationSize + copyTo);
+        controllers.at(copyTo)->mutate(random, T);
     }
     return;
 }
@@ -98,6 +103,29 @@ void AnnealEvoPopulation::orderPopulation()
 
 }
 
+void AnnealEvoPopulation::writeCheckpoint(std::ostream& out) const
+{
+    const std::size_t n = controllers.size();
+    CheckpointIO::write(out, n);
+    for(std::size_t i=0;i<n;i++)
+    {
+        controllers[i]->writeCheckpoint(out);
+    }
+}
+
+void AnnealEvoPopulation::readCheckpoint(std::istream& in)
+{
+    const std::size_t n = CheckpointIO::readSize(in, controllers.size(), 1);
+    if (n != controllers.size())
+    {
+        throw std::runtime_error("Checkpoint does not match populationSize");
+    }
+    for(std::size_t i=0;i<n;i++)
+    {
+        controllers[i]->readCheckpoint(in);
+    }
+}
+
 void AnnealEvoPopulation::readConfigFromXML(std::string configFile)
 {
     int intValue;
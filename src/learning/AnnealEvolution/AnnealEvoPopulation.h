@@ -33,13 +33,26 @@
 
 class AnnealEvoPopulation {
 public:
-    AnnealEvoPopulation(int numControllers,configuration config);
+    /**
+     * Member i starts from the stream (seed, 0, index * numControllers + i, 0)
+     * @param[in] index which population this is among those of the run
+     */
+    AnnealEvoPopulation(int numControllers,const EvolutionConfig& config,
+                        unsigned int seed, int index);
     ~AnnealEvoPopulation();
     std::vector<AnnealEvoMember *> controllers;
-    void mutate(std::tr1::ranlux64_base_01 *eng,std::size_t numToMutate, double T);
+    /**
+     * The member mutated into slot i draws from the stream
+     * (seed, generation, index * populationSize + i, 0), so nothing
+     * depends on the other populations or the order they are mutated in
+     */
+    void mutate(unsigned int seed, int generation, std::size_t numToMutate, double T);
     void orderPopulation();
     AnnealEvoMember * selectMemberToEvaluate();
     AnnealEvoMember * getMember(int i){return controllers[i];};
+    /// Members are written in their current order
+    void writeCheckpoint(std::ostream& out) const;
+    void readCheckpoint(std::istream& in);
 
 private:
     static bool comparisonFuncForAverage(AnnealEvoMember * elm1, AnnealEvoMember * elm2);
@@ -48,6 +61,7 @@ private:
     bool compareAverageScores;
     bool clearScoresBetweenGenerations;
     int populationSize;
+    int index;
 };
 
 
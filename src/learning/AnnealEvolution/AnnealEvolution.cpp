@@ -26,14 +26,18 @@
  */
  
 #include "AnnealEvolution.h"
+#include "CheckpointIO.h"
 #include "learning/Configuration/configuration.h"
 #include "core/tgString.h"
 #include "helpers/FileHelpers.h"
+#include <cstdio>
 #include <iostream>
 #include <numeric>
 #include <string>
 #include <sstream>
 #include <stdexcept>
+// POSIX, for truncate
+#include <unistd.h>
 
 using namespace std;
 
@@ -53,44 +57,67 @@ unsigned long long rdtsc(){
 
 #endif
 
+namespace
+{
+    /// Domain 0 is the members' parameters, see AnnealEvoPopulation
+    const unsigned int selectionDomain = 1;
+    const unsigned int firstEpisodeDomain = 2;
+
+    std::string fullResourcePath(const std::string& path)
+    {
+        if (path != "")
+        {
+            return FileHelpers::getResourcePath(path);
+        }
+        else
+        {
+            return "";
+        }
+    }
+}
+
 AnnealEvolution::AnnealEvolution(std::string suff, std::string config, std::string path) :
 suffix(suff),
-Temp(1.0)
+resourcePath(fullResourcePath(path)),
+evoConfig(EvolutionConfig::load(resourcePath + config,
+                                EvolutionConfig::annealEvolution)),
+Temp(1.0),
+fitnessCache(NULL),
+episodeGeneration(0),
+episodeTest(0),
+episodeSubtest(0)
 {
     currentTest=0;
     subTests = 0;
     generationNumber=0;
-	
-	if (path != "")
-	{
-		resourcePath = FileHelpers::getResourcePath(path);
-	}
-	else
-	{
-		resourcePath = "";
-	}
-	
-	std::string configPath = resourcePath + config;
-	
-    configuration myconfigdataaa;
-    myconfigdataaa.readFile(configPath);
-    populationSize=myconfigdataaa.getintvalue("populationSize");
-    numberOfElementsToMutate=myconfigdataaa.getintvalue("numberOfElementsToMutate");
-    numberOfTestsBetweenGenerations=myconfigdataaa.getintvalue("numberOfTestsBetweenGenerations");
-    numberOfSubtests=myconfigdataaa.getintvalue("numberOfSubtests");
-    numberOfControllers=myconfigdataaa.getintvalue("numberOfControllers"); //shared with ManhattanToyController
-    leniencyCoef=myconfigdataaa.getDoubleValue("leniencyCoef");
-    coevolution=myconfigdataaa.getintvalue("coevolution");
-    seeded = myconfigdataaa.getintvalue("startSeed");
     
-    bool learning = myconfigdataaa.getintvalue("learning");
+    populationSize=evoConfig.populationSize;
+    numberOfElementsToMutate=evoConfig.numberOfElementsToMutate;
+    numberOfTestsBetweenGenerations=evoConfig.numberOfTestsBetweenGenerations;
+    numberOfSubtests=evoConfig.numberOfSubtests;
+    numberOfControllers=evoConfig.numberOfControllers; //shared with ManhattanToyController
+    leniencyCoef=evoConfig.leniencyCoef;
+    coevolution=evoConfig.coevolution;
+    seeded = evoConfig.startSeed;
+    
+    bool learning = evoConfig.learning;
+    
+    scenarioSeed = evoConfig.scenarioSeed;
+    if (evoConfig.useFitnessCache)
+    {
+        fitnessCache = new FitnessCache(resourcePath + "logs/fitnessCache-" + suffix + ".csv");
+    }
+    checkpointInterval = evoConfig.checkpointInterval;
+    bool resume = evoConfig.resumeFromCheckpoint;
+    checkpointPath = resourcePath + "logs/checkpoint-" + suffix + ".bin";
 
-    srand(rdtsc());
-    eng.seed(rdtsc());
+    // Printed so a run without a randomSeed can still be repeated
+    seed = evoConfig.randomSeed != 0 ? evoConfig.randomSeed : rdtsc();
+    cout << "Random seed " << seed << endl;
 
     for(int j=0;j<numberOfControllers;j++)
     {
-        populations.push_back(new AnnealEvoPopulation(populationSize,myconfigdataaa));
+        populations.push_back(new AnnealEvoPopulation(populationSize,evoConfig,seed,j));
     }
     
     // Overwrite the random parameters based on data
@@ -104,9 +131,28 @@ Temp(1.0)
             seededPop->loadFromFile(ss.str().c_str());
         }
     }
+    
+    // Overwrites seeding, the checkpoint has the whole population
+    if(resume)
+    {
+        ifstream test(checkpointPath.c_str());
+        if (test.is_open())
+        {
+            test.close();
+            readCheckpoint();
+        }
+        else
+        {
+            resume = false;
+            cout << "No checkpoint at " << checkpointPath << ", starting a new run" << endl;
+        }
+    }
+    
     if(learning)
     {
-        evolutionLog.open((resourcePath + "logs/evolution" + suffix + ".csv").c_str(),ios::out);
+        // Keep the history from before the checkpoint
+        evolutionLog.open(evolutionLogPath().c_str(),
+                            resume ? ios::app : ios::out);
         if (!evolutionLog.is_open())
         {
 			throw std::runtime_error("Logs does not exist. Please create a logs folder in your build directory or update your cmake file");
@@ -124,13 +170,14 @@ AnnealEvolution::~AnnealEvolution()
     }
     populations.clear();
     #endif
+    delete fitnessCache;
 }
 
 void AnnealEvolution::mutateEveryController()
 {
     for(std::size_t i=0;i<populations.size();i++)
     {
-        populations.at(i)->mutate(&eng,numberOfElementsToMutate, Temp);
+        populations.at(i)->mutate(seed, generationNumber, numberOfElementsToMutate, Temp);
     }
 }
 
@@ -165,13 +212,21 @@ void AnnealEvolution::orderAllPopulations()
     // what if member at 0 isn't the best of all time for some reason? 
     // This seems biased towards average scores
     // We actually order the populations, so member 0 is the current best according to the assigned fitness
-    ofstream logfileLeader;
+    // Only rewrite the file when the leader changed
+    savedBestParameters.resize(populations.size());
     for(std::size_t i=0;i<populations.size();i++)
     {
+        AnnealEvoMember* leader = populations[i]->getMember(0);
+        if (leader->statelessParameters == savedBestParameters[i])
+        {
+            continue;
+        }
+        
         stringstream ss;
         ss << resourcePath << "logs/bestParameters-" << suffix << "-" << i << ".nnw";
 
-        populations[i]->getMember(0)->saveToFile(ss.str().c_str());
+        leader->saveToFile(ss.str().c_str());
+        savedBestParameters[i] = leader->statelessParameters;
     }
 }
 
@@ -186,11 +241,9 @@ double diffclock(clock_t clock1,clock_t clock2)
 
 vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
 {
-    int testsToDo=0;
-    if(coevolution)
-        testsToDo=numberOfTestsBetweenGenerations; //stop when we reach x amount of random tests
-    else
-        testsToDo=populationSize; //stop when we test each element once
+    // Coevolution stops when we reach x amount of random tests,
+    // otherwise stop when we test each element once
+    int testsToDo=testsPerGeneration();
 
     if(currentTest == testsToDo)
     {
@@ -204,14 +257,24 @@ vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
             currentTest=0;//Start from 0
         else
             currentTest=populationSize-numberOfElementsToMutate; //start from the mutated ones only (last x)
+        
+        if (checkpointInterval > 0 && generationNumber % checkpointInterval == 0)
+        {
+            writeCheckpoint();
+        }
     }
 
+    episodeGeneration = generationNumber;
+    episodeTest = currentTest;
+    episodeSubtest = subTests;
+    tgRandomStream selection(seed, generationNumber, currentTest, subTests, selectionDomain);
+
     selectedControllers.clear();
     for(std::size_t i=0;i<populations.size();i++)
     {
         int selectedOne=0;
         if(coevolution)
-            selectedOne=rand()%populationSize; //select random one from each pool
+            selectedOne=selection.index(populationSize); //select random one from each pool
         else
             selectedOne=currentTest; //select the same from each pool
 
@@ -231,8 +294,81 @@ vector <AnnealEvoMember *> AnnealEvolution::nextSetOfControllers()
     return selectedControllers;
 }
 
+vector< vector <AnnealEvoMember *> > AnnealEvolution::nextBatchOfControllers()
+{
+    vector< vector <AnnealEvoMember *> > batch;
+    // The first call moves on to the next generation if the last one is done
+    do
+    {
+        batch.push_back(nextSetOfControllers());
+    } while (currentTest != testsPerGeneration());
+    
+    return batch;
+}
+
+tgRandomStream AnnealEvolution::episodeStream(unsigned int domain) const
+{
+    return tgRandomStream(seed, episodeGeneration, episodeTest, episodeSubtest,
+                          firstEpisodeDomain + domain);
+}
+
+int AnnealEvolution::testsPerGeneration() const
+{
+    if(coevolution)
+        return numberOfTestsBetweenGenerations;
+    else
+        return populationSize;
+}
+
+FitnessCache::Parameters AnnealEvolution::selectionParameters(const vector <AnnealEvoMember *>& controllers) const
+{
+    FitnessCache::Parameters params;
+    for (std::size_t i = 0; i < controllers.size(); i++)
+    {
+        params.push_back(controllers[i]->statelessParameters);
+    }
+    return params;
+}
+
+bool AnnealEvolution::updateScoresFromCache()
+{
+    return updateScoresFromCache(selectedControllers);
+}
+
+bool AnnealEvolution::updateScoresFromCache(const vector <AnnealEvoMember *>& controllers)
+{
+    if (fitnessCache == NULL)
+    {
+        return false;
+    }
+    
+    std::vector<double> cachedScores;
+    if (!fitnessCache->lookup(selectionParameters(controllers), scenarioSeed,
+                              cachedScores))
+    {
+        return false;
+    }
+    
+    updateScores(controllers, cachedScores);
+    return true;
+}
+
 void AnnealEvolution::updateScores(vector <double> multiscore)
 {
+    updateScores(selectedControllers, multiscore);
+}
+
+void AnnealEvolution::updateScores(const vector <AnnealEvoMember *>& controllers, vector <double> multiscore)
+{
+    // Key on the parameters as they were run, before any scores are
+    // modified. Exploded episodes report fewer than two scores, they
+    // aren't cached so the parameters are simulated again next time.
+    if (fitnessCache != NULL && multiscore.size() == 2)
+    {
+        fitnessCache->insert(selectionParameters(controllers), scenarioSeed,
+                             multiscore);
+    }
+    
     if(multiscore.size()==2)
         this->scoresOfTheGeneration.push_back(multiscore);
     else
@@ -240,13 +376,15 @@ void AnnealEvolution::updateScores(vector <double> multiscore)
     double score=1.0* multiscore[0] - 0.0 * multiscore[1];
     
     //Record it to the file
-    ofstream payloadLog;
-    payloadLog.open((resourcePath + "logs/scores.csv").c_str(),ios::app);
-    payloadLog<<multiscore[0]<<","<<multiscore[1];
+    if (!scoresLog.is_open())
+    {
+        scoresLog.open(scoresLogPath().c_str(),ios::app);
+    }
+    scoresLog<<multiscore[0]<<","<<multiscore[1];
     
-    for(std::size_t oneElem=0;oneElem<selectedControllers.size();oneElem++)
+    for(std::size_t oneElem=0;oneElem<controllers.size();oneElem++)
     {
-        AnnealEvoMember * controllerPointer=selectedControllers.at(oneElem);
+        AnnealEvoMember * controllerPointer=controllers.at(oneElem);
 
         controllerPointer->pastScores.push_back(score);
         double prevScore=controllerPointer->maxScore;
@@ -264,11 +402,146 @@ void AnnealEvolution::updateScores(vector <double> multiscore)
         std::size_t n = controllerPointer->statelessParameters.size();
         for (std::size_t i = 0; i < n; i++)
         {
-            payloadLog << "," << controllerPointer->statelessParameters[i];
+            scoresLog << "," << controllerPointer->statelessParameters[i];
         }
     }
 
-    payloadLog<<endl;
-    payloadLog.close();
+    // The line is buffered until here, so this is one write per episode.
+    // Tests read the last score while the run is still going, so flush.
+    scoresLog<<endl;
     return;
 }
+
+namespace
+{
+    const std::string checkpointMagic("NTRTANNEAL3");
+
+    /** @return the size of path in bytes, 0 if it doesn't exist */
+    std::size_t fileSize(const std::string& path)
+    {
+        ifstream file(path.c_str(), ios::in | ios::binary | ios::ate);
+        return file.is_open() ? static_cast<std::size_t>(file.tellg()) : 0;
+    }
+
+    /** Drop whatever was logged after a checkpoint was written */
+    void truncateLog(const std::string& path, std::size_t size)
+    {
+        if (fileSize(path) > size && truncate(path.c_str(), size) != 0)
+        {
+            throw std::runtime_error("Could not truncate " + path);
+        }
+    }
+}
+
+std::string AnnealEvolution::scoresLogPath() const
+{
+    return resourcePath + "logs/scores.csv";
+}
+
+std::string AnnealEvolution::evolutionLogPath() const
+{
+    return resourcePath + "logs/evolution" + suffix + ".csv";
+}
+
+void AnnealEvolution::writeCheckpoint()
+{
+    // Write to a temporary file so a crash mid-write leaves the last
+    // checkpoint intact
+    const std::string tmpPath = checkpointPath + ".tmp";
+    ofstream out(tmpPath.c_str(), ios::out | ios::binary | ios::trunc);
+    if (!out.is_open())
+    {
+        throw std::runtime_error("Could not open " + tmpPath);
+    }
+    
+    // Logs should be at least as recent as the checkpoint, and whatever
+    // is logged after it is cut off again on resume
+    evolutionLog.flush();
+    scoresLog.flush();
+    const std::size_t evolutionLogSize = fileSize(evolutionLogPath());
+    const std::size_t scoresLogSize = fileSize(scoresLogPath());
+    
+    CheckpointIO::write(out, checkpointMagic);
+    CheckpointIO::write(out, evolutionLogSize);
+    CheckpointIO::write(out, scoresLogSize);
+    CheckpointIO::write(out, generationNumber);
+    CheckpointIO::write(out, currentTest);
+    CheckpointIO::write(out, subTests);
+    CheckpointIO::write(out, Temp);
+    // The streams only depend on the seed and the counters
+    CheckpointIO::write(out, seed);
+    
+    const std::size_t numScores = scoresOfTheGeneration.size();
+    CheckpointIO::write(out, numScores);
+    for (std::size_t i = 0; i < numScores; i++)
+    {
+        CheckpointIO::write(out, scoresOfTheGeneration[i]);
+    }
+    
+    const std::size_t numPopulations = populations.size();
+    CheckpointIO::write(out, numPopulations);
+    for (std::size_t i = 0; i < numPopulations; i++)
+    {
+        populations[i]->writeCheckpoint(out);
+    }
+    
+    out.close();
+    if (out.fail() || rename(tmpPath.c_str(), checkpointPath.c_str()) != 0)
+    {
+        throw std::runtime_error("Could not write checkpoint " + checkpointPath);
+    }
+}
+
+void AnnealEvolution::readCheckpoint()
+{
+    ifstream in(checkpointPath.c_str(), ios::in | ios::binary);
+    if (!in.is_open())
+    {
+        throw std::runtime_error("Could not open checkpoint " + checkpointPath);
+    }
+    
+    std::string magic;
+    CheckpointIO::read(in, magic, checkpointMagic.size());
+    if (magic != checkpointMagic)
+    {
+        throw std::runtime_error(checkpointPath + " is not an AnnealEvolution checkpoint");
+    }
+    
+    std::size_t evolutionLogSize;
+    std::size_t scoresLogSize;
+    CheckpointIO::read(in, evolutionLogSize);
+    CheckpointIO::read(in, scoresLogSize);
+    CheckpointIO::read(in, generationNumber);
+    CheckpointIO::read(in, currentTest);
+    CheckpointIO::read(in, subTests);
+    CheckpointIO::read(in, Temp);
+    CheckpointIO::read(in, seed);
+    
+    // At most one score per episode of a generation, of two values each
+    const std::size_t numScores =
+        CheckpointIO::readSize(in, testsPerGeneration() * numberOfSubtests,
+                               sizeof(std::size_t));
+    scoresOfTheGeneration.resize(numScores);
+    for (std::size_t i = 0; i < numScores; i++)
+    {
+        CheckpointIO::read(in, scoresOfTheGeneration[i], 2);
+    }
+    
+    const std::size_t numPopulations =
+        CheckpointIO::readSize(in, populations.size(), 1);
+    if (numPopulations != populations.size())
+    {
+        throw std::runtime_error("Checkpoint does not match numberOfControllers");
+    }
+    for (std::size_t i = 0; i < numPopulations; i++)
+    {
+        populations[i]->readCheckpoint(in);
+    }
+    
+    // The episodes after the checkpoint are run and logged again
+    truncateLog(evolutionLogPath(), evolutionLogSize);
+    truncateLog(scoresLogPath(), scoresLogSize);
+    
+    cout << "Resuming from generation " << generationNumber
+         << " with random seed " << seed << endl;
+}
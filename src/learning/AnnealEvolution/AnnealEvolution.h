@@ -30,6 +30,8 @@
 
 #include "AnnealEvoPopulation.h"
 #include "AnnealEvoMember.h"
+#include "learning/Configuration/EvolutionConfig.h"
+#include "learning/FitnessCache/FitnessCache.h"
 #include <fstream>
 #include <boost/iterator/iterator_concepts.hpp>
 
@@ -43,14 +45,72 @@ public:
     void evaluatePopulation();
     std::vector< AnnealEvoMember *> nextSetOfControllers();
     void updateScores(std::vector<double> scores);
+    /**
+     * Every set of controllers that remains to be tested this generation.
+     * Can be evaluated in any order (i.e. in parallel), but all of them
+     * must be scored with the overload of updateScores that takes the
+     * controllers before the next call, since moving on to the next
+     * generation mutates the members in place.
+     */
+    std::vector< std::vector< AnnealEvoMember *> > nextBatchOfControllers();
+    /// Score a set of controllers from nextBatchOfControllers
+    void updateScores(const std::vector< AnnealEvoMember *>& controllers,
+                      std::vector<double> scores);
+    /**
+     * If useFitnessCache is on and the current set of controllers has
+     * been scored before (in this run or a previous one), record the
+     * stored scores as if the episode had been simulated.
+     * @return true if the scores came from the cache, in which case
+     * the caller can skip the simulation for this set of controllers
+     */
+    bool updateScoresFromCache();
+    bool updateScoresFromCache(const std::vector< AnnealEvoMember *>& controllers);
+    /**
+     * Part of the fitness cache key. Change this if the scenario (terrain,
+     * initial conditions) is randomized between episodes
+     */
+    void setScenarioSeed(unsigned long seed)
+    {
+        scenarioSeed = seed;
+    }
+    const EvolutionConfig& getConfig() const
+    {
+        return evoConfig;
+    }
+    /// randomSeed from the config file, or the one drawn for this run
+    unsigned int getSeed() const
+    {
+        return seed;
+    }
+    /**
+     * A stream of its own for the episode of the last call to
+     * nextSetOfControllers, for randomizing the terrain or adding noise.
+     * The same in every run with the same seed, however the episodes
+     * are scheduled.
+     * @param[in] domain to draw several independent streams per episode
+     */
+    tgRandomStream episodeStream(unsigned int domain = 0) const;
     const std::string suffix;
     /// @todo make this const if we decide to force everyone to put their logs in resources
     std::string resourcePath;
     
 private:
+    FitnessCache::Parameters selectionParameters(const std::vector< AnnealEvoMember *>& controllers) const;
+    int testsPerGeneration() const;
+    std::string scoresLogPath() const;
+    std::string evolutionLogPath() const;
+    /**
+     * Save everything needed to continue the run: populations, scores,
+     * the random seed, the test counters and the lengths of the logs,
+     * which are cut back to those lengths on resume
+     */
+    void writeCheckpoint();
+    void readCheckpoint();
+
+    /// Shared with every other user of the same file, see EvolutionConfig::load
+    const EvolutionConfig& evoConfig;
     int populationSize;
     int numberOfControllers;
-    std::tr1::ranlux64_base_01 eng;
     std::vector< AnnealEvoPopulation *> populations;
     std::vector <AnnealEvoMember *>  selectedControllers;
     std::vector< std::vector< double > > scoresOfTheGeneration;
@@ -62,12 +122,28 @@ private:
     double Temp;
     bool coevolution;
     std::ofstream evolutionLog;
+    /// Held open for the life of the run, see updateScores
+    std::ofstream scoresLog;
     int currentTest;
     int numberOfTestsBetweenGenerations;
     int generationNumber;
     int numberOfElementsToMutate;
     int numberOfSubtests;
     int subTests;
+    /// NULL unless useFitnessCache is set in the config file
+    FitnessCache* fitnessCache;
+    unsigned long scenarioSeed;
+    /// Generations between checkpoints, 0 is off
+    int checkpointInterval;
+    std::string checkpointPath;
+    /// Every random number of the run is drawn from a tgRandomStream of this
+    unsigned int seed;
+    /// The generation, test and subtest of the last nextSetOfControllers
+    int episodeGeneration;
+    int episodeTest;
+    int episodeSubtest;
+    /// What was last written to each bestParameters file
+    std::vector< std::vector<double> > savedBestParameters;
 };
 
 #endif /* ANNEALEVOLUTION_H_ */
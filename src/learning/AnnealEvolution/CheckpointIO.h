@@ -0,0 +1,151 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef CHECKPOINT_IO_H_
+#define CHECKPOINT_IO_H_
+
+/**
+ * @file CheckpointIO.h
+ * @brief Helpers to read and write the binary evolution checkpoints
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Raw binary reads and writes. Checkpoints are only meant to be read
+ * back on the machine (and build) that wrote them, so no attempt is
+ * made to handle endianness or type sizes.
+ *
+ * Every size read from the file is checked before anything is
+ * allocated for it, against the caller's limit and against the bytes
+ * left in the file, so a corrupt checkpoint throws rather than
+ * allocating whatever its size field happens to hold.
+ */
+namespace CheckpointIO
+{
+    /** Larger than any size a checkpoint should hold */
+    const std::size_t noLimit = static_cast<std::size_t>(-1);
+
+    template <typename T>
+    inline void write(std::ostream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    inline void read(std::istream& in, T& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        if (!in)
+        {
+            throw std::runtime_error("Checkpoint file is truncated");
+        }
+    }
+
+    /** @return the number of bytes from the read position to the end */
+    inline std::size_t remaining(std::istream& in)
+    {
+        const std::streampos here = in.tellg();
+        in.seekg(0, std::ios::end);
+        const std::streampos end = in.tellg();
+        in.seekg(here);
+        if (here < 0 || end < here)
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(end - here);
+    }
+
+    /**
+     * Read the number of elements of a container that follows.
+     * @param[in] maxSize the most that the caller expects
+     * @param[in] elementSize the bytes of each element in the file
+     */
+    inline std::size_t readSize(std::istream& in,
+                                std::size_t maxSize,
+                                std::size_t elementSize)
+    {
+        std::size_t n;
+        read(in, n);
+        if (n > maxSize || n > remaining(in) / elementSize)
+        {
+            throw std::runtime_error("Checkpoint file is corrupt");
+        }
+        return n;
+    }
+
+    inline void write(std::ostream& out, const std::vector<double>& values)
+    {
+        const std::size_t n = values.size();
+        write(out, n);
+        if (n > 0)
+        {
+            out.write(reinterpret_cast<const char*>(&values[0]),
+                      n * sizeof(double));
+        }
+    }
+
+    inline void read(std::istream& in,
+                     std::vector<double>& values,
+                     std::size_t maxSize = noLimit)
+    {
+        const std::size_t n = readSize(in, maxSize, sizeof(double));
+        values.resize(n);
+        if (n > 0)
+        {
+            in.read(reinterpret_cast<char*>(&values[0]), n * sizeof(double));
+            if (!in)
+            {
+                throw std::runtime_error("Checkpoint file is truncated");
+            }
+        }
+    }
+
+    inline void write(std::ostream& out, const std::string& value)
+    {
+        const std::size_t n = value.size();
+        write(out, n);
+        out.write(value.data(), n);
+    }
+
+    inline void read(std::istream& in,
+                     std::string& value,
+                     std::size_t maxSize = noLimit)
+    {
+        const std::size_t n = readSize(in, maxSize, 1);
+        value.resize(n);
+        if (n > 0)
+        {
+            in.read(&value[0], n);
+            if (!in)
+            {
+                throw std::runtime_error("Checkpoint file is truncated");
+            }
+        }
+    }
+}
+
+#endif /* CHECKPOINT_IO_H_ */
@@ -0,0 +1,160 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file EvolutionConfig.cpp
+ * @brief Contains the implementation of class EvolutionConfig
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "EvolutionConfig.h"
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+    template <typename T>
+    T readValue(const configuration& data,
+                const std::string& key,
+                bool required,
+                std::string& problems)
+    {
+        std::map<std::string, std::string>::const_iterator it = data.data.find(key);
+        if (it == data.data.end())
+        {
+            if (required)
+            {
+                problems += "\n  missing key " + key;
+            }
+            return T();
+        }
+
+        std::istringstream ss(it->second);
+        T result;
+        ss >> result;
+        if (ss.fail() || !ss.eof())
+        {
+            problems += "\n  " + key + " = " + it->second + " is not a number of the right type";
+            return T();
+        }
+        return result;
+    }
+
+    int readInt(const configuration& data, const std::string& key,
+                bool required, std::string& problems)
+    {
+        return readValue<int>(data, key, required, problems);
+    }
+
+    double readDouble(const configuration& data, const std::string& key,
+                      bool required, std::string& problems)
+    {
+        return readValue<double>(data, key, required, problems);
+    }
+
+    void check(bool condition, const std::string& message, std::string& problems)
+    {
+        if (!condition)
+        {
+            problems += "\n  " + message;
+        }
+    }
+}
+
+EvolutionConfig::EvolutionConfig(const configuration& config,
+                                 Algorithm algorithm,
+                                 const std::string& source) :
+m_problems(),
+learning(readInt(config, "learning", true, m_problems)),
+startSeed(readInt(config, "startSeed", true, m_problems)),
+numberOfActions(readInt(config, "numberOfActions", true, m_problems)),
+numberOfStates(readInt(config, "numberOfStates", true, m_problems)),
+numberOfControllers(readInt(config, "numberOfControllers", true, m_problems)),
+coevolution(readInt(config, "coevolution", true, m_problems)),
+populationSize(readInt(config, "populationSize", true, m_problems)),
+numberOfElementsToMutate(readInt(config, "numberOfElementsToMutate", true, m_problems)),
+numberOfTestsBetweenGenerations(readInt(config, "numberOfTestsBetweenGenerations", true, m_problems)),
+numberOfSubtests(readInt(config, "numberOfSubtests", true, m_problems)),
+leniencyCoef(readDouble(config, "leniencyCoef", true, m_problems)),
+compareAverageScores(readInt(config, "compareAverageScores", true, m_problems)),
+clearScoresBetweenGenerations(readInt(config, "clearScoresBetweenGenerations", true, m_problems)),
+monteCarlo(readInt(config, "MonteCarlo", algorithm == annealEvolution, m_problems)),
+deviation(readDouble(config, "deviation", algorithm == annealEvolution, m_problems)),
+numberHidden(readInt(config, "numberHidden", algorithm == neuroEvolution, m_problems)),
+numberOfChildren(readInt(config, "numberOfChildren", algorithm == neuroEvolution, m_problems)),
+useFitnessCache(readInt(config, "useFitnessCache", false, m_problems)),
+scenarioSeed(readValue<unsigned long>(config, "scenarioSeed", false, m_problems)),
+checkpointInterval(readInt(config, "checkpointInterval", false, m_problems)),
+resumeFromCheckpoint(readInt(config, "resumeFromCheckpoint", false, m_problems)),
+randomSeed(readValue<unsigned long>(config, "randomSeed", false, m_problems)),
+data(config)
+{
+    check(numberOfActions > 0, "numberOfActions must be positive", m_problems);
+    check(numberOfStates >= 0, "numberOfStates is negative", m_problems);
+    check(numberOfControllers > 0, "numberOfControllers must be positive", m_problems);
+    check(populationSize > 0, "populationSize must be positive", m_problems);
+    check(numberOfElementsToMutate >= 0 &&
+            numberOfElementsToMutate <= populationSize,
+          "numberOfElementsToMutate must be between 0 and populationSize", m_problems);
+    check(!coevolution || numberOfTestsBetweenGenerations > 0,
+          "numberOfTestsBetweenGenerations must be positive with coevolution", m_problems);
+    // Replaying the best parameters never runs a subtest, and some
+    // replay configs say 0
+    check(!learning || numberOfSubtests > 0,
+          "numberOfSubtests must be positive when learning", m_problems);
+    check(leniencyCoef >= 0.0 && leniencyCoef <= 1.0,
+          "leniencyCoef must be between 0.0 and 1.0", m_problems);
+    check(deviation >= 0.0, "deviation is negative", m_problems);
+    check(numberHidden >= 0, "numberHidden is negative", m_problems);
+    check(numberOfChildren >= 0, "numberOfChildren is negative", m_problems);
+    check(numberOfElementsToMutate + numberOfChildren <= populationSize,
+          "Population will grow with given parameters", m_problems);
+    check(checkpointInterval >= 0, "checkpointInterval is negative", m_problems);
+    check(randomSeed <= 4294967295ul, "randomSeed does not fit in 32 bits", m_problems);
+
+    if (!m_problems.empty())
+    {
+        throw std::invalid_argument("Bad learning configuration " + source + ":" + m_problems);
+    }
+}
+
+const EvolutionConfig& EvolutionConfig::load(const std::string& filename,
+                                             Algorithm algorithm)
+{
+    typedef std::map<std::pair<std::string, int>, const EvolutionConfig*> ConfigMap;
+    static ConfigMap loaded;
+
+    const std::pair<std::string, int> key(filename, algorithm);
+    ConfigMap::const_iterator it = loaded.find(key);
+    if (it != loaded.end())
+    {
+        return *(it->second);
+    }
+
+    configuration config;
+    config.readFile(filename);
+    const EvolutionConfig* result = new EvolutionConfig(config, algorithm, filename);
+    loaded[key] = result;
+    return *result;
+}
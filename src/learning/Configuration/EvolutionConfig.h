@@ -0,0 +1,125 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef EVOLUTION_CONFIG_H_
+#define EVOLUTION_CONFIG_H_
+
+/**
+ * @file EvolutionConfig.h
+ * @brief Contains the definition of class EvolutionConfig, the typed
+ * form of a learning .ini file
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "configuration.h"
+#include <string>
+
+/**
+ * The parameters of an AnnealEvolution or NeuroEvolution run, read
+ * from a .ini file once and checked when they are loaded. See
+ * \ref config_full for what each parameter does.
+ *
+ * Use load() to get a shared, immutable copy so the file is only
+ * read and parsed the first time each path is used in a process
+ * (and in any worker forked after that). load() is single threaded,
+ * the objects it returns can be read from any thread.
+ */
+class EvolutionConfig
+{
+private:
+
+    /// Declared first so it can collect problems while the rest are initialized
+    std::string m_problems;
+
+public:
+
+    /** Determines which keys are required */
+    enum Algorithm
+    {
+        annealEvolution,
+        neuroEvolution
+    };
+
+    /**
+     * Check and convert all values.
+     * @throw std::invalid_argument listing every missing, malformed or
+     * out of range key
+     * @param[in] data the key value pairs from the file
+     * @param[in] algorithm which evolution the file is for
+     * @param[in] source where data came from, for error messages
+     */
+    EvolutionConfig(const configuration& data,
+                    Algorithm algorithm,
+                    const std::string& source = "");
+
+    /**
+     * Parse filename the first time it is requested, afterwards return
+     * the same object. Never freed.
+     *
+     * Not thread safe: the cache of loaded files isn't locked, so only
+     * call this from the thread that runs the evolution. Processes
+     * forked after a load, such as the workers of an EvaluationFarm,
+     * each have a copy of the cache of their own, which is safe.
+     */
+    static const EvolutionConfig& load(const std::string& filename,
+                                       Algorithm algorithm);
+
+    // Startup Parameters
+    const bool learning;
+    const bool startSeed;
+
+    // Controller Parameters
+    const int numberOfActions;
+    const int numberOfStates;
+    const int numberOfControllers;
+
+    // Learning Parameters
+    const bool coevolution;
+    const int populationSize;
+    const int numberOfElementsToMutate;
+    const int numberOfTestsBetweenGenerations;
+    const int numberOfSubtests;
+    const double leniencyCoef;
+    const bool compareAverageScores;
+    const bool clearScoresBetweenGenerations;
+
+    // AnnealEvolution only, 0 for NeuroEvolution
+    const bool monteCarlo;
+    const double deviation;
+
+    // NeuroEvolution only, 0 for AnnealEvolution
+    const int numberHidden;
+    const int numberOfChildren;
+
+    // Optional for both, default to 0
+    const bool useFitnessCache;
+    const unsigned long scenarioSeed;
+    const int checkpointInterval;
+    const bool resumeFromCheckpoint;
+    const unsigned long randomSeed;
+
+    /**
+     * All of the key value pairs, for application specific keys that
+     * are kept in the same file
+     */
+    const configuration data;
+};
+
+#endif /* EVOLUTION_CONFIG_H_ */
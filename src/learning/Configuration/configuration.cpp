@@ -35,13 +35,13 @@ using namespace std;
 configuration::configuration(){}
 configuration::~configuration(){}
 
-int configuration::getintvalue( const std::string& key )
+int configuration::getintvalue( const std::string& key ) const
 {
 	if (!iskey( key )){
 		std::cout<<"Cannot find the key in the config file, Key: "<<key<<endl;
 		throw 0;
 	}
-	std::istringstream ss( this->data.operator [] ( key ) );
+	std::istringstream ss( this->data.find( key )->second );
 	int result;
 	ss >> result;
 	if (!ss.eof())
@@ -54,20 +54,20 @@ int configuration::getintvalue( const std::string& key )
 }
 
 
-double configuration::getDoubleValue(const std::string& key )
+double configuration::getDoubleValue(const std::string& key ) const
 {
 	if (!iskey( key )) throw 0;
-	std::istringstream ss( this->data.operator [] ( key ) );
+	std::istringstream ss( this->data.find( key )->second );
 	double result;
 	ss >> result;
 	if (!ss.eof()) throw 1;
 	return result;
 }
 
-std::string configuration::getStringValue(const std::string& key )
+std::string configuration::getStringValue(const std::string& key ) const
 {
 	if (!iskey( key )) throw 0;
-	std::istringstream ss( this->data.operator [] ( key ) );
+	std::istringstream ss( this->data.find( key )->second );
 	string result;
 	ss >> result;
 	if (!ss.eof()) throw 1;
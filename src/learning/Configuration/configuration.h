@@ -62,9 +62,9 @@ public:
     // Gets an integer value from a key. If the key does not exist, or if the value
     // is not an integer, throws an int exception.
     //
-    int getintvalue( const std::string& key );
-    double getDoubleValue(const std::string& key );
-	std::string getStringValue(const std::string& key );
+    int getintvalue( const std::string& key ) const;
+    double getDoubleValue(const std::string& key ) const;
+	std::string getStringValue(const std::string& key ) const;
     void readFile(const std::string filename);
     void writeToFile(const std::string filename);
 };
@@ -0,0 +1,358 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file EvaluationFarm.cpp
+ * @brief Contains the implementation of class EvaluationFarm
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "EvaluationFarm.h"
+#include "ProcessIO.h"
+// POSIX
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// The C++ Standard Library
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    bool writeJob(int socket, const std::vector< std::vector<double> >& job)
+    {
+        const std::size_t n = job.size();
+        if (!ProcessIO::writeAll(socket, &n, sizeof(n)))
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (!ProcessIO::writeVector(socket, job[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readJob(int socket, std::vector< std::vector<double> >& job)
+    {
+        // One vector of parameters per controller
+        std::size_t n;
+        if (!ProcessIO::readSize(socket, n, ProcessIO::maxVectorSize))
+        {
+            return false;
+        }
+        job.resize(n);
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (!ProcessIO::readVector(socket, job[i], ProcessIO::maxVectorSize))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+EvaluationFarm::EvaluationFarm(Worker& worker, std::size_t numWorkers,
+                               double timeoutSeconds) :
+m_worker(worker),
+m_timeout(timeoutSeconds),
+m_respawns(0)
+{
+    if (timeoutSeconds < 0.0)
+    {
+        throw std::invalid_argument("Timeout is negative");
+    }
+
+    if (numWorkers == 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        numWorkers = (cores > 0) ? cores : 1;
+    }
+
+    m_workers.resize(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; i++)
+    {
+        m_workers[i].pid = -1;
+        m_workers[i].socket = -1;
+        m_workers[i].job = -1;
+        m_workers[i].startTime = 0.0;
+    }
+    for (std::size_t i = 0; i < numWorkers; i++)
+    {
+        spawn(m_workers[i]);
+    }
+}
+
+EvaluationFarm::~EvaluationFarm()
+{
+    // Workers exit when they see the socket close
+    for (std::size_t i = 0; i < m_workers.size(); i++)
+    {
+        if (m_workers[i].socket >= 0)
+        {
+            close(m_workers[i].socket);
+        }
+    }
+    for (std::size_t i = 0; i < m_workers.size(); i++)
+    {
+        if (m_workers[i].pid > 0)
+        {
+            int status;
+            waitpid(m_workers[i].pid, &status, 0);
+        }
+    }
+}
+
+void EvaluationFarm::spawn(WorkerProcess& process)
+{
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+    {
+        throw std::runtime_error("Could not create worker socket");
+    }
+
+    // Otherwise anything buffered gets printed by the child too
+    cout.flush();
+    cerr.flush();
+    fflush(NULL);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+        throw std::runtime_error("Could not fork worker process");
+    }
+    else if (pid == 0)
+    {
+        // Only keep our own end of our own socket, so the other workers
+        // see end of file when the coordinator closes theirs
+        close(sockets[0]);
+        for (std::size_t i = 0; i < m_workers.size(); i++)
+        {
+            if (m_workers[i].socket >= 0)
+            {
+                close(m_workers[i].socket);
+            }
+        }
+        workerLoop(sockets[1]);
+    }
+
+    close(sockets[1]);
+    process.pid = pid;
+    process.socket = sockets[0];
+    process.job = -1;
+    process.startTime = 0.0;
+}
+
+void EvaluationFarm::respawn(WorkerProcess& process)
+{
+    kill(process.pid, SIGKILL);
+    close(process.socket);
+    int status;
+    waitpid(process.pid, &status, 0);
+
+    process.pid = -1;
+    process.socket = -1;
+    m_respawns++;
+
+    spawn(process);
+}
+
+void EvaluationFarm::workerLoop(int socket)
+{
+    int exitCode = 0;
+    try
+    {
+        m_worker.setup();
+
+        std::vector< std::vector<double> > job;
+        while (readJob(socket, job))
+        {
+            int status = completed;
+            std::vector<double> scores;
+            try
+            {
+                scores = m_worker.evaluate(job);
+            }
+            catch (std::exception& e)
+            {
+                cerr << "Worker " << getpid() << " episode failed: " << e.what() << endl;
+                status = failed;
+                scores.clear();
+            }
+
+            if (!ProcessIO::writeAll(socket, &status, sizeof(status)) ||
+                !ProcessIO::writeVector(socket, scores))
+            {
+                exitCode = 1;
+                break;
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        cerr << "Worker " << getpid() << " setup failed: " << e.what() << endl;
+        exitCode = 1;
+    }
+
+    close(socket);
+    cout.flush();
+    cerr.flush();
+    // Don't run the coordinator's destructors or atexit handlers
+    _exit(exitCode);
+}
+
+const char* EvaluationFarm::statusName(Status status)
+{
+    switch (status)
+    {
+        case completed:
+            return "completed";
+        case failed:
+            return "failed";
+        case crashed:
+            return "crashed";
+        case timedOut:
+            return "timed out";
+        default:
+            return "unknown";
+    }
+}
+
+std::vector<EvaluationFarm::Result>
+EvaluationFarm::evaluate(const std::vector< std::vector< std::vector<double> > >& jobs)
+{
+    std::vector<Result> results(jobs.size());
+    std::size_t nextJob = 0;
+    std::size_t finished = 0;
+
+    std::vector<pollfd> fds(m_workers.size());
+    // Which worker each entry of fds belongs to
+    std::vector<std::size_t> busy(m_workers.size());
+
+    while (finished < jobs.size())
+    {
+        // Hand out work to anyone idle
+        for (std::size_t i = 0; i < m_workers.size() && nextJob < jobs.size(); i++)
+        {
+            WorkerProcess& worker = m_workers[i];
+            if (worker.job >= 0)
+            {
+                continue;
+            }
+
+            if (!writeJob(worker.socket, jobs[nextJob]))
+            {
+                // Died while idle, the job hasn't started so try again
+                cerr << "Worker " << worker.pid << " is gone, respawning" << endl;
+                respawn(worker);
+                if (!writeJob(worker.socket, jobs[nextJob]))
+                {
+                    throw std::runtime_error("Could not send a job to a new worker");
+                }
+            }
+            worker.job = nextJob;
+            worker.startTime = ProcessIO::now();
+            nextJob++;
+        }
+
+        int timeout = -1;
+        std::size_t numBusy = 0;
+        const double currentTime = ProcessIO::now();
+        for (std::size_t i = 0; i < m_workers.size(); i++)
+        {
+            if (m_workers[i].job < 0)
+            {
+                continue;
+            }
+            fds[numBusy].fd = m_workers[i].socket;
+            fds[numBusy].events = POLLIN;
+            fds[numBusy].revents = 0;
+            busy[numBusy] = i;
+            numBusy++;
+
+            if (m_timeout > 0.0)
+            {
+                double remaining = m_workers[i].startTime + m_timeout - currentTime;
+                int ms = (remaining > 0.0) ? (int) (remaining * 1000.0) + 1 : 0;
+                if (timeout < 0 || ms < timeout)
+                {
+                    timeout = ms;
+                }
+            }
+        }
+
+        int ready = poll(&fds[0], numBusy, timeout);
+        if (ready < 0 && errno != EINTR)
+        {
+            throw std::runtime_error("poll failed while waiting for workers");
+        }
+
+        const double pollTime = ProcessIO::now();
+        for (std::size_t j = 0; j < numBusy; j++)
+        {
+            WorkerProcess& worker = m_workers[busy[j]];
+
+            if (ready > 0 && fds[j].revents != 0)
+            {
+                Result& result = results[worker.job];
+                int status;
+                if (!ProcessIO::readAll(worker.socket, &status, sizeof(status)) ||
+                    (status != completed && status != failed) ||
+                    !ProcessIO::readVector(worker.socket, result.scores,
+                                           ProcessIO::maxVectorSize))
+                {
+                    cerr << "Worker " << worker.pid << " crashed during an episode, respawning" << endl;
+                    result.status = crashed;
+                    result.scores.clear();
+                    respawn(worker);
+                }
+                else
+                {
+                    result.status = static_cast<Status>(status);
+                }
+                worker.job = -1;
+                finished++;
+            }
+            else if (m_timeout > 0.0 && pollTime - worker.startTime > m_timeout)
+            {
+                cerr << "Worker " << worker.pid << " timed out, respawning" << endl;
+                results[worker.job].status = timedOut;
+                results[worker.job].scores.clear();
+                respawn(worker);
+                worker.job = -1;
+                finished++;
+            }
+        }
+    }
+
+    return results;
+}
@@ -0,0 +1,166 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef EVALUATION_FARM_H_
+#define EVALUATION_FARM_H_
+
+/**
+ * @file EvaluationFarm.h
+ * @brief Contains the definition of class EvaluationFarm
+ * Runs learning episodes in separate worker processes
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include <sys/types.h>
+#include <vector>
+
+/**
+ * Evaluates sets of learned parameters in a pool of forked worker
+ * processes, talking to each over a Unix domain socket. Every worker
+ * builds its own world, so models that use global state (or crash
+ * Bullet) can't affect each other or the process running the evolution.
+ * A worker that dies or times out is replaced, and the episode it was
+ * running is reported to the caller with that status and no scores.
+ *
+ * POSIX only.
+ */
+class EvaluationFarm
+{
+public:
+
+    /** What became of one job */
+    enum Status
+    {
+        /** Worker::evaluate returned, its scores may be empty */
+        completed,
+        /** Worker::evaluate threw */
+        failed,
+        /** The worker process died during the job */
+        crashed,
+        /** The job took longer than the timeout, the worker was killed */
+        timedOut
+    };
+
+    struct Result
+    {
+        Status status;
+        /** From Worker::evaluate if completed, empty otherwise */
+        std::vector<double> scores;
+    };
+
+    /**
+     * Runs episodes inside a worker process. One copy of the object is
+     * inherited by each worker through fork, so the constructor should
+     * only store configuration; build worlds and models in setup.
+     */
+    class Worker
+    {
+    public:
+        virtual ~Worker() { }
+
+        /**
+         * Called once in each worker process before its first episode,
+         * and again in the replacement if a worker is respawned
+         */
+        virtual void setup() { }
+
+        /**
+         * Run one episode.
+         * @param[in] parameters one vector per controller, as given by
+         * AnnealEvolution::nextBatchOfControllers
+         * @return the scores for the episode. Empty if it exploded
+         */
+        virtual std::vector<double>
+        evaluate(const std::vector< std::vector<double> >& parameters) = 0;
+    };
+
+    /**
+     * Fork the workers.
+     * @param[in] worker used in the worker processes only. Must outlive
+     * the farm.
+     * @param[in] numWorkers number of processes. 0 uses one per core
+     * @param[in] timeoutSeconds kill an episode that takes longer than
+     * this. 0 waits forever
+     */
+    EvaluationFarm(Worker& worker, std::size_t numWorkers = 0,
+                   double timeoutSeconds = 0.0);
+
+    /** Closes the sockets, which tells the workers to exit */
+    ~EvaluationFarm();
+
+    /**
+     * Run every job, using all workers in parallel. Blocks until all
+     * are done. A job whose worker dies or times out is not retried,
+     * since it may be the job that kills the worker.
+     * @param[in] jobs each job is one vector of parameters per controller
+     * @return the result of each job, in the same order as jobs
+     */
+    std::vector<Result>
+    evaluate(const std::vector< std::vector< std::vector<double> > >& jobs);
+
+    std::size_t getNumWorkers() const
+    {
+        return m_workers.size();
+    }
+
+    static const char* statusName(Status status);
+
+    /** Number of workers that have been replaced so far */
+    std::size_t getNumRespawns() const
+    {
+        return m_respawns;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    EvaluationFarm(const EvaluationFarm&);
+
+    /** Disable the assignment operator. */
+    EvaluationFarm& operator=(const EvaluationFarm&);
+
+    struct WorkerProcess
+    {
+        pid_t pid;
+        int socket;
+        /// Index of the job it is running, -1 if idle
+        int job;
+        /// Seconds since the epoch when the job was sent
+        double startTime;
+    };
+
+    void spawn(WorkerProcess& process);
+
+    /** Kill and reap a worker, then start a replacement */
+    void respawn(WorkerProcess& process);
+
+    /** Entry point of the forked process, never returns */
+    void workerLoop(int socket);
+
+    Worker& m_worker;
+
+    const double m_timeout;
+
+    std::vector<WorkerProcess> m_workers;
+
+    std::size_t m_respawns;
+};
+
+#endif /* EVALUATION_FARM_H_ */
@@ -0,0 +1,155 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef PROCESS_IO_H_
+#define PROCESS_IO_H_
+
+/**
+ * @file ProcessIO.h
+ * @brief Helpers to pass scores and parameters between processes
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+// POSIX
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+// The C++ Standard Library
+#include <cstddef>
+#include <vector>
+
+/**
+ * Blocking reads and writes of raw values over the pipes and sockets
+ * that EvaluationFarm and StateFork use to talk to their children, and
+ * the clock they time them with. Both ends are the same build on the
+ * same machine, so values are sent as they are in memory.
+ *
+ * Every function returns false on an error or when the other end
+ * closed, so the caller can treat the child as crashed. A vector size
+ * is checked against the caller's limit before anything is allocated
+ * for it.
+ */
+namespace ProcessIO
+{
+#ifdef MSG_NOSIGNAL
+    const int sendFlags = MSG_NOSIGNAL;
+#else
+    const int sendFlags = 0;
+#endif
+
+    /**
+     * More doubles than any scores or parameters of one controller,
+     * 8 MB of them
+     */
+    const std::size_t maxVectorSize = 1 << 20;
+
+    /** @return seconds since the epoch */
+    inline double now()
+    {
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + tv.tv_usec / 1000000.0;
+    }
+
+    /**
+     * Write n bytes to a pipe or a socket. A socket that was closed on
+     * the other end returns false rather than raising SIGPIPE.
+     */
+    inline bool writeAll(int fd, const void* data, std::size_t n)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        bool isSocket = true;
+        while (n > 0)
+        {
+            ssize_t written = isSocket ? send(fd, bytes, n, sendFlags)
+                                       : write(fd, bytes, n);
+            if (written < 0 && errno == ENOTSOCK && isSocket)
+            {
+                isSocket = false;
+                continue;
+            }
+            else if (written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (written <= 0)
+            {
+                return false;
+            }
+            bytes += written;
+            n -= written;
+        }
+        return true;
+    }
+
+    /** Read n bytes from a pipe or a socket */
+    inline bool readAll(int fd, void* data, std::size_t n)
+    {
+        char* bytes = static_cast<char*>(data);
+        while (n > 0)
+        {
+            ssize_t received = read(fd, bytes, n);
+            if (received < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (received <= 0)
+            {
+                return false;
+            }
+            bytes += received;
+            n -= received;
+        }
+        return true;
+    }
+
+    /** Read a size, false if it is larger than maxSize */
+    inline bool readSize(int fd, std::size_t& n, std::size_t maxSize)
+    {
+        return readAll(fd, &n, sizeof(n)) && n <= maxSize;
+    }
+
+    inline bool writeVector(int fd, const std::vector<double>& values)
+    {
+        const std::size_t n = values.size();
+        return writeAll(fd, &n, sizeof(n)) &&
+                (n == 0 || writeAll(fd, &values[0], n * sizeof(double)));
+    }
+
+    /**
+     * @param[in] maxSize the most values the caller expects, a larger
+     * size fails without reading further
+     */
+    inline bool readVector(int fd,
+                           std::vector<double>& values,
+                           std::size_t maxSize)
+    {
+        std::size_t n;
+        if (!readSize(fd, n, maxSize))
+        {
+            return false;
+        }
+        values.resize(n);
+        return n == 0 || readAll(fd, &values[0], n * sizeof(double));
+    }
+}
+
+#endif /* PROCESS_IO_H_ */
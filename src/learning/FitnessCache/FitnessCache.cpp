@@ -0,0 +1,259 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file FitnessCache.cpp
+ * @brief Contains the implementation of class FitnessCache
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "FitnessCache.h"
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    // 64 bit FNV-1a
+    const FitnessCache::Key fnvOffset = 14695981039346656037ULL;
+    const FitnessCache::Key fnvPrime = 1099511628211ULL;
+
+    FitnessCache::Key hashWord(FitnessCache::Key hash,
+                               unsigned long long word)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            hash ^= (word >> (8 * i)) & 0xff;
+            hash *= fnvPrime;
+        }
+        return hash;
+    }
+
+    bool allFinite(const std::vector<double>& values)
+    {
+        for (std::size_t i = 0; i < values.size(); i++)
+        {
+            // False for NaN too
+            if (!(std::fabs(values[i]) <= std::numeric_limits<double>::max()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+FitnessCache::FitnessCache(std::string filename) :
+m_numSkipped(0)
+{
+    if (filename != "")
+    {
+        readFile(filename);
+        m_cacheLog.open(filename.c_str(), ios::app);
+        if (!m_cacheLog.is_open())
+        {
+            throw std::runtime_error("Could not open fitness cache " + filename);
+        }
+        m_cacheLog << setprecision(17);
+    }
+}
+
+FitnessCache::~FitnessCache()
+{
+    if (m_cacheLog.is_open())
+    {
+        m_cacheLog.close();
+    }
+}
+
+FitnessCache::Key FitnessCache::hashParameters(const Parameters& params,
+                                               unsigned long seed)
+{
+    Key hash = hashWord(fnvOffset, seed);
+
+    for (std::size_t i = 0; i < params.size(); i++)
+    {
+        // Include the length so {a}{b,c} and {a,b}{c} hash differently
+        const std::size_t n = params[i].size();
+        hash = hashWord(hash, n);
+        for (std::size_t j = 0; j < n; j++)
+        {
+            // Treat -0.0 as 0.0, they give the same simulation
+            const double value = (params[i][j] == 0.0) ? 0.0 : params[i][j];
+            unsigned long long bits;
+            memcpy(&bits, &value, sizeof(double));
+            hash = hashWord(hash, bits);
+        }
+    }
+
+    return hash;
+}
+
+const FitnessCache::Entry* FitnessCache::find(Key key,
+                                              const Parameters& params,
+                                              unsigned long seed) const
+{
+    std::pair<EntryMap::const_iterator, EntryMap::const_iterator> range =
+        m_entries.equal_range(key);
+    for (EntryMap::const_iterator it = range.first; it != range.second; ++it)
+    {
+        // A different set of parameters with the same hash isn't a hit
+        if (it->second.seed == seed && it->second.params == params)
+        {
+            return &it->second;
+        }
+    }
+    return NULL;
+}
+
+bool FitnessCache::lookup(const Parameters& params,
+                          unsigned long seed,
+                          std::vector<double>& scores) const
+{
+    const Entry* entry = find(hashParameters(params, seed), params, seed);
+    if (entry == NULL)
+    {
+        return false;
+    }
+    scores = entry->scores;
+    return true;
+}
+
+bool FitnessCache::insert(const Parameters& params,
+                          unsigned long seed,
+                          const std::vector<double>& scores)
+{
+    // A failed episode may pass next time, don't remember it
+    if (scores.empty() || !allFinite(scores))
+    {
+        return false;
+    }
+
+    const Key key = hashParameters(params, seed);
+    if (find(key, params, seed) != NULL)
+    {
+        return false;
+    }
+
+    Entry entry;
+    entry.seed = seed;
+    entry.params = params;
+    entry.scores = scores;
+    m_entries.insert(std::make_pair(key, entry));
+
+    if (m_cacheLog.is_open())
+    {
+        // key,seed,groups,then each group's size and values,then scores
+        m_cacheLog << hex << key << dec << "," << seed << "," << params.size();
+        for (std::size_t i = 0; i < params.size(); i++)
+        {
+            m_cacheLog << "," << params[i].size();
+            for (std::size_t j = 0; j < params[i].size(); j++)
+            {
+                m_cacheLog << "," << params[i][j];
+            }
+        }
+        for (std::size_t i = 0; i < scores.size(); i++)
+        {
+            m_cacheLog << "," << scores[i];
+        }
+        // Flush so a crash doesn't lose results we paid to simulate
+        m_cacheLog << endl;
+    }
+    return true;
+}
+
+void FitnessCache::readFile(const std::string& filename)
+{
+    ifstream cacheFile(filename.c_str());
+    if (!cacheFile.is_open())
+    {
+        // First run, nothing cached yet
+        return;
+    }
+
+    std::string line;
+    while (getline(cacheFile, line))
+    {
+        if (!line.empty() && !readLine(line))
+        {
+            m_numSkipped++;
+        }
+    }
+    cacheFile.close();
+}
+
+bool FitnessCache::readLine(const std::string& line)
+{
+    std::istringstream ss(line);
+    Key key;
+    char comma;
+    Entry entry;
+    std::size_t groups;
+    ss >> hex >> key >> dec >> comma >> entry.seed >> comma >> groups;
+    if (ss.fail())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < groups; i++)
+    {
+        std::size_t n;
+        if (!(ss >> comma >> n))
+        {
+            return false;
+        }
+        std::vector<double> group;
+        for (std::size_t j = 0; j < n; j++)
+        {
+            double value;
+            if (!(ss >> comma >> value))
+            {
+                return false;
+            }
+            group.push_back(value);
+        }
+        entry.params.push_back(group);
+    }
+
+    double value;
+    while (ss >> comma >> value)
+    {
+        entry.scores.push_back(value);
+    }
+
+    // Catches truncated lines and the key only lines of older versions
+    if (!ss.eof() || entry.scores.empty() ||
+        hashParameters(entry.params, entry.seed) != key)
+    {
+        return false;
+    }
+
+    if (find(key, entry.params, entry.seed) == NULL)
+    {
+        m_entries.insert(std::make_pair(key, entry));
+    }
+    return true;
+}
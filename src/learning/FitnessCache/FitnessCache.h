@@ -0,0 +1,145 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef FITNESS_CACHE_H_
+#define FITNESS_CACHE_H_
+
+/**
+ * @file FitnessCache.h
+ * @brief Contains the definition of class FitnessCache
+ * Remembers the scores of parameter sets that have already been simulated
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A map from a set of learned parameters (plus the seed of the scenario
+ * they were tested in) to the scores they received. Entries are found
+ * by a hash of the parameters, but a hit also compares the stored
+ * parameters, so two parameter sets whose hashes collide never share
+ * scores.
+ * Only valid for deterministic scenarios: if the same parameters can
+ * produce different scores the cache will hide that variance.
+ *
+ * Entries are appended to a text file as they are inserted, and the
+ * file is read back in the constructor, so the cache persists across
+ * learning runs that share a logs directory.
+ */
+class FitnessCache
+{
+public:
+
+    typedef unsigned long long Key;
+
+    typedef std::vector< std::vector<double> > Parameters;
+
+    /**
+     * Read any previously stored scores from filename, then hold the
+     * file open to append new ones. Lines that can't be read back,
+     * including those of older versions of the file, are skipped and
+     * counted in getNumSkipped.
+     * @param[in] filename the file that stores the cache. An empty
+     * string gives an in memory only cache.
+     */
+    FitnessCache(std::string filename);
+
+    ~FitnessCache();
+
+    /**
+     * Hash a group of parameter vectors (one per controller) together
+     * with the scenario seed. The hash covers the bit pattern of each
+     * double, with -0.0 taken as 0.0, and the length of each vector.
+     * Every value is hashed as 8 little endian bytes, so the hash is
+     * the same on every platform.
+     */
+    static Key hashParameters(const Parameters& params, unsigned long seed);
+
+    /**
+     * @param[out] scores overwritten with the stored scores on a hit,
+     * unchanged otherwise
+     * @return true if params have been scored before with seed
+     */
+    bool lookup(const Parameters& params,
+                unsigned long seed,
+                std::vector<double>& scores) const;
+
+    /**
+     * Store the scores of params. The first scores stored are kept,
+     * later inserts of the same params and seed are ignored. Scores of
+     * failed episodes, which are empty or not finite, are not stored.
+     * @return true if the scores were stored
+     */
+    bool insert(const Parameters& params,
+                unsigned long seed,
+                const std::vector<double>& scores);
+
+    std::size_t size() const
+    {
+        return m_entries.size();
+    }
+
+    /** The number of lines of the file that couldn't be read */
+    std::size_t getNumSkipped() const
+    {
+        return m_numSkipped;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    FitnessCache(const FitnessCache&);
+
+    /** Disable the assignment operator. */
+    FitnessCache& operator=(const FitnessCache&);
+
+    struct Entry
+    {
+        unsigned long seed;
+
+        Parameters params;
+
+        std::vector<double> scores;
+    };
+
+    typedef std::multimap<Key, Entry> EntryMap;
+
+    /** @return the entry of params and seed, or NULL */
+    const Entry* find(Key key,
+                      const Parameters& params,
+                      unsigned long seed) const;
+
+    void readFile(const std::string& filename);
+
+    /** @return false if line is not a complete entry */
+    bool readLine(const std::string& line);
+
+    EntryMap m_entries;
+
+    std::size_t m_numSkipped;
+
+    std::ofstream m_cacheLog;
+};
+
+#endif /* FITNESS_CACHE_H_ */
@@ -33,11 +33,11 @@
 
 using namespace std;
 
-NeuroEvoMember::NeuroEvoMember(configuration config)
+NeuroEvoMember::NeuroEvoMember(const EvolutionConfig& config, tgRandomStream& random)
 {
-	this->numInputs=config.getintvalue("numberOfStates");
-    this->numOutputs=config.getintvalue("numberOfActions");
-	int numHidden = config.getintvalue("numberHidden");
+	this->numInputs=config.numberOfStates;
+    this->numOutputs=config.numberOfActions;
+	int numHidden = config.numberHidden;
     assert(numOutputs > 0);
 	cout<<"creating NN"<<endl;
 	if(numInputs>0)
@@ -46,7 +46,7 @@ NeuroEvoMember::NeuroEvoMember(configuration config)
 	{
 		statelessParameters.resize(numOutputs);
 		for(int i=0;i<numOutputs;i++)
-			statelessParameters[i]=rand()*1.0/RAND_MAX;
+			statelessParameters[i]=random.uniform();
 	}
 	maxScore=-1000;
 }
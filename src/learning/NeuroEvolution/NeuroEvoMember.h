@@ -30,7 +30,8 @@
 #include <string>
 #include <vector>
 #include <tr1/random>
-#include "learning/Configuration/configuration.h"
+#include "learning/Configuration/EvolutionConfig.h"
+#include "core/tgRandomStream.h"
 
 // Forward Declarations
 class neuralNetwork;
@@ -38,7 +39,7 @@ class neuralNetwork;
 class NeuroEvoMember
 {
 public:
-	NeuroEvoMember(configuration config);
+	NeuroEvoMember(const EvolutionConfig& config, tgRandomStream& random);
 	~NeuroEvoMember();
 	void mutate(std::tr1::ranlux64_base_01 *eng);
 
@@ -37,18 +37,21 @@
 
 using namespace std;
 
-NeuroEvoPopulation::NeuroEvoPopulation(int populationSize,configuration& config) :
+NeuroEvoPopulation::NeuroEvoPopulation(int populationSize,const EvolutionConfig& config,
+                                       unsigned int seed, int index) :
+compareAverageScores(config.compareAverageScores),
+clearScoresBetweenGenerations(config.clearScoresBetweenGenerations),
+populationSize(populationSize),
 m_config(config),
-compareAverageScores(true),
-clearScoresBetweenGenerations(false)
+m_seed(seed),
+m_index(index)
 {
-	this->compareAverageScores=config.getintvalue("compareAverageScores");
-	this->clearScoresBetweenGenerations=config.getintvalue("clearScoresBetweenGenerations");
 
 	for(int i=0;i<populationSize;i++)
 	{
 		cout<<"  creating members"<<endl;
-		controllers.push_back(new NeuroEvoMember(config));
+		tgRandomStream random(seed, 0, index * populationSize + i);
+		controllers.push_back(new NeuroEvoMember(config, random));
 	}
 }
 
@@ -77,7 +80,7 @@ void NeuroEvoPopulation::mutate(std::tr1::ranlux64_base_01 *engPntr,std::size_t
 	return;
 }
 
-void NeuroEvoPopulation::combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::size_t numToMutate, std::size_t numToCombine)
+void NeuroEvoPopulation::combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::size_t numToMutate, std::size_t numToCombine, int generation)
 {
     std::tr1::uniform_real<double> unif(0, 1);
     
@@ -110,7 +113,10 @@ void NeuroEvoPopulation::combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::
             }
         }
         
-        NeuroEvoMember* newController = new NeuroEvoMember(m_config);
+        // Its parameters are overwritten by copyFrom
+        tgRandomStream random(m_seed, generation,
+                              m_index * populationSize + newControllers.size());
+        NeuroEvoMember* newController = new NeuroEvoMember(m_config, random);
         newController->copyFrom(controllers[index1], controllers[index2], eng);
         
         if(unif(*eng) > 0.9)
@@ -125,7 +131,9 @@ void NeuroEvoPopulation::combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::
     {
         double val1 = unif(*eng);
         int index1 = getIndexFromProbability(probabilities, val1);
-        NeuroEvoMember* newController = new NeuroEvoMember(m_config);
+        tgRandomStream random(m_seed, generation,
+                              m_index * populationSize + newControllers.size());
+        NeuroEvoMember* newController = new NeuroEvoMember(m_config, random);
         newController->copyFrom(controllers[index1]);
         newController->mutate(eng);
         newControllers.push_back(newController);
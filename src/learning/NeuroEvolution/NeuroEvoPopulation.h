@@ -33,11 +33,12 @@
 
 class NeuroEvoPopulation {
 public:
-	NeuroEvoPopulation(int numControllers, configuration& config);
+	NeuroEvoPopulation(int numControllers, const EvolutionConfig& config,
+                       unsigned int seed, int index);
 	~NeuroEvoPopulation();
 	std::vector<NeuroEvoMember *> controllers;
     void mutate(std::tr1::ranlux64_base_01 *eng,std::size_t numToMutate);
-	void combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::size_t numToMutate, std::size_t numToCombine);
+	void combineAndMutate(std::tr1::ranlux64_base_01 *eng, std::size_t numToMutate, std::size_t numToCombine, int generation);
 	void orderPopulation();
 	NeuroEvoMember * getMember(int i){return controllers[i];};
 
@@ -49,7 +50,11 @@ private:
 	bool compareAverageScores;
 	bool clearScoresBetweenGenerations;
 	int populationSize;
-    configuration m_config;
+    const EvolutionConfig& m_config;
+    /// The run seed, the members' parameters come from streams of it
+    unsigned int m_seed;
+    /// Which of NeuroEvolution's populations this is
+    int m_index;
 };
 
 
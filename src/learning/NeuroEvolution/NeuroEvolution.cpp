@@ -53,48 +53,57 @@ unsigned long long rdtsc(){
 
 #endif
 
-NeuroEvolution::NeuroEvolution(std::string suff, std::string config, std::string path) :
-suffix(suff)
+namespace
 {
-	currentTest=0;
-	generationNumber=0;
-	if (path != "")
-	{
-		resourcePath = FileHelpers::getResourcePath(path);
-	}
-	else
+	/// Domain 0 is the members' parameters, see NeuroEvoPopulation
+	const unsigned int selectionDomain = 1;
+
+	std::string fullResourcePath(const std::string& path)
 	{
-		resourcePath = "";
+		if (path != "")
+		{
+			return FileHelpers::getResourcePath(path);
+		}
+		else
+		{
+			return "";
+		}
 	}
+}
 
-	std::string configPath = resourcePath + config;
+NeuroEvolution::NeuroEvolution(std::string suff, std::string config, std::string path) :
+suffix(suff),
+resourcePath(fullResourcePath(path)),
+evoConfig(EvolutionConfig::load(resourcePath + config,
+								EvolutionConfig::neuroEvolution))
+{
+	currentTest=0;
+	generationNumber=0;
+	subTests=0;
 
-    configuration myconfigdataaa;
-	myconfigdataaa.readFile(configPath);
-	populationSize=myconfigdataaa.getintvalue("populationSize");
-    numberOfElementsToMutate=myconfigdataaa.getintvalue("numberOfElementsToMutate");
-	numberOfChildren=myconfigdataaa.getintvalue("numberOfChildren");
-	numberOfTestsBetweenGenerations=myconfigdataaa.getintvalue("numberOfTestsBetweenGenerations");
-    numberOfSubtests=myconfigdataaa.getintvalue("numberOfSubtests");
-	numberOfControllers=myconfigdataaa.getintvalue("numberOfControllers"); //shared with ManhattanToyController
-	leniencyCoef=myconfigdataaa.getDoubleValue("leniencyCoef");
-	coevolution=myconfigdataaa.getintvalue("coevolution");
-    seeded = myconfigdataaa.getintvalue("startSeed");
+	// Validated by EvolutionConfig, including that the population won't grow
+	populationSize=evoConfig.populationSize;
+    numberOfElementsToMutate=evoConfig.numberOfElementsToMutate;
+	numberOfChildren=evoConfig.numberOfChildren;
+	numberOfTestsBetweenGenerations=evoConfig.numberOfTestsBetweenGenerations;
+    numberOfSubtests=evoConfig.numberOfSubtests;
+	numberOfControllers=evoConfig.numberOfControllers; //shared with ManhattanToyController
+	leniencyCoef=evoConfig.leniencyCoef;
+	coevolution=evoConfig.coevolution;
+    seeded = evoConfig.startSeed;
     
-    bool learning = myconfigdataaa.getintvalue("learning");
+    bool learning = evoConfig.learning;
     
-    if (populationSize < numberOfElementsToMutate + numberOfChildren)
-    {
-        throw std::invalid_argument("Population will grow with given parameters");
-    }
-    
-   srand(rdtsc());
-	eng.seed(rdtsc());
+    // Printed so a run without a randomSeed can still be repeated
+    seed = evoConfig.randomSeed != 0 ? evoConfig.randomSeed : rdtsc();
+    cout << "Random seed " << seed << endl;
+    // The neural networks draw from eng, so it follows the run seed too
+	eng.seed(seed);
 
 	for(int j=0;j<numberOfControllers;j++)
 	{
 		cout<<"creating Populations"<<endl;
-		populations.push_back(new NeuroEvoPopulation(populationSize,myconfigdataaa));
+		populations.push_back(new NeuroEvoPopulation(populationSize,evoConfig,seed,j));
 	}
 
     // Overwrite the random parameters based on data
@@ -142,7 +151,7 @@ void NeuroEvolution::combineAndMutate()
 {
     for(std::size_t i=0;i<populations.size();i++)
     {
-        populations.at(i)->combineAndMutate(&eng, numberOfElementsToMutate, numberOfChildren);
+        populations.at(i)->combineAndMutate(&eng, numberOfElementsToMutate, numberOfChildren, generationNumber);
     }    
 }
 
@@ -219,12 +228,14 @@ vector <NeuroEvoMember *> NeuroEvolution::nextSetOfControllers()
 			currentTest=populationSize - numberOfElementsToMutate - numberOfChildren; //start from the mutated ones only (last x)
 	}
 
+	tgRandomStream selection(seed, generationNumber, currentTest, subTests, selectionDomain);
+
 	selectedControllers.clear();
 	for(std::size_t i=0;i<populations.size();i++)
 	{
 		int selectedOne=0;
 		if(coevolution)
-			selectedOne=rand()%populationSize; //select random one from each pool
+			selectedOne=selection.index(populationSize); //select random one from each pool
 		else
 			selectedOne=currentTest; //select the same from each pool
 
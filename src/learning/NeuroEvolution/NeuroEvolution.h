@@ -30,6 +30,7 @@
 
 #include "NeuroEvoPopulation.h"
 #include "NeuroEvoMember.h"
+#include "learning/Configuration/EvolutionConfig.h"
 #include <fstream>
 
 class NeuroEvolution
@@ -43,13 +44,21 @@ public:
 	void evaluatePopulation();
 	std::vector< NeuroEvoMember *> nextSetOfControllers();
 	void updateScores(std::vector<double> scores);
+	const EvolutionConfig& getConfig() const
+	{
+		return evoConfig;
+	}
     const std::string suffix;
     /// @todo make this const if we decide to force everyone to put their logs in resources
     std::string resourcePath;
 private:
+	/// Shared with every other user of the same file, see EvolutionConfig::load
+	const EvolutionConfig& evoConfig;
 	int populationSize;
 	int numberOfControllers;
 	std::tr1::ranlux64_base_01 eng;
+	/// The members' parameters and the selection come from a tgRandomStream of this
+	unsigned int seed;
 	std::vector< NeuroEvoPopulation *> populations;
 	std::vector <NeuroEvoMember *>  selectedControllers;
 	std::vector< std::vector< double > > scoresOfTheGeneration;
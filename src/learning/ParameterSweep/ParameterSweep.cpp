@@ -0,0 +1,356 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file ParameterSweep.cpp
+ * @brief Contains the implementation of class ParameterSweep
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "ParameterSweep.h"
+#include "learning/EvaluationFarm/EvaluationFarm.h"
+#include "learning/EvaluationFarm/ProcessIO.h"
+// POSIX
+#include <unistd.h>
+// The C++ Standard Library
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <tr1/random>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * Runs a ParameterSweep::Worker in the farm. Each job is one point,
+     * and each answer is the status and seconds followed by the metrics,
+     * so the coordinator can tell a throw from an explosion.
+     */
+    class FarmWorker : public EvaluationFarm::Worker
+    {
+    public:
+        FarmWorker(ParameterSweep::Worker& worker) :
+        m_worker(worker)
+        {
+        }
+
+        virtual void setup()
+        {
+            m_worker.setup();
+        }
+
+        virtual std::vector<double>
+        evaluate(const std::vector< std::vector<double> >& parameters)
+        {
+            const double start = ProcessIO::now();
+            ParameterSweep::Status status = ParameterSweep::ok;
+            std::vector<double> metrics;
+            try
+            {
+                metrics = m_worker.evaluate(parameters[0]);
+                if (metrics.empty())
+                {
+                    status = ParameterSweep::exploded;
+                }
+            }
+            catch (std::exception& e)
+            {
+                cerr << "Worker " << getpid() << " point failed: " << e.what() << endl;
+                status = ParameterSweep::failed;
+                metrics.clear();
+            }
+
+            std::vector<double> answer;
+            answer.push_back(status);
+            answer.push_back(ProcessIO::now() - start);
+            answer.insert(answer.end(), metrics.begin(), metrics.end());
+            return answer;
+        }
+
+    private:
+        ParameterSweep::Worker& m_worker;
+    };
+
+    std::string csvString(const std::string& s)
+    {
+        std::string result = "\"";
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            if (s[i] == '"')
+            {
+                result += '"';
+            }
+            result += s[i];
+        }
+        return result + "\"";
+    }
+}
+
+ParameterSweep::ParameterSweep(const std::vector<std::string>& metricNames) :
+m_metricNames(metricNames)
+{
+}
+
+ParameterSweep::~ParameterSweep()
+{
+}
+
+void ParameterSweep::addParameter(const std::string& name,
+                                  double min,
+                                  double max,
+                                  std::size_t levels,
+                                  bool logScale)
+{
+    if (max < min)
+    {
+        throw std::invalid_argument("Parameter " + name + " has max < min");
+    }
+    else if (levels == 0)
+    {
+        throw std::invalid_argument("Parameter " + name + " has no levels");
+    }
+    else if (logScale && min <= 0.0)
+    {
+        throw std::invalid_argument("Parameter " + name +
+                                    " is log scaled but min is not positive");
+    }
+
+    const Parameter p = {name, min, max, levels, logScale};
+    m_parameters.push_back(p);
+}
+
+double ParameterSweep::scale(const Parameter& p, double u)
+{
+    if (p.logScale)
+    {
+        return p.min * std::pow(p.max / p.min, u);
+    }
+    return p.min + (p.max - p.min) * u;
+}
+
+std::vector< std::vector<double> >
+ParameterSweep::makePoints(Sampling sampling, std::size_t samples,
+                           unsigned long seed) const
+{
+    if (m_parameters.empty())
+    {
+        throw std::runtime_error("No parameters to sweep");
+    }
+
+    const std::size_t n = m_parameters.size();
+    std::vector< std::vector<double> > points;
+
+    if (sampling == grid)
+    {
+        std::size_t total = 1;
+        for (std::size_t j = 0; j < n; j++)
+        {
+            total *= m_parameters[j].levels;
+        }
+
+        // Count through the levels, the last parameter fastest
+        std::vector<std::size_t> level(n, 0);
+        for (std::size_t i = 0; i < total; i++)
+        {
+            std::vector<double> point(n);
+            for (std::size_t j = 0; j < n; j++)
+            {
+                const Parameter& p = m_parameters[j];
+                const double u = p.levels > 1 ?
+                    static_cast<double>(level[j]) / (p.levels - 1) : 0.5;
+                point[j] = scale(p, u);
+            }
+            points.push_back(point);
+
+            for (std::size_t j = n; j-- > 0; )
+            {
+                if (++level[j] < m_parameters[j].levels)
+                {
+                    break;
+                }
+                level[j] = 0;
+            }
+        }
+        return points;
+    }
+
+    std::tr1::ranlux64_base_01 eng(seed);
+    std::tr1::uniform_real<double> unif(0, 1);
+
+    points.resize(samples, std::vector<double>(n));
+    if (sampling == monteCarlo)
+    {
+        for (std::size_t i = 0; i < samples; i++)
+        {
+            for (std::size_t j = 0; j < n; j++)
+            {
+                points[i][j] = scale(m_parameters[j], unif(eng));
+            }
+        }
+    }
+    else if (sampling == latinHypercube)
+    {
+        std::vector<std::size_t> strata(samples);
+        for (std::size_t j = 0; j < n; j++)
+        {
+            for (std::size_t i = 0; i < samples; i++)
+            {
+                strata[i] = i;
+            }
+            // Fisher-Yates, so each parameter pairs the strata differently
+            for (std::size_t i = samples; i > 1; i--)
+            {
+                std::size_t k = static_cast<std::size_t>(unif(eng) * i);
+                if (k >= i)
+                {
+                    k = i - 1;
+                }
+                std::swap(strata[i - 1], strata[k]);
+            }
+            for (std::size_t i = 0; i < samples; i++)
+            {
+                const double u = (strata[i] + unif(eng)) / samples;
+                points[i][j] = scale(m_parameters[j], u);
+            }
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Unknown sampling");
+    }
+    return points;
+}
+
+const std::vector<ParameterSweep::Result>&
+ParameterSweep::run(Worker& worker,
+                    const std::vector< std::vector<double> >& points,
+                    std::size_t numWorkers,
+                    double timeoutSeconds)
+{
+    std::vector< std::vector< std::vector<double> > > jobs(points.size());
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        jobs[i].push_back(points[i]);
+    }
+
+    std::vector<EvaluationFarm::Result> answers;
+    {
+        FarmWorker farmWorker(worker);
+        // Workers exit when the farm goes out of scope
+        EvaluationFarm farm(farmWorker, numWorkers, timeoutSeconds);
+        answers = farm.evaluate(jobs);
+    }
+
+    m_results.clear();
+    for (std::size_t i = 0; i < points.size(); i++)
+    {
+        const std::vector<double>& answer = answers[i].scores;
+        Result r;
+        r.values = points[i];
+        if (answers[i].status != EvaluationFarm::completed || answer.size() < 2)
+        {
+            // FarmWorker catches what evaluate throws, so the worker
+            // died or timed out
+            r.status = crashed;
+            r.seconds = 0.0;
+        }
+        else
+        {
+            r.status = static_cast<Status>(static_cast<int>(answer[0]));
+            r.seconds = answer[1];
+            r.metrics.assign(answer.begin() + 2, answer.end());
+            if (r.status == ok && r.metrics.size() != m_metricNames.size())
+            {
+                cerr << "Point " << i << " returned " << r.metrics.size()
+                     << " metrics, expected " << m_metricNames.size() << endl;
+            }
+        }
+        m_results.push_back(r);
+    }
+    return m_results;
+}
+
+const char* ParameterSweep::statusName(Status status)
+{
+    switch (status)
+    {
+        case ok:
+            return "ok";
+        case exploded:
+            return "exploded";
+        case failed:
+            return "failed";
+        case crashed:
+            return "crashed";
+        default:
+            return "unknown";
+    }
+}
+
+void ParameterSweep::writeCSV(std::ostream& out) const
+{
+    const std::streamsize precision = out.precision(12);
+
+    out << "point";
+    for (std::size_t j = 0; j < m_parameters.size(); j++)
+    {
+        out << "," << csvString(m_parameters[j].name);
+    }
+    out << ",status,seconds";
+    for (std::size_t j = 0; j < m_metricNames.size(); j++)
+    {
+        out << "," << csvString(m_metricNames[j]);
+    }
+    out << endl;
+
+    for (std::size_t i = 0; i < m_results.size(); i++)
+    {
+        const Result& r = m_results[i];
+        out << i;
+        for (std::size_t j = 0; j < r.values.size(); j++)
+        {
+            out << "," << r.values[j];
+        }
+        out << "," << statusName(r.status) << "," << r.seconds;
+        // Failed points leave their metrics empty
+        for (std::size_t j = 0; j < m_metricNames.size(); j++)
+        {
+            out << ",";
+            if (j < r.metrics.size())
+            {
+                out << r.metrics[j];
+            }
+        }
+        out << endl;
+    }
+    out.precision(precision);
+}
+
+void ParameterSweep::writeCSV(const std::string& fileName) const
+{
+    std::ofstream out(fileName.c_str());
+    if (!out)
+    {
+        throw std::runtime_error("Could not open " + fileName);
+    }
+    writeCSV(out);
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef PARAMETER_SWEEP_H_
+#define PARAMETER_SWEEP_H_
+
+/**
+ * @file ParameterSweep.h
+ * @brief Contains the definition of class ParameterSweep
+ * Runs a model over a grid or sample of parameters in worker processes
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Runs one simulation per point of a parameter space, such as the
+ * stiffness and damping of a tgSpringCableActuator::Config or the motor
+ * of a tgKinematicActuator::Config, on every core through an
+ * EvaluationFarm. Each point gets its own world, so a point that throws,
+ * explodes, crashes or times out is recorded as such and the sweep
+ * goes on.
+ *
+ * The Worker builds whatever every point shares, such as a
+ * tgTerrainLibrary or the tgStructure of the model, once per process in
+ * setup. Its evaluate maps the values of one point onto the Config
+ * structs, builds a world and the model, runs it and returns its
+ * metrics.
+ *
+ * The results are written as a CSV table, one line per point with its
+ * values, status, wall clock seconds and metrics.
+ *
+ * POSIX only.
+ */
+class ParameterSweep
+{
+public:
+
+    /** How makePoints covers the space */
+    enum Sampling
+    {
+        /** Every combination of every parameter's levels */
+        grid,
+        /** Independent uniform samples, as in MonteCarlo evolution */
+        monteCarlo,
+        /**
+         * Latin hypercube: each parameter's range is split into as many
+         * strata as samples, and each stratum is used exactly once
+         */
+        latinHypercube
+    };
+
+    /** What became of one point */
+    enum Status
+    {
+        ok,
+        /** evaluate returned no metrics */
+        exploded,
+        /** evaluate threw */
+        failed,
+        /** The worker died or timed out */
+        crashed
+    };
+
+    /** Runs points inside a worker process, see EvaluationFarm::Worker */
+    class Worker
+    {
+    public:
+        virtual ~Worker() { }
+
+        /** Called once in each worker process, build shared state here */
+        virtual void setup() { }
+
+        /**
+         * Simulate one point.
+         * @param[in] values one per parameter, in the order they were
+         * added, in the parameters' own units
+         * @return one value per metric, empty if the model exploded
+         */
+        virtual std::vector<double>
+        evaluate(const std::vector<double>& values) = 0;
+    };
+
+    struct Result
+    {
+        std::vector<double> values;
+        Status status;
+        /** Wall clock time in the worker, 0 if it crashed */
+        double seconds;
+        /** One per metric if status is ok, empty otherwise */
+        std::vector<double> metrics;
+    };
+
+    /**
+     * @param[in] metricNames the columns of what Worker::evaluate
+     * returns
+     */
+    ParameterSweep(const std::vector<std::string>& metricNames);
+
+    ~ParameterSweep();
+
+    /**
+     * Add a dimension to the space.
+     * @param[in] name the column name in the results
+     * @param[in] min the smallest value
+     * @param[in] max the largest value, at least min
+     * @param[in] levels values on a grid, spread evenly from min to max
+     * @param[in] logScale spread the values evenly in log space instead,
+     * min must then be positive
+     * @throw std::invalid_argument if the range or levels are invalid
+     */
+    void addParameter(const std::string& name,
+                      double min,
+                      double max,
+                      std::size_t levels = 2,
+                      bool logScale = false);
+
+    std::size_t getNumParameters() const
+    {
+        return m_parameters.size();
+    }
+
+    /**
+     * The points to run.
+     * @param[in] sampling how to cover the space
+     * @param[in] samples number of points for monteCarlo and latinHypercube,
+     * ignored for grid
+     * @param[in] seed for monteCarlo and latinHypercube, the same seed gives
+     * the same points
+     * @throw std::runtime_error if there are no parameters
+     */
+    std::vector< std::vector<double> >
+    makePoints(Sampling sampling, std::size_t samples = 0,
+               unsigned long seed = 1) const;
+
+    /**
+     * Run every point, blocking until all are done. Replaces the
+     * results of the last run.
+     * @param[in] worker used in the worker processes only
+     * @param[in] points from makePoints, or any values in the order
+     * the parameters were added
+     * @param[in] numWorkers number of processes, 0 uses one per core
+     * @param[in] timeoutSeconds a point that takes longer is killed and
+     * recorded as crashed, 0 waits forever
+     * @return the results, in the same order as points
+     */
+    const std::vector<Result>& run(Worker& worker,
+                                   const std::vector< std::vector<double> >& points,
+                                   std::size_t numWorkers = 0,
+                                   double timeoutSeconds = 0.0);
+
+    const std::vector<Result>& getResults() const
+    {
+        return m_results;
+    }
+
+    /** The results of the last run, with a header line */
+    void writeCSV(std::ostream& out) const;
+
+    /** @throw std::runtime_error if the file can't be opened */
+    void writeCSV(const std::string& fileName) const;
+
+    static const char* statusName(Status status);
+
+private:
+
+    /** Disable the copy constructor. */
+    ParameterSweep(const ParameterSweep&);
+
+    /** Disable the assignment operator. */
+    ParameterSweep& operator=(const ParameterSweep&);
+
+    struct Parameter
+    {
+        std::string name;
+        double min;
+        double max;
+        std::size_t levels;
+        bool logScale;
+    };
+
+    /** The value of p at fraction u of its range, u in [0, 1] */
+    static double scale(const Parameter& p, double u);
+
+    const std::vector<std::string> m_metricNames;
+
+    std::vector<Parameter> m_parameters;
+
+    std::vector<Result> m_results;
+};
+
+#endif /* PARAMETER_SWEEP_H_ */
@@ -0,0 +1,216 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file StateFork.cpp
+ * @brief Contains the implementation of class StateFork
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include "StateFork.h"
+#include "learning/EvaluationFarm/ProcessIO.h"
+// POSIX
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+// The C++ Standard Library
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+StateFork::StateFork(std::size_t numProcesses, double timeoutSeconds) :
+m_numProcesses(numProcesses),
+m_timeout(timeoutSeconds),
+m_failures(0)
+{
+    if (timeoutSeconds < 0.0)
+    {
+        throw std::invalid_argument("Timeout is negative");
+    }
+
+    if (m_numProcesses == 0)
+    {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        m_numProcesses = (cores > 0) ? cores : 1;
+    }
+}
+
+StateFork::~StateFork()
+{
+}
+
+StateFork::Child
+StateFork::spawn(Continuation& continuation,
+                 const std::vector< std::vector<double> >& parameters,
+                 std::size_t variant,
+                 const std::vector<Child>& running)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        throw std::runtime_error("Could not create a pipe for a continuation");
+    }
+
+    // Otherwise anything buffered gets printed by the child too
+    cout.flush();
+    cerr.flush();
+    fflush(NULL);
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        close(fds[0]);
+        close(fds[1]);
+        throw std::runtime_error("Could not fork a continuation");
+    }
+    else if (pid == 0)
+    {
+        close(fds[0]);
+        for (std::size_t i = 0; i < running.size(); i++)
+        {
+            close(running[i].pipe);
+        }
+
+        int exitCode = 0;
+        try
+        {
+            const std::vector<double> scores = continuation.run(parameters);
+            if (!ProcessIO::writeVector(fds[1], scores))
+            {
+                exitCode = 1;
+            }
+        }
+        catch (std::exception& e)
+        {
+            // Exiting without an answer reports the variant as failed
+            cerr << "Continuation " << getpid() << " of variant " << variant
+                 << " failed: " << e.what() << endl;
+            exitCode = 1;
+        }
+
+        close(fds[1]);
+        cout.flush();
+        cerr.flush();
+        // Don't run the parent's destructors or atexit handlers
+        _exit(exitCode);
+    }
+
+    close(fds[1]);
+    Child child;
+    child.pid = pid;
+    child.pipe = fds[0];
+    child.variant = variant;
+    child.startTime = ProcessIO::now();
+    return child;
+}
+
+void StateFork::finish(Child& child, bool killFirst)
+{
+    if (killFirst)
+    {
+        kill(child.pid, SIGKILL);
+    }
+    close(child.pipe);
+    int status;
+    waitpid(child.pid, &status, 0);
+}
+
+std::vector< std::vector<double> >
+StateFork::run(Continuation& continuation,
+               const std::vector< std::vector< std::vector<double> > >& variants)
+{
+    std::vector< std::vector<double> > results(variants.size());
+    std::vector<Child> running;
+    std::size_t next = 0;
+
+    std::vector<pollfd> fds;
+
+    while (next < variants.size() || !running.empty())
+    {
+        while (running.size() < m_numProcesses && next < variants.size())
+        {
+            running.push_back(spawn(continuation, variants[next], next, running));
+            next++;
+        }
+
+        int timeout = -1;
+        const double currentTime = ProcessIO::now();
+        fds.resize(running.size());
+        for (std::size_t i = 0; i < running.size(); i++)
+        {
+            fds[i].fd = running[i].pipe;
+            fds[i].events = POLLIN;
+            fds[i].revents = 0;
+
+            if (m_timeout > 0.0)
+            {
+                double remaining = running[i].startTime + m_timeout - currentTime;
+                int ms = (remaining > 0.0) ? (int) (remaining * 1000.0) + 1 : 0;
+                if (timeout < 0 || ms < timeout)
+                {
+                    timeout = ms;
+                }
+            }
+        }
+
+        int ready = poll(&fds[0], fds.size(), timeout);
+        if (ready < 0 && errno != EINTR)
+        {
+            throw std::runtime_error("poll failed while waiting for continuations");
+        }
+
+        const double pollTime = ProcessIO::now();
+        std::vector<Child> stillRunning;
+        for (std::size_t i = 0; i < running.size(); i++)
+        {
+            Child& child = running[i];
+
+            if (ready > 0 && fds[i].revents != 0)
+            {
+                if (!ProcessIO::readVector(child.pipe, results[child.variant],
+                                           ProcessIO::maxVectorSize))
+                {
+                    results[child.variant].clear();
+                    m_failures++;
+                }
+                finish(child, false);
+            }
+            else if (m_timeout > 0.0 && pollTime - child.startTime > m_timeout)
+            {
+                cerr << "Continuation " << child.pid << " of variant "
+                     << child.variant << " timed out" << endl;
+                results[child.variant].clear();
+                m_failures++;
+                finish(child, true);
+            }
+            else
+            {
+                stillRunning.push_back(child);
+            }
+        }
+        running.swap(stillRunning);
+    }
+
+    return results;
+}
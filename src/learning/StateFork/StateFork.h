@@ -0,0 +1,149 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ *
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+#ifndef STATE_FORK_H_
+#define STATE_FORK_H_
+
+/**
+ * @file StateFork.h
+ * @brief Contains the definition of class StateFork
+ * Runs several continuations of one simulation from its current state
+ * @date October 2026
+ * @author agent
+ * $Id$
+ */
+
+#include <sys/types.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Continues a running simulation once per variant, each from the state
+ * it has right now. Run the warm-up (a gait settling, a drop onto the
+ * terrain) once in this process, then call run: every variant gets a
+ * child process forked from this one, so it starts with an exact copy
+ * of everything in memory, including the Bullet bodies and their
+ * caches, the cable and actuator histories, the CPGEquations node
+ * values and the controllers' timers. Nothing has to be serialized, and
+ * fork only copies the pages the continuation writes to.
+ *
+ * This process is not stepped, so the simulation can be warmed up
+ * further and forked again, or continued as the baseline.
+ *
+ * Since each variant starts from a bitwise copy, a continuation that
+ * changes nothing gives the same trajectory as continuing in place.
+ *
+ * Graphics can't be forked; use tgSimView, not tgSimViewGraphics.
+ * POSIX only.
+ */
+class StateFork
+{
+public:
+
+    /**
+     * Runs in the forked process. The object, and anything it refers
+     * to such as the tgSimulation and the controllers, is the child's
+     * copy, so it may change them freely.
+     */
+    class Continuation
+    {
+    public:
+        virtual ~Continuation() { }
+
+        /**
+         * Apply one variant and run the rest of the episode.
+         * @param[in] parameters one vector per controller, as in
+         * EvaluationFarm::Worker::evaluate
+         * @return the scores for the variant. Empty if it exploded
+         */
+        virtual std::vector<double>
+        run(const std::vector< std::vector<double> >& parameters) = 0;
+    };
+
+    /**
+     * @param[in] numProcesses variants run at once. 0 uses one per
+     * core, 1 runs them one after another
+     * @param[in] timeoutSeconds kill a variant that takes longer than
+     * this. 0 waits forever
+     * @throw std::invalid_argument if timeoutSeconds is negative
+     */
+    StateFork(std::size_t numProcesses = 0, double timeoutSeconds = 0.0);
+
+    ~StateFork();
+
+    /**
+     * Fork a continuation of the current state for each variant.
+     * Blocks until all are done.
+     * @param[in] continuation used in the children only
+     * @param[in] variants each is one vector of parameters per
+     * controller
+     * @return scores for each variant, in the same order. Empty for a
+     * variant that threw, crashed or timed out
+     * @throw std::runtime_error if a child can't be forked
+     */
+    std::vector< std::vector<double> >
+    run(Continuation& continuation,
+        const std::vector< std::vector< std::vector<double> > >& variants);
+
+    std::size_t getNumProcesses() const
+    {
+        return m_numProcesses;
+    }
+
+    /** Variants that threw, crashed or timed out so far */
+    std::size_t getNumFailures() const
+    {
+        return m_failures;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    StateFork(const StateFork&);
+
+    /** Disable the assignment operator. */
+    StateFork& operator=(const StateFork&);
+
+    struct Child
+    {
+        pid_t pid;
+        /// Read end of the pipe the child writes its scores to
+        int pipe;
+        /// Index of the variant it is running
+        std::size_t variant;
+        /// Seconds since the epoch when it was forked
+        double startTime;
+    };
+
+    /** Fork a child running variant, which never returns */
+    Child spawn(Continuation& continuation,
+                const std::vector< std::vector<double> >& parameters,
+                std::size_t variant,
+                const std::vector<Child>& running);
+
+    /** Kill if still running, close the pipe and reap */
+    void finish(Child& child, bool kill);
+
+    std::size_t m_numProcesses;
+
+    const double m_timeout;
+
+    std::size_t m_failures;
+};
+
+#endif /* STATE_FORK_H_ */
@@ -26,18 +26,17 @@
 #include "tgBlockField.h"
 // This library
 #include "core/tgBox.h"
+#include "core/tgRandomStream.h"
 #include "tgcreator/tgBuildSpec.h"
 #include "tgcreator/tgBoxInfo.h"
 #include "tgcreator/tgStructure.h"
 #include "tgcreator/tgStructureInfo.h"
 #include "tgcreator/tgNode.h"
-#include "tgcreator/tgUtil.h"
 // The Bullet Physics library
 #include "LinearMath/btVector3.h"
 // The C++ Standard Library
 #include <stdexcept>
 #include <vector>
-#include <numeric> // RAND_MAX
 
 tgBlockField::Config::Config(btVector3 origin,
                              btScalar friction, 
@@ -47,7 +46,8 @@ tgBlockField::Config::Config(btVector3 origin,
                              size_t nBlocks, 
                              double blockLength, 
                              double blockWidth, 
-                             double blockHeight) :
+                             double blockHeight,
+                             unsigned int seed) :
 m_origin(origin),
 m_friction(friction),
 m_restitution(restitution),
@@ -56,7 +56,8 @@ m_maxPos(maxPos),
 m_nBlocks(nBlocks),
 m_length(blockLength),
 m_width(blockWidth),
-m_height(blockHeight)
+m_height(blockHeight),
+m_seed(seed)
 {
     assert(m_friction >= 0.0);
     assert(m_restitution >= 0.0);
@@ -70,18 +71,12 @@ tgBlockField::tgBlockField() :
 tgModel(),
 m_config()
 {
-    // Seed the random number generator
-    /// @todo assess if doing this multiple times in a trial (here and evolution) causes problems
-    tgUtil::seedRandom(1);
 }
 
 tgBlockField::tgBlockField(tgBlockField::Config& config) :
 tgModel(),
 m_config(config)
 {
-    // Seed the random number generator
-    /// @todo assess if doing this multiple times in a trial (here and evolution) causes problems
-    tgUtil::seedRandom(1);
 }
 
 tgBlockField::~tgBlockField() {}
@@ -130,11 +125,12 @@ void tgBlockField::teardown() {
 void tgBlockField::addNodes(tgStructure& s) {
     
     btVector3 fieldSize = m_config.m_maxPos - m_config.m_minPos;
+    tgRandomStream random(m_config.m_seed);
     
     for(size_t i = 0; i < 2 * m_config.m_nBlocks; i += 2) {
-        double xOffset = fieldSize.getX() * rand() / RAND_MAX;
-        double yOffset = fieldSize.getY() * rand() / RAND_MAX;
-        double zOffset = fieldSize.getZ() * rand() / RAND_MAX;
+        double xOffset = fieldSize.getX() * random.uniform();
+        double yOffset = fieldSize.getY() * random.uniform();
+        double zOffset = fieldSize.getZ() * random.uniform();
         
         btVector3 offset(xOffset, yOffset, zOffset);
         
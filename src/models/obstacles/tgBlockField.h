@@ -59,7 +59,8 @@ public:
                     size_t nBlocks = 500,
                     double blockLength = 5.0,
                     double blockWidth = 5.0,
-                    double blockHeight = 5.0);
+                    double blockHeight = 5.0,
+                    unsigned int seed = 1);
 
             /** Origin position of the block field */
             btVector3 m_origin;
@@ -87,6 +88,12 @@ public:
             
             /** Height of the blocks */
             double m_height;
+
+            /**
+             * Seed of the tgRandomStream that places the blocks. The same
+             * seed gives the same field, without touching rand()
+             */
+            unsigned int m_seed;
     };
     
    /**
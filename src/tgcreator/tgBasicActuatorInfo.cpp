@@ -96,6 +96,9 @@ tgBulletSpringCable* tgBasicActuatorInfo::createTgBulletSpringCable()
 	tgBulletSpringCableAnchor* anchor2 = new tgBulletSpringCableAnchor(toBody, to);
 	anchorList.push_back(anchor2);
 	
-    return new tgBulletSpringCable(anchorList, m_config.stiffness, m_config.damping, m_config.pretension);
+    tgBulletSpringCable* const cable =
+        new tgBulletSpringCable(anchorList, m_config.stiffness, m_config.damping, m_config.pretension);
+    cable->setSleepThreshold(m_config.sleepThreshold);
+    return cable;
 }
     
@@ -79,6 +79,15 @@ public:
 
     double getMass();
 
+    /**
+     * Replace the config, for cables created or initialized from now on,
+     * such as the next instances of a tgStructurePrototype
+     */
+    void setConfig(const tgBasicActuator::Config& config)
+    {
+        m_config = config;
+    }
+
 protected:    
     
     tgBulletSpringCable* createTgBulletSpringCable();
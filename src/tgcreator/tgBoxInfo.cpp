@@ -104,14 +104,13 @@ btCollisionShape* tgBoxInfo::getCollisionShape(tgWorld& world) const
         const double width = m_config.width;
         const double height = m_config.height;
         const double length = getLength();
-        // Nominally x, y, z should we adjust here or the transform?
-        m_collisionShape =
-            new btBoxShape(btVector3(width, length / 2.0, height));
-    
-        // Add the collision shape to the array so we can delete it later
+        // Shared with every identical box, the world deletes it later
         tgWorldBulletPhysicsImpl& bulletWorld =
       (tgWorldBulletPhysicsImpl&)world.implementation();
-        bulletWorld.addCollisionShape(m_collisionShape);
+        // Nominally x, y, z should we adjust here or the transform?
+        m_collisionShape =
+            bulletWorld.getSharedShape(tgCollisionShapeCache::box,
+                                       btVector3(width, length / 2.0, height));
     }
     return m_collisionShape;
 }
@@ -29,6 +29,7 @@
 #include "tgPair.h"
 #include "tgPairs.h"
 #include "tgRigidInfo.h"
+#include "tgRigidNodeIndex.h"
 
 #include "core/tgTagSearch.h"
 
@@ -79,6 +80,17 @@ void tgConnectorInfo::chooseRigids(std::set<tgRigidInfo*> rigids)
     }
 }
 
+void tgConnectorInfo::chooseRigids(const tgRigidNodeIndex& index)
+{
+    if(getFromRigidInfo() == 0) { // if it hasn't already been set
+        setFromRigidInfo(chooseRigid(index, getFrom()));
+    }
+    
+    if(getToRigidInfo() == 0) { // if it hasn't already been set
+        setToRigidInfo(chooseRigid(index, getTo()));
+    }
+}
+
 tgRigidInfo* tgConnectorInfo::chooseRigid(std::set<tgRigidInfo*> rigids, const btVector3& v) {
 
     std::set<tgRigidInfo*> candidateRigids = findRigidsContaining(rigids, v);
@@ -95,6 +107,17 @@ tgRigidInfo* tgConnectorInfo::chooseRigid(std::set<tgRigidInfo*> rigids, const b
     return chosenRigid;
 };
 
+tgRigidInfo* tgConnectorInfo::chooseRigid(const tgRigidNodeIndex& index, const btVector3& v) {
+
+    const std::set<tgRigidInfo*> candidateRigids = index.findRigidsContaining(v);
+    
+    if (candidateRigids.size() == 1) {
+        return *(candidateRigids.begin());
+    }
+    // As with the scan, the closest center of mass breaks a tie
+    return findClosestCenterOfMass(candidateRigids, v);
+}
+
 btRigidBody* tgConnectorInfo::getToRigidBody() {
     return getToRigidInfo()->getRigidInfoGroup()->getRigidBody();
     //return m_toRigidBody;
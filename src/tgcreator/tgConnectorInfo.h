@@ -35,6 +35,7 @@ class tgPair;
 class tgPairs;
 class tgTagSearch;
 class tgRigidInfo;
+class tgRigidNodeIndex;
 class btRigidBody;
 class tgModel;
 class tgWorld;
@@ -157,8 +158,14 @@ public:
         chooseRigids(s);
     }
 
+
+    // Same as above, but each end is a hash lookup in index rather than a
+    // scan of every rigid. Used by tgStructureInfo.
+    virtual void chooseRigids(const tgRigidNodeIndex& index);
     
     tgRigidInfo* chooseRigid(std::set<tgRigidInfo*> rigids, const btVector3& v);
+
+    tgRigidInfo* chooseRigid(const tgRigidNodeIndex& index, const btVector3& v);
     
     
 protected:
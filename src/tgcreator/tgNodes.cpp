@@ -26,9 +26,117 @@
 
 #include "tgNodes.h"
 #include "tgPair.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cmath>
 
 tgPair tgNodes::pair(int from, int to, std::string tags)
 {
-    std::vector<tgNode>& nodes = getNodes();
+    // Unlike getNodes, getElements leaves the hash valid
+    const std::vector<tgNode>& nodes = getElements();
     return tgPair(nodes[from], nodes[to], tags);
 }
+
+namespace
+{
+    /**
+     * Edge of a hash cell, in the units of the structure. Nodes are
+     * usually much further apart, so most cells hold one node.
+     */
+    const double cellSize = 0.01;
+
+    /** A lookup spanning more cells than this checks every node instead */
+    const double maxCellsPerLookup = 64.0;
+}
+
+tgNodes::Cell tgNodes::cellOf(const btVector3& position)
+{
+    Cell c;
+    c.x = static_cast<long>(std::floor(position.x() / cellSize));
+    c.y = static_cast<long>(std::floor(position.y() / cellSize));
+    c.z = static_cast<long>(std::floor(position.z() / cellSize));
+    return c;
+}
+
+void tgNodes::rebuildHash() const
+{
+    m_hash.clear();
+    const std::vector<tgNode>& nodes = getNodes();
+    for (std::size_t i = 0; i < nodes.size(); i++)
+    {
+        m_hash[cellOf(nodes[i])].push_back(i);
+    }
+    m_hashValid = true;
+}
+
+int tgNodes::findNode(const btVector3& position, double tolerance) const
+{
+    const std::vector<int> found = findNodes(position, tolerance);
+    return found.empty() ? -1 : found[0];
+}
+
+std::vector<int> tgNodes::findNodes(const btVector3& position,
+                                    double tolerance) const
+{
+    if (tolerance < 0.0)
+    {
+        throw std::invalid_argument("Tolerance is negative");
+    }
+
+    const std::vector<tgNode>& nodes = getNodes();
+    const double tolerance2 = tolerance * tolerance;
+    std::vector<int> found;
+
+    const btVector3 margin(tolerance, tolerance, tolerance);
+    const Cell low = cellOf(position - margin);
+    const Cell high = cellOf(position + margin);
+    // In double, a large tolerance would overflow a long
+    const double numCells = (high.x - low.x + 1.0) *
+                            (high.y - low.y + 1.0) *
+                            (high.z - low.z + 1.0);
+    if (numCells > maxCellsPerLookup)
+    {
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            if ((nodes[i] - position).length2() <= tolerance2)
+            {
+                found.push_back(i);
+            }
+        }
+        return found;
+    }
+
+    if (!m_hashValid)
+    {
+        rebuildHash();
+    }
+
+    Cell c;
+    for (c.x = low.x; c.x <= high.x; c.x++)
+    {
+        for (c.y = low.y; c.y <= high.y; c.y++)
+        {
+            for (c.z = low.z; c.z <= high.z; c.z++)
+            {
+                CellMap::const_iterator it = m_hash.find(c);
+                if (it == m_hash.end())
+                {
+                    continue;
+                }
+                const std::vector<int>& indices = it->second;
+                for (std::size_t i = 0; i < indices.size(); i++)
+                {
+                    const btVector3& node = nodes[indices[i]];
+                    // An exact comparison when tolerance is 0
+                    if (tolerance == 0.0 ? node == position :
+                        (node - position).length2() <= tolerance2)
+                    {
+                        found.push_back(indices[i]);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+}
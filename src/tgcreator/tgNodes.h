@@ -34,6 +34,7 @@
 #include <set>
 #include <stdexcept>
 #include <sstream>
+#include <tr1/unordered_map>
 
 #include "tgNode.h"
 #include "core/tgTaggables.h"
@@ -43,6 +44,8 @@ class tgPair;
 /**
  * A node is an attachment point. The client identifies nodes with an integer
  * index or selects them using tags (see tgTaggable). 
+ * findNode looks a node up by position through a spatial hash, which is
+ * rebuilt on the first lookup after the nodes change.
  * @TODO: add error checking
  * @todo: move operator[] out of tgTaggables into here
  */
@@ -52,7 +55,8 @@ public:
     /**
      * Create an empty set of nodes.
      */
-    tgNodes() : tgTaggables()
+    tgNodes() : tgTaggables(),
+    m_hashValid(false)
     {
     }
 
@@ -62,7 +66,8 @@ public:
      * @author Lee Brownston
      * @date Wed 26 Feb 2014
      */
-    tgNodes(std::vector<btVector3>& nodes) : tgTaggables()
+    tgNodes(std::vector<btVector3>& nodes) : tgTaggables(),
+    m_hashValid(false)
     {
         // All elements must be unique
         assertUniqueElements("All nodes must be unique.");
@@ -74,7 +79,9 @@ public:
         
     }
      
-    tgNodes(std::vector<tgNode>& nodes) : tgTaggables(nodes) {
+    tgNodes(std::vector<tgNode>& nodes) : tgTaggables(nodes),
+    m_hashValid(false)
+    {
         // All elements must be unique
         assertUniqueElements("All nodes must be unique.");
         
@@ -95,11 +102,14 @@ public:
 
     void setNode(int key, const tgNode& node)
     {
+        m_hashValid = false;
         setElement(key, node);
     }
     
     std::vector<tgNode>& getNodes() 
     {
+        // The caller may move them
+        m_hashValid = false;
         return getElements();
     };
 
@@ -135,7 +145,47 @@ public:
     };
     
     int addNode(const tgNode& node) {
-        return addElement(node);
+        const int result = addElement(node);
+        if (m_hashValid)
+        {
+            // Cheaper than rehashing, so lookups can be mixed with adds
+            m_hash[cellOf(node)].push_back(size() - 1);
+        }
+        return result;
+    }
+
+    /** As addNode, keeps the hash */
+    tgNodes& operator+=(const tgNode& node)
+    {
+        addNode(node);
+        return *this;
+    }
+
+    tgNodes& operator+=(const std::vector<tgNode*>& nodes)
+    {
+        for (std::size_t i = 0; i < nodes.size(); i++)
+        {
+            addNode(*nodes[i]);
+        }
+        return *this;
+    }
+
+    /**
+     * Remove every node equal to node. The later nodes move down, so the
+     * hash is rebuilt on the next lookup.
+     */
+    tgNodes& operator-=(const tgNode& node)
+    {
+        m_hashValid = false;
+        removeElement(node);
+        return *this;
+    }
+
+    tgNodes& operator-=(const std::vector<tgNode*>& nodes)
+    {
+        m_hashValid = false;
+        removeElements(nodes);
+        return *this;
     }
 
     /**
@@ -167,6 +217,62 @@ public:
      */
     tgPair pair(int from, int to, std::string tags = "");
 
+    /**
+     * Return the node indexed by key, which may be moved through the
+     * reference.
+     * @param[in] key an int
+     * @throw std::out_of_range if key is out of range
+     */
+    tgNode& operator[](int key)
+    {
+        m_hashValid = false;
+        return tgTaggables<tgNode>::operator[](key);
+    }
+
+    const tgNode& operator[](int key) const
+    {
+        return tgTaggables<tgNode>::operator[](key);
+    }
+
+    /** As tgTaggables::find, the nodes may be moved through the pointers */
+    std::vector<tgNode*> find(std::string tags)
+    {
+        m_hashValid = false;
+        return tgTaggables<tgNode>::find(tags);
+    }
+
+    std::vector<tgNode*> findAll()
+    {
+        m_hashValid = false;
+        return tgTaggables<tgNode>::findAll();
+    }
+
+    std::vector<tgNode*> findUntagged()
+    {
+        m_hashValid = false;
+        return tgTaggables<tgNode>::findUntagged();
+    }
+
+    /**
+     * Look a node up by position. The first call after the nodes change
+     * hashes them all, later calls only check the nodes near position.
+     * @param[in] position where to look
+     * @param[in] tolerance how far from position a node may be, 0 to
+     * only match a node equal to position
+     * @return the lowest index of a node within tolerance of position,
+     * -1 if there is none
+     */
+    int findNode(const btVector3& position, double tolerance = 0.0) const;
+
+    /**
+     * Every node within tolerance of position, lowest index first.
+     * @param[in] position where to look
+     * @param[in] tolerance how far from position a node may be, 0 to
+     * only match nodes equal to position
+     */
+    std::vector<int> findNodes(const btVector3& position,
+                               double tolerance = 0.0) const;
+
     /**
      * Add the given btVector3 to all btVector3 objects in elements.
      * @param[in] offset a btVector3 to add to all the btVector3 objects in m_nodes
@@ -175,6 +281,7 @@ public:
     void move(const btVector3& offset)
     {
         /// @todo use std::for_each()
+        m_hashValid = false;
         std::vector<tgNode>& nodes = getElements();
         for(std::size_t i = 0; i < nodes.size(); i++) {
             nodes[i] += offset;
@@ -183,6 +290,7 @@ public:
 
     void moveNode(int idx, const btVector3 offset)
     {
+        // Invalidates the hash
         (*this)[idx] += offset;
     }
     
@@ -213,6 +321,44 @@ public:
     }
     
 protected:
+
+    /** The cell a position falls in, see m_hash */
+    struct Cell
+    {
+        long x;
+        long y;
+        long z;
+
+        bool operator==(const Cell& other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& c) const
+        {
+            // Large primes, as in Teschner et al. 2003. Unsigned, so
+            // the products wrap instead of overflowing.
+            return (static_cast<std::size_t>(c.x) * 73856093u) ^
+                   (static_cast<std::size_t>(c.y) * 19349663u) ^
+                   (static_cast<std::size_t>(c.z) * 83492791u);
+        }
+    };
+
+    typedef std::tr1::unordered_map<Cell, std::vector<int>, CellHash> CellMap;
+
+    static Cell cellOf(const btVector3& position);
+
+    /** Hash every node, see findNode */
+    void rebuildHash() const;
+
+    /** The indices of the nodes in each occupied cell, in order */
+    mutable CellMap m_hash;
+
+    /** False once the nodes may have changed since m_hash was built */
+    mutable bool m_hashValid;
     
     // A map of m_nodes keys to names. Note that not all m_nodes will have names.
     std::map<int, std::string> m_names;  // @todo: remove this...
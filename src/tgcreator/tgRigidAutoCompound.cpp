@@ -28,6 +28,7 @@
 
 #include "BulletSoftBody/btSoftRigidDynamicsWorld.h"
 #include "tgCompoundRigidInfo.h"
+#include "tgRigidNodeIndex.h"
 #include <map>
 
 // Debugging
@@ -80,48 +81,39 @@ void tgRigidAutoCompound::setRigidInfoForGroup(tgRigidInfo* rigidInfo, std::dequ
 
 void tgRigidAutoCompound::groupRigids()
 {
-    std::deque<tgRigidInfo*> ungrouped = std::deque<tgRigidInfo*>(m_rigids); // Copy of m_rigids
-
-    while(ungrouped.size() > 0) {
-        // go through each ungrouped element and find the groups for it
-        tgRigidInfo* elem = ungrouped[0]; // Note: the 0 element is removed by findGroup, so ungrouped[0] is different each iteration
-
-        // Find all elements linked to the first item in ungrouped
-        // This will also remove the elements in the group from ungrouped
-        std::deque<tgRigidInfo*> group = findGroup(elem, ungrouped);
-
-        // Add the group to the groups list
-        m_groups.push_back(group);            
+    const std::vector<tgRigidInfo*> rigids(m_rigids.begin(), m_rigids.end());
+    const tgRigidNodeIndex index(rigids);
+    std::vector<bool> grouped(rigids.size(), false);
+
+    // Each rigid that isn't grouped yet starts a group with everything
+    // linked to it
+    for (std::size_t i = 0; i < rigids.size(); i++) {
+        if (!grouped[i]) {
+            std::deque<tgRigidInfo*> group;
+            findGroup(i, index, grouped, group);
+            m_groups.push_back(group);
+        }
     }
 }
 
-// Find all rigids that should be in a group with the given rigid
-// @todo: This may contain an off-by-one error (the last rigid may not be grouped properly...)
-std::deque<tgRigidInfo*> tgRigidAutoCompound::findGroup(tgRigidInfo* rigid, std::deque<tgRigidInfo*>& ungrouped) {
-
-    std::deque<tgRigidInfo*> group;
-
-    // Add the rigid to the current group
-    group.push_back(rigid);     
-    
-    // Remove the rigid from the ungrouped since it's now in a group
-    ungrouped.erase(std::remove(ungrouped.begin(), ungrouped.end(), rigid), ungrouped.end());
-    
-    // Recursively find linked elements
-    int i = 0;
-    while(i < ungrouped.size()) {
-        tgRigidInfo* other = ungrouped[i];
-        if(rigid->sharesNodesWith(*other)) {
-            std::deque<tgRigidInfo*> links = findGroup(other, ungrouped);
-            group.insert(group.end(), links.begin(), links.end());
-            i = 0;
-        } else {
-            i++;
+// Find all rigids that should be in a group with the given rigid. Linked
+// rigids are visited lowest index first, the order the pairwise scan
+// this replaced found them in, so compounds are built identically.
+void tgRigidAutoCompound::findGroup(std::size_t rigid,
+                                    const tgRigidNodeIndex& index,
+                                    std::vector<bool>& grouped,
+                                    std::deque<tgRigidInfo*>& group) {
+
+    group.push_back(index.getRigids()[rigid]);
+    grouped[rigid] = true;
+
+    const std::vector<std::size_t> neighbors = index.findNeighbors(rigid);
+    for (std::size_t i = 0; i < neighbors.size(); i++) {
+        if (!grouped[neighbors[i]]) {
+            findGroup(neighbors[i], index, grouped, group);
         }
     }
-
-    return group;
-};
+}
     
 void tgRigidAutoCompound::createCompounds() {
     for(int i=0; i < m_groups.size(); i++) {
@@ -27,10 +27,12 @@
 #ifndef TG_RIGID_AUTO_COMPOUND_H
 #define TG_RIGID_AUTO_COMPOUND_H
 
+#include <cstddef>
 #include <vector>
 #include <deque>
 
 class tgRigidInfo;
+class tgRigidNodeIndex;
 class btCollisionObject;
 class btRigidBody;
 
@@ -65,9 +67,12 @@ protected:
     
     void groupRigids();
 
-    // Find all rigids that should be in a group with the given rigid
-    // @todo: This may contain an off-by-one error (the last rigid may not be grouped properly...)
-    std::deque<tgRigidInfo*> findGroup(tgRigidInfo* rigid, std::deque<tgRigidInfo*>& ungrouped);
+    // Add a rigid, given by its position in index.getRigids(), and every
+    // rigid linked to it that isn't grouped yet to group
+    void findGroup(std::size_t rigid,
+                   const tgRigidNodeIndex& index,
+                   std::vector<bool>& grouped,
+                   std::deque<tgRigidInfo*>& group);
         
     void createCompounds();
     
@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRigidNodeIndex.cpp
+ * @brief Implementation of class tgRigidNodeIndex
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgRigidNodeIndex.h"
+// This library
+#include "tgRigidInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btScalar.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <algorithm>
+#include <cassert>
+
+tgRigidNodeIndex::tgRigidNodeIndex(const std::vector<tgRigidInfo*>& rigids) :
+m_rigids(rigids),
+m_nodeIndices(rigids.size())
+{
+    for (std::size_t i = 0; i < m_rigids.size(); i++)
+    {
+        tgRigidInfo* const pRigid = m_rigids[i];
+        assert(pRigid != NULL);
+        const std::set<btVector3> contained = pRigid->getContainedNodes();
+        for (std::set<btVector3>::const_iterator it = contained.begin();
+             it != contained.end();
+             ++it)
+        {
+            // Exact, as in tgRigidInfo::sharesNodesWith
+            int node = m_nodes.findNode(*it);
+            if (node < 0)
+            {
+                m_nodes.addNode(*it);
+                node = m_nodes.size() - 1;
+                m_rigidsAtNode.push_back(std::vector<std::size_t>());
+            }
+            m_nodeIndices[i].push_back(node);
+            m_rigidsAtNode[node].push_back(i);
+        }
+    }
+    assert(m_rigidsAtNode.size() == static_cast<std::size_t>(m_nodes.size()));
+}
+
+tgRigidNodeIndex::~tgRigidNodeIndex()
+{
+}
+
+std::set<tgRigidInfo*>
+tgRigidNodeIndex::findRigidsContaining(const btVector3& position) const
+{
+    std::set<tgRigidInfo*> found;
+    // Rods and boxes match a node within fuzzyZero of it, so look that
+    // far and let containsNode decide
+    const std::vector<int> nodes = m_nodes.findNodes(position, SIMD_EPSILON);
+    for (std::size_t i = 0; i < nodes.size(); i++)
+    {
+        const std::vector<std::size_t>& rigids = m_rigidsAtNode[nodes[i]];
+        for (std::size_t j = 0; j < rigids.size(); j++)
+        {
+            tgRigidInfo* const pRigid = m_rigids[rigids[j]];
+            if (pRigid->containsNode(position))
+            {
+                found.insert(pRigid);
+            }
+        }
+    }
+    return found;
+}
+
+std::vector<std::size_t> tgRigidNodeIndex::findNeighbors(std::size_t i) const
+{
+    std::vector<std::size_t> neighbors;
+    const std::vector<int>& nodes = m_nodeIndices[i];
+    for (std::size_t j = 0; j < nodes.size(); j++)
+    {
+        const std::vector<std::size_t>& rigids = m_rigidsAtNode[nodes[j]];
+        for (std::size_t k = 0; k < rigids.size(); k++)
+        {
+            if (rigids[k] != i)
+            {
+                neighbors.push_back(rigids[k]);
+            }
+        }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                    neighbors.end());
+    return neighbors;
+}
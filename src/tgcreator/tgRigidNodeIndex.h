@@ -0,0 +1,111 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgRigidNodeIndex.h
+ * @brief Definition of class tgRigidNodeIndex
+ * @author agent
+ * $Id$
+ */
+
+#ifndef TG_RIGID_NODE_INDEX_H
+#define TG_RIGID_NODE_INDEX_H
+
+// This library
+#include "tgNodes.h"
+// The C++ Standard Library
+#include <cstddef>
+#include <map>
+#include <set>
+#include <vector>
+
+// Forward declarations
+class btVector3;
+class tgRigidInfo;
+
+/**
+ * Indexes the nodes of a set of rigids for the build. Every distinct
+ * position returned by tgRigidInfo::getContainedNodes becomes a node of
+ * a tgNodes, and each rigid carries the indices of its own nodes, so
+ * finding the rigids at a position or the rigids that share a node is a
+ * hash lookup rather than a scan of every rigid.
+ *
+ * The rigids must not move while the index is in use.
+ */
+class tgRigidNodeIndex
+{
+public:
+
+    /**
+     * Index the contained nodes of every rigid
+     * @param[in] rigids not owned, in the order the lookups return them
+     */
+    explicit tgRigidNodeIndex(const std::vector<tgRigidInfo*>& rigids);
+
+    ~tgRigidNodeIndex();
+
+    /**
+     * The rigids whose containsNode is true for position, as
+     * tgConnectorInfo::findRigidsContaining would find them by scanning.
+     */
+    std::set<tgRigidInfo*> findRigidsContaining(const btVector3& position) const;
+
+    /**
+     * The positions of the rigids in the constructor's vector that share
+     * a node with the rigid at position i, as tgRigidInfo::sharesNodesWith
+     * would find them, in ascending order and excluding i.
+     */
+    std::vector<std::size_t> findNeighbors(std::size_t i) const;
+
+    /** The indices into getNodes of the nodes of the rigid at position i */
+    const std::vector<int>& getNodeIndices(std::size_t i) const
+    {
+        return m_nodeIndices[i];
+    }
+
+    /** Every distinct contained node */
+    const tgNodes& getNodes() const
+    {
+        return m_nodes;
+    }
+
+    const std::vector<tgRigidInfo*>& getRigids() const
+    {
+        return m_rigids;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgRigidNodeIndex(const tgRigidNodeIndex&);
+
+    /** Disable the assignment operator. */
+    tgRigidNodeIndex& operator=(const tgRigidNodeIndex&);
+
+    const std::vector<tgRigidInfo*> m_rigids;
+
+    tgNodes m_nodes;
+
+    /** The nodes of each rigid, parallel to m_rigids */
+    std::vector< std::vector<int> > m_nodeIndices;
+
+    /** The positions in m_rigids of the rigids at each node */
+    std::vector< std::vector<std::size_t> > m_rigidsAtNode;
+};
+
+#endif // TG_RIGID_NODE_INDEX_H
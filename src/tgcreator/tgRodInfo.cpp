@@ -102,13 +102,13 @@ btCollisionShape* tgRodInfo::getCollisionShape(tgWorld& world) const
     {
         const double radius = m_config.radius;
         const double length = getLength();
-        m_collisionShape =
-            new btCylinderShape(btVector3(radius, length / 2.0, radius));
     
-        // Add the collision shape to the array so we can delete it later
+        // Shared with every identical rod, the world deletes it later
         tgWorldBulletPhysicsImpl& bulletWorld =
       (tgWorldBulletPhysicsImpl&)world.implementation();
-        bulletWorld.addCollisionShape(m_collisionShape);
+        m_collisionShape =
+            bulletWorld.getSharedShape(tgCollisionShapeCache::cylinder,
+                                       btVector3(radius, length / 2.0, radius));
     }
     return m_collisionShape;
 }
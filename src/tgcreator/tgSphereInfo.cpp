@@ -102,13 +102,13 @@ btCollisionShape* tgSphereInfo::getCollisionShape(tgWorld& world) const
     if (m_collisionShape == NULL) 
     {
         const double radius = m_config.radius;
-        m_collisionShape =
-            new btSphereShape(radius);
     
-        // Add the collision shape to the array so we can delete it later
+        // Shared with every identical sphere, the world deletes it later
         tgWorldBulletPhysicsImpl& bulletWorld =
       (tgWorldBulletPhysicsImpl&)world.implementation();
-        bulletWorld.addCollisionShape(m_collisionShape);
+        m_collisionShape =
+            bulletWorld.getSharedShape(tgCollisionShapeCache::sphere,
+                                       btVector3(radius, radius, radius));
     }
     return m_collisionShape;
 }
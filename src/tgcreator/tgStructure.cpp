@@ -31,18 +31,43 @@
 #include "tgPair.h"
 // The Bullet Physics library
 #include <LinearMath/btQuaternion.h>
+#include <LinearMath/btTransform.h>
 #include <LinearMath/btVector3.h>
  
-tgStructure::tgStructure() : tgTaggable() 
+tgStructure::tgStructure() : tgTaggable(),
+m_geometry(new Geometry()),
+m_transformed(false),
+m_pParent(NULL)
 {
+    m_transform.setIdentity();
 }
 
-tgStructure::tgStructure(const tgTags& tags) : tgTaggable(tags)
+tgStructure::tgStructure(const tgTags& tags) : tgTaggable(tags),
+m_geometry(new Geometry()),
+m_transformed(false),
+m_pParent(NULL)
 {
+    m_transform.setIdentity();
 }
 
-tgStructure::tgStructure(const std::string& space_separated_tags) : tgTaggable(space_separated_tags)
+tgStructure::tgStructure(const std::string& space_separated_tags) : tgTaggable(space_separated_tags),
+m_geometry(new Geometry()),
+m_transformed(false),
+m_pParent(NULL)
 {
+    m_transform.setIdentity();
+}
+
+tgStructure::tgStructure(const tgStructure& other) : tgTaggable(other.getTags()),
+m_pParent(NULL)
+{
+    // The copy has no parent, so it must start from other's world positions
+    other.applyAncestors();
+    m_geometry = other.m_geometry;
+    m_transform = other.m_transform;
+    m_transformed = other.m_transformed;
+    m_pending = other.m_pending;
+    copyChildren(other);
 }
 
 tgStructure::~tgStructure()
@@ -53,28 +78,176 @@ tgStructure::~tgStructure()
     }
 }
 
+tgStructure& tgStructure::operator=(const tgStructure& other)
+{
+    if (this != &other)
+    {
+        tgStructure copy(other);
+        // Our ancestors keep applying to us, so they must have nothing pending
+        applyAncestors();
+        getTags() = other.getTags();
+        m_geometry.swap(copy.m_geometry);
+        m_transform = copy.m_transform;
+        m_transformed = copy.m_transformed;
+        m_pending.swap(copy.m_pending);
+        // The copy deletes our old children
+        m_children.swap(copy.m_children);
+        for (std::size_t i = 0; i < m_children.size(); ++i)
+        {
+            m_children[i]->m_pParent = this;
+        }
+    }
+    return *this;
+}
+
+void tgStructure::copyChildren(const tgStructure& other)
+{
+    for (std::size_t i = 0; i < other.m_children.size(); ++i)
+    {
+        const tgStructure& child = *other.m_children[i];
+        // Not the copy constructor, which would apply other's transform
+        tgStructure * const pCopy = new tgStructure(child.getTags());
+        pCopy->m_geometry = child.m_geometry;
+        pCopy->m_transform = child.m_transform;
+        pCopy->m_transformed = child.m_transformed;
+        pCopy->m_pending = child.m_pending;
+        pCopy->m_pParent = this;
+        pCopy->copyChildren(child);
+        m_children.push_back(pCopy);
+    }
+}
+
+void tgStructure::makeUnique() const
+{
+    if (!m_geometry.unique())
+    {
+        m_geometry.reset(new Geometry(*m_geometry));
+    }
+}
+
+void tgStructure::compose(const btTransform& transform) const
+{
+    if (m_transformed)
+    {
+        m_transform = transform * m_transform;
+    }
+    else
+    {
+        m_transform = transform;
+        m_transformed = true;
+    }
+
+    if (m_children.empty())
+    {
+        return;
+    }
+    else if (!m_pending.empty() &&
+             m_pending.back().numChildren == m_children.size())
+    {
+        m_pending.back().transform = transform * m_pending.back().transform;
+    }
+    else
+    {
+        Pending pending;
+        pending.numChildren = m_children.size();
+        pending.transform = transform;
+        m_pending.push_back(pending);
+    }
+}
+
+void tgStructure::pushToChildren() const
+{
+    // Child i gets everything from the first entry made once it was added
+    btTransform suffix;
+    suffix.setIdentity();
+    for (std::size_t j = m_pending.size(); j-- > 0; )
+    {
+        suffix = suffix * m_pending[j].transform;
+        const std::size_t first = (j > 0) ? m_pending[j - 1].numChildren : 0;
+        for (std::size_t i = first; i < m_pending[j].numChildren; ++i)
+        {
+            tgStructure * const pStructure = m_children[i];
+            assert(pStructure != NULL);
+            pStructure->compose(suffix);
+        }
+    }
+    m_pending.clear();
+}
+
+void tgStructure::applyAncestors() const
+{
+    if (m_pParent != NULL)
+    {
+        m_pParent->applyAncestors();
+        m_pParent->pushToChildren();
+    }
+}
+
+void tgStructure::flatten() const
+{
+    applyAncestors();
+    if (!m_transformed)
+    {
+        return;
+    }
+
+    makeUnique();
+    std::vector<tgNode>& nodes = m_geometry->nodes.getNodes();
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        btVector3& position = nodes[i];
+        position = m_transform(position);
+    }
+    std::vector<tgPair>& pairs = m_geometry->pairs.getPairs();
+    for (std::size_t i = 0; i < pairs.size(); ++i)
+    {
+        pairs[i].getFrom() = m_transform(pairs[i].getFrom());
+        pairs[i].getTo() = m_transform(pairs[i].getTo());
+    }
+
+    m_transform.setIdentity();
+    m_transformed = false;
+}
+
+void tgStructure::addTransform(const btTransform& transform)
+{
+    // Our ancestors' pending transforms happened first
+    applyAncestors();
+    compose(transform);
+}
+
 void tgStructure::addNode(double x, double y, double z, std::string tags)
 {
-    m_nodes.addNode(x, y, z, tags);
+    flatten();
+    makeUnique();
+    m_geometry->nodes.addNode(x, y, z, tags);
 }
 
 void tgStructure::addNode(tgNode& newNode)
 {
-    m_nodes.addNode(newNode);
+    flatten();
+    makeUnique();
+    m_geometry->nodes.addNode(newNode);
 }
 
 void tgStructure::addPair(int fromNodeIdx, int toNodeIdx, std::string tags)
 {
-    addPair(m_nodes[fromNodeIdx], m_nodes[toNodeIdx], tags);
+    const tgNodes& nodes = getNodes();
+    // Copies, since adding may copy the geometry
+    const btVector3 from = nodes[fromNodeIdx];
+    const btVector3 to = nodes[toNodeIdx];
+    addPair(from, to, tags);
 }
 
 void tgStructure::addPair(const btVector3& from, const btVector3& to, std::string tags)
 {
+    flatten();
     // @todo: do we need to pass in tags here? might be able to save some proc time if not...
     tgPair p = tgPair(from, to);
-    if (!m_pairs.contains(p))
+    if (!m_geometry->pairs.contains(p))
     {
-        m_pairs.addPair(tgPair(from, to, tags));
+        makeUnique();
+        m_geometry->pairs.addPair(tgPair(from, to, tags));
     }
     else
     {
@@ -86,14 +259,7 @@ void tgStructure::addPair(const btVector3& from, const btVector3& to, std::strin
 
 void tgStructure::move(const btVector3& offset)
 {
-    m_nodes.move(offset);
-    m_pairs.move(offset);
-    for (size_t i = 0; i < m_children.size(); ++i)
-    {
-        tgStructure * const pStructure = m_children[i];
-    assert(pStructure != NULL);
-        pStructure->move(offset);
-    }
+    addTransform(btTransform(btQuaternion::getIdentity(), offset));
 }
 
 void tgStructure::addRotation(const btVector3& fixedPoint,
@@ -116,15 +282,10 @@ void tgStructure::addRotation(const btVector3& fixedPoint,
 void tgStructure::addRotation(const btVector3& fixedPoint,
                  const btQuaternion& rotation)
 {
-    m_nodes.addRotation(fixedPoint, rotation);
-    m_pairs.addRotation(fixedPoint, rotation);
-
-    for (std::size_t i = 0; i < m_children.size(); ++i)
-    {
-        tgStructure * const pStructure = m_children[i];
-    assert(pStructure != NULL);
-        pStructure->addRotation(fixedPoint, rotation);
-    }
+    // Rotate about fixedPoint rather than the origin
+    btTransform transform(rotation);
+    transform.setOrigin(fixedPoint - transform.getBasis() * fixedPoint);
+    addTransform(transform);
 }
 
 void tgStructure::addChild(tgStructure* pChild)
@@ -135,6 +296,10 @@ void tgStructure::addChild(tgStructure* pChild)
     /// structure may build the pairs, while another may not depending on its tags.
     if (pChild != NULL)
     {
+        // Only moves from now on apply to the child, which m_pending
+        // takes care of for ours but not for our ancestors'
+        applyAncestors();
+        pChild->m_pParent = this;
         m_children.push_back(pChild);
     }
 }
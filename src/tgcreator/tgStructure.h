@@ -32,9 +32,12 @@
 #include "tgPairs.h"
 // The NTRT Core Library
 #include "core/tgTaggable.h"
+// The Bullet Physics library
+#include "LinearMath/btTransform.h"
 // The C++ Standard Library
 #include <string>
 #include <vector>
+#include <tr1/memory>
 
 // Forward declarations
 class btQuaternion;
@@ -49,6 +52,15 @@ class tgTags;
  * create physical representations of the structures with rods, muscles, etc.
  * Note that tags can be anything you want -- you'll specify the tags that you 
  * want to use to build things like rods or muscles during the build phase.
+ *
+ * Moves and rotations are not applied to the nodes straight away. Each
+ * structure composes them into a pending transform, which is only applied
+ * (and pushed down to the children) when its nodes or pairs are read, at
+ * the latest when a tgStructureInfo builds it. Copies share their nodes and
+ * pairs until one of them is read after moving or is added to, so cloning
+ * and placing a segment many times is cheap. Read positions back with
+ * getNodes rather than recomputing them by hand: a composed transform can
+ * round the last bit differently from applying the moves one by one.
  */
 class tgStructure : public tgTaggable
 {
@@ -60,8 +72,16 @@ public:
 
     tgStructure(const std::string& space_separated_tags);
 
+    /**
+     * Copies the children too. The nodes and pairs are shared with other
+     * until either is changed.
+     */
+    tgStructure(const tgStructure& other);
+
     virtual ~tgStructure();
 
+    tgStructure& operator=(const tgStructure& other);
+
     /**
      * Add a node using x, y, and z (just for convenience)
      */
@@ -83,6 +103,10 @@ public:
      */
     void addPair(const btVector3& from, const btVector3& to, std::string tags = "");
 
+    /**
+     * Takes constant time in the size of the structure. The offset is
+     * applied when the nodes are next read.
+     */
     void move(const btVector3& offset);
     
     /**
@@ -100,29 +124,31 @@ public:
              const btQuaternion& rotation);
 
     /**
-     * Add a child structure. Note that this will be copied rather than
-     * being a reference or a pointer.
+     * Add a child structure. We take ownership of the pointer. Moves
+     * and rotations of this structure apply to the child from now on.
      */
     void addChild(tgStructure* child);    
 
     /**
-     * Get all of our nodes
+     * Get all of our nodes, with every move and rotation applied
      * Note: This only includes nodes owned by this structure. use 'findNodes'
      * to search child nodes as well.
      */
     const tgNodes& getNodes() const
     {
-        return m_nodes;
+        flatten();
+        return m_geometry->nodes;
     }
 
     /**
-     * Get all of our pairs
+     * Get all of our pairs, with every move and rotation applied
      * Note: This only includes nodes owned by this structure. Use 'findPairs' 
      * to search child nodes as well. 
      */
     const tgPairs& getPairs() const
     {
-        return m_pairs;
+        flatten();
+        return m_geometry->pairs;
     }
 	
     /**
@@ -135,9 +161,61 @@ public:
 
 private:
 
-    tgNodes m_nodes;
+    /** The nodes and pairs, which copies share until one changes */
+    struct Geometry
+    {
+        tgNodes nodes;
+        tgPairs pairs;
+    };
+
+    /**
+     * Moves and rotations made while we had numChildren children. They
+     * apply to those children only, so adding a child doesn't have to
+     * apply what is pending to the ones we already have.
+     */
+    struct Pending
+    {
+        std::size_t numChildren;
+        btTransform transform;
+    };
+
+    /** Apply transform after everything pending here and in our ancestors */
+    void addTransform(const btTransform& transform);
+
+    /** Apply transform after everything pending, to us and our children */
+    void compose(const btTransform& transform) const;
+
+    /** Apply our ancestors' pending transforms down to us */
+    void applyAncestors() const;
+
+    /**
+     * Apply every pending transform to m_geometry, so it holds world
+     * positions. The children keep theirs pending.
+     */
+    void flatten() const;
+
+    /** Compose m_pending into each child's transforms */
+    void pushToChildren() const;
+
+    /** Make m_geometry ours alone before changing it */
+    void makeUnique() const;
+
+    /** Copy other's children, sharing their geometry */
+    void copyChildren(const tgStructure& other);
+
+    mutable std::tr1::shared_ptr<Geometry> m_geometry;
+
+    /** Moves and rotations not applied to m_geometry yet */
+    mutable btTransform m_transform;
+
+    /** False while m_transform is the identity */
+    mutable bool m_transformed;
+
+    /** Moves and rotations not applied to the children yet, oldest first */
+    mutable std::vector<Pending> m_pending;
 
-    tgPairs m_pairs;
+    /** The structure we are a child of, NULL for the root */
+    tgStructure* m_pParent;
 
     // we own these
     std::vector<tgStructure*> m_children;
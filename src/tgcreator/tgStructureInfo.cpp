@@ -30,6 +30,7 @@
 #include "tgBuildSpec.h"
 #include "tgConnectorInfo.h"
 #include "tgRigidAutoCompound.h"
+#include "tgRigidNodeIndex.h"
 #include "tgStructure.h"
 #include "core/tgWorld.h"
 #include "core/tgModel.h"
@@ -213,16 +214,17 @@ void tgStructureInfo::initConnectorInfo()
 
 void tgStructureInfo::chooseConnectorRigids()
 {
-    chooseConnectorRigids(getAllRigids());
+    const tgRigidNodeIndex index(getAllRigids());
+    chooseConnectorRigids(index);
 }
 
-void tgStructureInfo::chooseConnectorRigids(std::vector<tgRigidInfo*> allRigids)
+void tgStructureInfo::chooseConnectorRigids(const tgRigidNodeIndex& index)
 {
     for (std::size_t i = 0; i < m_connectors.size(); i++)
     {
         tgConnectorInfo * const pConnectorInfo = m_connectors[i];
     assert(pConnectorInfo != NULL);
-        pConnectorInfo->chooseRigids(allRigids);
+        pConnectorInfo->chooseRigids(index);
     }    
 
     // Children
@@ -230,7 +232,7 @@ void tgStructureInfo::chooseConnectorRigids(std::vector<tgRigidInfo*> allRigids)
     {
         tgStructureInfo * const pStructureInfo = m_children[i];
     assert(pStructureInfo != NULL);
-        pStructureInfo->chooseConnectorRigids(allRigids);
+        pStructureInfo->chooseConnectorRigids(index);
     }
 }
 
@@ -38,6 +38,7 @@ class tgBuildSpec;
 class tgConnectorInfo;
 class tgModel;
 class tgRigidInfo;
+class tgRigidNodeIndex;
 class tgStructure;
 class tgWorld;
 
@@ -50,6 +51,9 @@ class tgStructureInfo : public tgTaggable
 
     friend std::ostream& operator<<(std::ostream& os, const tgStructureInfo& obj);
 
+    // Runs the build steps separately so they can be repeated
+    friend class tgStructurePrototype;
+
 public:
 
     tgStructureInfo(tgStructure& structure, tgBuildSpec& buildSpec);
@@ -80,7 +84,9 @@ private:
     
     void chooseConnectorRigids();
 
-    void chooseConnectorRigids(std::vector<tgRigidInfo*> allRigids);
+    // Every connector looks its rigids up in index, built once from all
+    // rigids
+    void chooseConnectorRigids(const tgRigidNodeIndex& index);
     
     void initRigidBodies(tgWorld& world);
     
@@ -0,0 +1,187 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgStructurePrototype.cpp
+ * @brief Implementation of class tgStructurePrototype
+ * @author agent
+ * $Id$
+ */
+
+// This module
+#include "tgStructurePrototype.h"
+// This library
+#include "tgRigidInfo.h"
+#include "tgStructureInfo.h"
+// The NTRT core library
+#include "core/tgBulletUtil.h"
+#include "core/tgCast.h"
+#include "core/tgWorld.h"
+#include "core/tgWorldBulletPhysicsImpl.h"
+// The Bullet Physics library
+#include "BulletCollision/CollisionShapes/btCollisionShape.h"
+#include "BulletCollision/CollisionShapes/btCompoundShape.h"
+#include "BulletDynamics/Dynamics/btDynamicsWorld.h"
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btMotionState.h"
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btTransform.h"
+// The C++ Standard Library
+#include <cassert>
+#include <set>
+
+tgStructurePrototype::tgStructurePrototype(tgStructure& structure,
+                                           tgBuildSpec& buildSpec) :
+m_pInfo(new tgStructureInfo(structure, buildSpec)),
+m_numInstances(0)
+{
+    // The global steps of tgStructureInfo::buildInto
+    m_pInfo->initRigidInfo();
+    m_pInfo->autoCompoundRigids();
+    m_pInfo->initConnectorInfo();
+    m_pInfo->chooseConnectorRigids();
+}
+
+tgStructurePrototype::~tgStructurePrototype()
+{
+    // Identical rigids share shapes, so delete each once
+    std::set<btCollisionShape*> shapes;
+    for (std::size_t i = 0; i < m_shapes.size(); i++)
+    {
+        collectShapes(m_shapes[i], shapes);
+    }
+    for (std::set<btCollisionShape*>::iterator it = shapes.begin();
+         it != shapes.end();
+         ++it)
+    {
+        delete *it;
+    }
+    delete m_pInfo;
+}
+
+void tgStructurePrototype::instantiate(tgModel& model, tgWorld& world)
+{
+#ifndef BT_NO_PROFILE 
+    BT_PROFILE("tgStructurePrototype::instantiate");
+#endif //BT_NO_PROFILE
+
+    clearInstance();
+
+    // Shapes are already cached in the infos after the first instance
+    m_pInfo->initRigidBodies(world);
+    m_pInfo->initConnectors(world);
+    m_pInfo->buildIntoHelper(model, world, *m_pInfo);
+
+    if (m_numInstances == 0)
+    {
+        adoptShapes(world);
+    }
+    m_numInstances++;
+}
+
+void tgStructurePrototype::instantiate(tgModel& model, tgWorld& world,
+                                       const btTransform& transform)
+{
+    instantiate(model, world);
+
+    btDynamicsWorld& dynamicsWorld = tgBulletUtil::worldToDynamicsWorld(world);
+    const std::vector<tgRigidInfo*> groups = getGroupRigids();
+    for (std::size_t i = 0; i < groups.size(); i++)
+    {
+        btRigidBody* const body = groups[i]->getRigidBody();
+        if (body == NULL)
+        {
+            continue;
+        }
+
+        const btTransform moved = transform * body->getWorldTransform();
+        body->setWorldTransform(moved);
+        body->setInterpolationWorldTransform(moved);
+        if (body->getMotionState())
+        {
+            body->getMotionState()->setWorldTransform(moved);
+        }
+        dynamicsWorld.updateSingleAabb(body);
+    }
+}
+
+const std::vector<tgConnectorInfo*>& tgStructurePrototype::getConnectors() const
+{
+    return m_pInfo->getConnectors();
+}
+
+void tgStructurePrototype::clearInstance()
+{
+    const std::vector<tgRigidInfo*> groups = getGroupRigids();
+    for (std::size_t i = 0; i < groups.size(); i++)
+    {
+        // Compounds pass this on to their components
+        groups[i]->setCollisionObject(NULL);
+    }
+}
+
+std::vector<tgRigidInfo*> tgStructurePrototype::getGroupRigids() const
+{
+    const std::vector<tgRigidInfo*> rigids = m_pInfo->getAllRigids();
+    std::set<tgRigidInfo*> seen;
+    std::vector<tgRigidInfo*> result;
+    for (std::size_t i = 0; i < rigids.size(); i++)
+    {
+        tgRigidInfo* rigid = rigids[i]->getRigidInfoGroup();
+        // Same fallback as tgRigidInfo::initRigidBody
+        if (rigid == NULL)
+        {
+            rigid = rigids[i];
+        }
+        if (seen.insert(rigid).second)
+        {
+            result.push_back(rigid);
+        }
+    }
+    return result;
+}
+
+void tgStructurePrototype::adoptShapes(tgWorld& world)
+{
+    tgWorldBulletPhysicsImpl& bulletWorld =
+      (tgWorldBulletPhysicsImpl&)world.implementation();
+
+    const std::vector<tgRigidInfo*> groups = getGroupRigids();
+    for (std::size_t i = 0; i < groups.size(); i++)
+    {
+        // Cached, so this doesn't create a new shape
+        btCollisionShape* const pShape = groups[i]->getCollisionShape(world);
+        assert(pShape != NULL);
+        bulletWorld.releaseCollisionShape(pShape);
+        m_shapes.push_back(pShape);
+    }
+}
+
+void tgStructurePrototype::collectShapes(btCollisionShape* pShape,
+                                         std::set<btCollisionShape*>& shapes)
+{
+    btCompoundShape* cShape = tgCast::cast<btCollisionShape, btCompoundShape>(pShape);
+    if (cShape)
+    {
+        for (int i = 0; i < cShape->getNumChildShapes(); i++)
+        {
+            collectShapes(cShape->getChildShape(i), shapes);
+        }
+    }
+    shapes.insert(pShape);
+}
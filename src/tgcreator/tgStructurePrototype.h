@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2012, United States Government, as represented by the
+ * Administrator of the National Aeronautics and Space Administration.
+ * All rights reserved.
+ * 
+ * The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+ * under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * http://www.apache.org/licenses/LICENSE-2.0.
+ * 
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+*/
+
+/**
+ * @file tgStructurePrototype.h
+ * @brief Definition of class tgStructurePrototype
+ * @author agent
+ * $Id$
+ */
+
+#ifndef TG_STRUCTURE_PROTOTYPE_H
+#define TG_STRUCTURE_PROTOTYPE_H
+
+// The C++ Standard Library
+#include <cstddef>
+#include <set>
+#include <vector>
+
+// Forward declarations
+class btCollisionShape;
+class btTransform;
+class tgBuildSpec;
+class tgConnectorInfo;
+class tgModel;
+class tgRigidInfo;
+class tgStructure;
+class tgStructureInfo;
+class tgWorld;
+
+/**
+ * Builds one structure into many models. The build spec is matched,
+ * rigids are compounded and connectors choose their rigids once, in the
+ * constructor. Each call to instantiate then only creates the bodies,
+ * connectors and models of one instance, and every instance shares the
+ * same collision shapes.
+ *
+ * Use it in place of tgStructureInfo when a swarm or a population of
+ * identical robots is built every episode:
+ * @code
+ * tgStructurePrototype prototype(structure, spec);
+ * prototype.instantiate(model1, world, transform1);
+ * prototype.instantiate(model2, world, transform2);
+ * @endcode
+ *
+ * The structure and the build spec are only used by the constructor.
+ * The shapes belong to the prototype rather than to a world, so they
+ * survive tgWorld::reset, and the prototype must outlive every world it
+ * was instantiated into.
+ */
+class tgStructurePrototype
+{
+public:
+
+    /**
+     * Run the world independent build steps of tgStructureInfo::buildInto
+     * @param[in] structure the structure to build
+     * @param[in] buildSpec matches the structure's tags to infos
+     */
+    tgStructurePrototype(tgStructure& structure, tgBuildSpec& buildSpec);
+
+    /** Deletes the shared collision shapes */
+    ~tgStructurePrototype();
+
+    /**
+     * Build an instance into model where the structure was defined
+     * @param[in,out] model gets the rods, cables and child models
+     * @param[in,out] world gets the bodies
+     */
+    void instantiate(tgModel& model, tgWorld& world);
+
+    /**
+     * Build an instance into model, then move all of its bodies by
+     * transform. Cable anchors are attached relative to their bodies, so
+     * they move along.
+     * @param[in,out] model gets the rods, cables and child models
+     * @param[in,out] world gets the bodies
+     * @param[in] transform applied on top of the structure's own positions
+     */
+    void instantiate(tgModel& model, tgWorld& world,
+                     const btTransform& transform);
+
+    /**
+     * The connector infos of the structure, without those of its
+     * children. Each instance creates its cables from these, so changing
+     * their configs, as tgBasicActuatorInfo::setConfig does, changes
+     * every later instance without matching the build spec again.
+     */
+    const std::vector<tgConnectorInfo*>& getConnectors() const;
+
+    /** Instances built so far, across all worlds */
+    std::size_t getNumInstances() const
+    {
+        return m_numInstances;
+    }
+
+private:
+
+    /** Disable the copy constructor. */
+    tgStructurePrototype(const tgStructurePrototype&);
+
+    /** Disable the assignment operator. */
+    tgStructurePrototype& operator=(const tgStructurePrototype&);
+
+    /**
+     * Forget the bodies of the last instance, which now belong to its
+     * world, so the next instance gets new ones
+     */
+    void clearInstance();
+
+    /** The rigid of each body, one per compound */
+    std::vector<tgRigidInfo*> getGroupRigids() const;
+
+    /** Take the shapes the first instance created away from its world */
+    void adoptShapes(tgWorld& world);
+
+    /** Add a shape and, for a compound, its children to shapes */
+    static void collectShapes(btCollisionShape* pShape,
+                              std::set<btCollisionShape*>& shapes);
+
+    /** Owned, the infos of every instance */
+    tgStructureInfo* const m_pInfo;
+
+    /** Owned, shared by every instance */
+    std::vector<btCollisionShape*> m_shapes;
+
+    std::size_t m_numInstances;
+};
+
+#endif // TG_STRUCTURE_PROTOTYPE_H
@@ -338,10 +338,17 @@ public:
         return floor(d * m + 0.5)/m;
     }
     
+    /**
+     * Seed the C library's rand() from the clock.
+     * @deprecated rand() is shared by the whole process and doesn't
+     * follow the randomSeed of a learning run. Draw from a
+     * tgRandomStream of the run seed instead, such as
+     * AnnealAdapter::episodeStream. Kept for the dev applications that
+     * randomize their start angles with rand().
+     */
     static void seedRandom();
     
-    /// @todo is this necessary? If everyone uses the above function we can just change the 
-    /// definition of rdtsc to seed random everywhere. 
+    /// @deprecated As seedRandom()
     static void seedRandom(int seed);
 };
 
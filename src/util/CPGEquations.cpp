@@ -44,13 +44,15 @@ typedef std::vector<double > cpgVars_type;
 CPGEquations::CPGEquations(int maxSteps) :
 stepSize(0.1),
 numSteps(0),
-m_maxSteps(maxSteps)
+m_maxSteps(maxSteps),
+m_revision(0)
  {}
 CPGEquations::CPGEquations(std::vector<CPGNode*>& newNodeList, int maxSteps) :
 nodeList(newNodeList),
 stepSize(0.1), //TODO: specify as a parameter somewhere
 numSteps(0),
-m_maxSteps(maxSteps)
+m_maxSteps(maxSteps),
+m_revision(0)
 {
 }
 
@@ -70,6 +72,7 @@ int CPGEquations::addNode(std::vector<double>& newParams)
 	int index = nodeList.size();
 	CPGNode* newNode = new CPGNode(index, newParams);
 	nodeList.push_back(newNode);
+	m_revision++;
 	
 	return index;
 }
@@ -86,6 +89,7 @@ void CPGEquations::defineConnections (	int nodeIndex,
 	for(int i = 0; i != connections.size(); i++){
 		nodeList[nodeIndex]->addCoupling(nodeList[connections[i]], newWeights[i], newPhaseOffsets[i]); 
 	}
+	m_revision++;
 }
 
 const double CPGEquations::operator[](const std::size_t i) const
@@ -66,7 +66,7 @@ class CPGEquations
 	/**
 	 * Call the integrator a the specified timestep
 	 */
-	void update(std::vector<double>& descCom, double dt);
+	virtual void update(std::vector<double>& descCom, double dt);
 	
 	std::string toString(const std::string& prefix = "") const;
 	
@@ -75,6 +75,15 @@ class CPGEquations
         numSteps++;
     }
     
+    /**
+     * Changes whenever a node or coupling is added, so anything built
+     * from the nodes can tell when it has to be rebuilt.
+     */
+    std::size_t getRevision() const
+    {
+        return m_revision;
+    }
+    
 protected:
 	
 	std::vector<CPGNode*> nodeList;
@@ -87,6 +96,9 @@ protected:
     int m_maxSteps;
     int numSteps;
     
+    /** Incremented by every change to the nodes or their couplings */
+    std::size_t m_revision;
+    
 };
 
 /**
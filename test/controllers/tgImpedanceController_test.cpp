@@ -0,0 +1,164 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgImpedanceController_test.cpp
+* @brief Contains a test of tgImpedanceController::controlBatch against
+* controlTension
+* $Id$
+*/
+
+// This application
+#include "controllers/tgImpedanceController.h"
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	/** Two rods held apart by three cables, above the ground */
+	class Rig {
+		public:
+			Rig() {
+				tgStructure structure;
+				structure.addNode(0.0, 2.0, 0.0);
+				structure.addNode(0.0, 6.0, 0.0);
+				structure.addNode(3.0, 2.0, 0.0);
+				structure.addNode(3.0, 6.0, 1.0);
+				structure.addPair(0, 1, "rod");
+				structure.addPair(2, 3, "rod");
+				structure.addPair(0, 2, "muscle");
+				structure.addPair(1, 3, "muscle");
+				structure.addPair(0, 3, "muscle");
+
+				tgBuildSpec spec;
+				spec.addBuilder("rod", new tgRodInfo(tgRod::Config(0.2, 0.3)));
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(
+					tgBasicActuator::Config(1000.0, 10.0, 500.0)));
+				tgStructureInfo structureInfo(structure, spec);
+				structureInfo.buildInto(model, world);
+				model.setup(world);
+
+				cables = tgCast::filter<tgModel, tgBasicActuator>(model.getDescendants());
+			}
+
+			~Rig() {
+				model.teardown();
+			}
+
+			void step(double dt) {
+				model.step(dt);
+				world.step(dt);
+			}
+
+			tgWorld world;
+			tgModel model;
+			vector<tgBasicActuator*> cables;
+	};
+
+	TEST(tgImpedanceControllerTest, testBatchMatchesControlTension) {
+
+				// The same structure in two worlds, stepped the same way
+				Rig scalar;
+				Rig batched;
+				const size_t n = scalar.cables.size();
+				ASSERT_EQ(3u, n);
+				ASSERT_EQ(n, batched.cables.size());
+
+				vector<tgImpedanceController> controllers;
+				tgImpedanceController::Batch batch;
+				for (size_t i = 0; i < n; i++) {
+					controllers.push_back(
+						tgImpedanceController(100.0 + 10.0 * i, 50.0 * i, 5.0 * i));
+					EXPECT_EQ(i, batch.add(controllers[i]));
+				}
+
+				const double dt = 0.001;
+				for (int step = 0; step < 500; step++) {
+					vector<double> setTension(n);
+					for (size_t i = 0; i < n; i++) {
+						const double setLength = 3.0 + 0.5 * sin(0.01 * step + i);
+						const double offsetVel = 0.1 * i;
+						setTension[i] =
+							controllers[i].controlTension(*scalar.cables[i], dt, setLength,
+														  controllers[i].getOffsetTension(),
+														  offsetVel);
+						batch.setLength[i] = setLength;
+						batch.offsetVel[i] = offsetVel;
+					}
+					batch.read(batched.cables);
+					tgImpedanceController::controlBatch(batch, dt);
+					batch.apply(batched.cables, dt);
+
+					scalar.step(dt);
+					batched.step(dt);
+
+					// Bitwise, not just close
+					for (size_t i = 0; i < n; i++) {
+						EXPECT_EQ(setTension[i], batch.setTension[i]);
+						EXPECT_EQ(scalar.cables[i]->getRestLength(),
+								  batched.cables[i]->getRestLength());
+						EXPECT_EQ(scalar.cables[i]->getCurrentLength(),
+								  batched.cables[i]->getCurrentLength());
+						EXPECT_EQ(scalar.cables[i]->getTension(),
+								  batched.cables[i]->getTension());
+					}
+				}
+	}
+
+	TEST(tgImpedanceControllerTest, testBatchChecksInputs) {
+
+				tgImpedanceController::Batch batch;
+				batch.add(tgImpedanceController());
+				EXPECT_THROW(tgImpedanceController::controlBatch(batch, 0.0),
+							 std::runtime_error);
+
+				batch.velocity.push_back(1.0);
+				EXPECT_THROW(tgImpedanceController::controlBatch(batch, 0.01),
+							 std::invalid_argument);
+
+				EXPECT_THROW(batch.read(vector<tgBasicActuator*>()),
+							 std::invalid_argument);
+
+				tgImpedanceController::Batch empty;
+				tgImpedanceController::controlBatch(empty, 0.01);
+				EXPECT_EQ(0u, empty.setTension.size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,107 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgPIDController_test.cpp
+* @brief Contains a test of tgPIDController::controlBatch against the
+* scalar controller
+* $Id$
+*/
+
+// This application
+#include "controllers/tgPIDController.h"
+#include "core/tgControllable.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	/** Remembers the last input, as an actuator would */
+	class RecordingControllable : public tgControllable {
+		public:
+			RecordingControllable() : input(0.0) { }
+			
+			virtual void setControlInput(double newInput) {
+				input = newInput;
+			}
+			
+			double input;
+	};
+
+	TEST(tgPIDControllerTest, testBatchMatchesScalar) {
+				
+				const int n = 7;
+				vector<RecordingControllable> controllables(n);
+				vector<tgPIDController*> scalar;
+				tgPIDController::Batch batch;
+				for (int i = 0; i < n; i++) {
+					const tgPIDController::Config config(0.5 + i, 0.1 * i, 0.01 * i,
+														 i % 2 == 0, 10.0 - i);
+					scalar.push_back(new tgPIDController(&controllables[i], config));
+					EXPECT_EQ(static_cast<size_t>(i), batch.add(config));
+				}
+				
+				for (int step = 0; step < 200; step++) {
+					const double dt = 0.001 * (1 + step % 3);
+					for (int i = 0; i < n; i++) {
+						const double setPoint = 5.0 * sin(0.01 * step + i);
+						const double sensorData = 4.0 * cos(0.02 * step * i);
+						scalar[i]->control(dt, setPoint, sensorData);
+						batch.setPoint[i] = setPoint;
+						batch.sensorData[i] = sensorData;
+					}
+					tgPIDController::controlBatch(batch, dt);
+					
+					// Bitwise, not just close
+					for (int i = 0; i < n; i++) {
+						EXPECT_EQ(controllables[i].input, batch.output[i]);
+					}
+				}
+				
+				for (int i = 0; i < n; i++) {
+					delete scalar[i];
+				}
+	}
+
+	TEST(tgPIDControllerTest, testBatchChecksInputs) {
+				
+				tgPIDController::Batch batch;
+				batch.add(tgPIDController::Config());
+				EXPECT_THROW(tgPIDController::controlBatch(batch, 0.0), std::runtime_error);
+				
+				batch.sensorData.push_back(1.0);
+				EXPECT_THROW(tgPIDController::controlBatch(batch, 0.01), std::invalid_argument);
+				
+				tgPIDController::Batch empty;
+				tgPIDController::controlBatch(empty, 0.01);
+				EXPECT_EQ(0u, empty.output.size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
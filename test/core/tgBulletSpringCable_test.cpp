@@ -0,0 +1,170 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgBulletSpringCable_test.cpp
+* @brief Contains a test of the sleep threshold of tgBulletSpringCable
+* $Id$
+*/
+
+// This application
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics Library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	const double dt = 0.001;
+
+	class tgBulletSpringCableTest : public ::testing::Test {
+		protected:
+
+			virtual ~tgBulletSpringCableTest() {
+				model.teardown();
+			}
+
+			/**
+			 * Two rods lying end to end on the ground, pulled together by
+			 * a cable. The cable is along their axis and its tension is
+			 * well below friction, so they come to rest.
+			 */
+			void build(double sleepThreshold) {
+				tgStructure structure;
+				structure.addNode(0.0, 0.5, 0.0);
+				structure.addNode(4.0, 0.5, 0.0);
+				structure.addNode(5.0, 0.5, 0.0);
+				structure.addNode(9.0, 0.5, 0.0);
+				structure.addPair(0, 1, "rod");
+				structure.addPair(2, 3, "rod");
+				structure.addPair(1, 2, "muscle");
+
+				tgBasicActuator::Config cableConfig(100.0, 10.0, 5.0);
+				cableConfig.sleepThreshold = sleepThreshold;
+
+				tgBuildSpec spec;
+				spec.addBuilder("rod", new tgRodInfo(tgRod::Config(0.5, 1.0)));
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(cableConfig));
+				tgStructureInfo structureInfo(structure, spec);
+				structureInfo.buildInto(model, world);
+
+				rods = tgCast::filter<tgModel, tgRod>(model.getDescendants());
+				cables = tgCast::filter<tgModel, tgBasicActuator>(model.getDescendants());
+				ASSERT_EQ(2u, rods.size());
+				ASSERT_EQ(1u, cables.size());
+
+				model.setup(world);
+			}
+
+			/** Bullet deactivates bodies that have been still for 2 s */
+			void settle() {
+				for (int i = 0; i < 4000; i++) {
+					model.step(dt);
+					world.step(dt);
+				}
+			}
+
+			bool isActive(std::size_t rod) {
+				return rods[rod]->getPRigidBody()->isActive();
+			}
+
+			tgWorld world;
+			tgModel model;
+			vector<tgRod*> rods;
+			vector<tgBasicActuator*> cables;
+	};
+
+	TEST_F(tgBulletSpringCableTest, testAlwaysAwakeByDefault) {
+
+				build(-1.0);
+				settle();
+				EXPECT_GT(cables[0]->getTension(), 0.0);
+				EXPECT_TRUE(isActive(0));
+				EXPECT_TRUE(isActive(1));
+	}
+
+	TEST_F(tgBulletSpringCableTest, testSleepsAtRest) {
+
+				build(1.0);
+				settle();
+				EXPECT_GT(cables[0]->getTension(), 0.0);
+				EXPECT_FALSE(isActive(0));
+				EXPECT_FALSE(isActive(1));
+
+				// Still asleep a while later
+				settle();
+				EXPECT_FALSE(isActive(0));
+				EXPECT_FALSE(isActive(1));
+	}
+
+	TEST_F(tgBulletSpringCableTest, testTensionJumpWakes) {
+
+				build(1.0);
+				settle();
+				ASSERT_FALSE(isActive(0));
+				ASSERT_FALSE(isActive(1));
+
+				// translate doesn't wake the body. Stretching by 1e-5
+				// changes the tension by about 0.1, nearly all damping
+				rods[1]->getPRigidBody()->translate(btVector3(1.0e-5, 0.0, 0.0));
+				model.step(dt);
+				EXPECT_FALSE(isActive(0));
+				EXPECT_FALSE(isActive(1));
+
+				// Stretching by 0.5 changes it by about 100, with the
+				// damping clamped to the spring force
+				rods[1]->getPRigidBody()->translate(btVector3(0.5, 0.0, 0.0));
+				model.step(dt);
+				EXPECT_TRUE(isActive(0));
+				EXPECT_TRUE(isActive(1));
+	}
+
+	TEST_F(tgBulletSpringCableTest, testRestLengthWakes) {
+
+				build(1.0);
+				settle();
+				ASSERT_FALSE(isActive(0));
+				ASSERT_FALSE(isActive(1));
+
+				cables[0]->setControlInput(cables[0]->getRestLength() - 0.01, dt);
+				EXPECT_TRUE(isActive(0));
+				EXPECT_TRUE(isActive(1));
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgCollisionShapeCache_test.cpp
+* @brief Contains a test of sharing collision shapes in
+* tgCollisionShapeCache
+* $Id$
+*/
+
+// This application
+#include "core/tgCollisionShapeCache.h"
+// The Bullet Physics Library
+#include "BulletCollision/CollisionShapes/btCollisionShape.h"
+#include "LinearMath/btAlignedAllocator.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <cstdlib>
+#include <set>
+#include <stdexcept>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	/** Everything Bullet allocated and didn't free yet */
+	set<void*> live;
+
+	void* trackedAlloc(size_t size, int alignment) {
+		void* memory = NULL;
+		if (posix_memalign(&memory, alignment, size) != 0) {
+			return NULL;
+		}
+		live.insert(memory);
+		return memory;
+	}
+
+	void trackedFree(void* memory) {
+		live.erase(memory);
+		free(memory);
+	}
+
+	class tgCollisionShapeCacheTest : public ::testing::Test {
+		protected:
+
+			tgCollisionShapeCacheTest() :
+				rod(0.5, 2.0, 0.5)
+			{
+				// Collision shapes are allocated through Bullet
+				btAlignedAllocSetCustomAligned(trackedAlloc, trackedFree);
+			}
+
+			virtual ~tgCollisionShapeCacheTest() {
+				btAlignedAllocSetCustomAligned(NULL, NULL);
+			}
+
+			bool isLive(const btCollisionShape* pShape) const {
+				return live.count(const_cast<btCollisionShape*>(pShape)) > 0;
+			}
+
+			const btVector3 rod;
+	};
+
+	TEST_F(tgCollisionShapeCacheTest, testSameParameters) {
+
+				tgCollisionShapeCache cache;
+				btCollisionShape* const pShape =
+					cache.get(tgCollisionShapeCache::cylinder, rod);
+				ASSERT_TRUE(pShape != NULL);
+				EXPECT_EQ(pShape, cache.get(tgCollisionShapeCache::cylinder, rod));
+				EXPECT_EQ(1u, cache.size());
+				EXPECT_EQ(1u, cache.getNumMisses());
+				EXPECT_EQ(1u, cache.getNumHits());
+				EXPECT_TRUE(cache.contains(pShape));
+
+				// Within the resolution
+				EXPECT_EQ(pShape, cache.get(tgCollisionShapeCache::cylinder,
+											rod + btVector3(0.0, 1.0e-12, 0.0)));
+
+				// The same margin
+				btCollisionShape* const pMargin =
+					cache.get(tgCollisionShapeCache::box, rod, 0.04);
+				EXPECT_EQ(pMargin, cache.get(tgCollisionShapeCache::box, rod, 0.04));
+				EXPECT_NEAR(0.04, pMargin->getMargin(), 1.0e-6);
+
+				// Spheres only have a radius
+				btCollisionShape* const pSphere =
+					cache.get(tgCollisionShapeCache::sphere, btVector3(0.3, 1.0, 2.0));
+				EXPECT_EQ(pSphere, cache.get(tgCollisionShapeCache::sphere,
+											 btVector3(0.3, 0.0, 0.0)));
+				EXPECT_EQ(3u, cache.size());
+	}
+
+	TEST_F(tgCollisionShapeCacheTest, testDifferentParameters) {
+
+				tgCollisionShapeCache cache;
+				set<btCollisionShape*> shapes;
+				shapes.insert(cache.get(tgCollisionShapeCache::cylinder, rod));
+				shapes.insert(cache.get(tgCollisionShapeCache::box, rod));
+				shapes.insert(cache.get(tgCollisionShapeCache::sphere, rod));
+				shapes.insert(cache.get(tgCollisionShapeCache::cylinder,
+										btVector3(0.5, 3.0, 0.5)));
+				shapes.insert(cache.get(tgCollisionShapeCache::cylinder,
+										btVector3(0.25, 2.0, 0.5)));
+				shapes.insert(cache.get(tgCollisionShapeCache::cylinder, rod, 0.01));
+				shapes.insert(cache.get(tgCollisionShapeCache::cylinder, rod, 0.02));
+				// More than the resolution apart
+				shapes.insert(cache.get(tgCollisionShapeCache::cylinder,
+										rod + btVector3(0.0, 1.0e-6, 0.0)));
+				EXPECT_EQ(8u, shapes.size());
+				EXPECT_EQ(8u, cache.size());
+				EXPECT_EQ(8u, cache.getNumMisses());
+				EXPECT_EQ(0u, cache.getNumHits());
+				EXPECT_FALSE(cache.contains(NULL));
+	}
+
+	TEST_F(tgCollisionShapeCacheTest, testFreed) {
+
+				btCollisionShape* pKept;
+				btCollisionShape* pPruned;
+				btCollisionShape* pReleased;
+				btCollisionShape* pCleared;
+				{
+					tgCollisionShapeCache cache;
+					pKept = cache.get(tgCollisionShapeCache::cylinder, rod);
+					pPruned = cache.get(tgCollisionShapeCache::box, rod);
+					pReleased = cache.get(tgCollisionShapeCache::sphere, rod);
+					EXPECT_TRUE(isLive(pKept));
+					EXPECT_TRUE(isLive(pPruned));
+
+					// Everything was asked for since the last prune
+					cache.prune();
+					EXPECT_EQ(3u, cache.size());
+
+					// Only the cylinder is asked for again
+					EXPECT_EQ(pKept, cache.get(tgCollisionShapeCache::cylinder, rod));
+					cache.release(pReleased);
+					EXPECT_FALSE(cache.contains(pReleased));
+					cache.prune();
+					EXPECT_EQ(1u, cache.size());
+					EXPECT_TRUE(isLive(pKept));
+					EXPECT_FALSE(isLive(pPruned));
+					EXPECT_TRUE(isLive(pReleased));
+
+					cache.clear();
+					EXPECT_EQ(0u, cache.size());
+					EXPECT_FALSE(isLive(pKept));
+					EXPECT_TRUE(isLive(pReleased));
+
+					// The destructor clears too
+					pCleared = cache.get(tgCollisionShapeCache::cylinder, rod);
+					EXPECT_TRUE(isLive(pCleared));
+				}
+				EXPECT_FALSE(isLive(pCleared));
+
+				// Released shapes belong to the caller
+				delete pReleased;
+				EXPECT_FALSE(isLive(pReleased));
+	}
+
+	TEST_F(tgCollisionShapeCacheTest, testResolution) {
+
+				EXPECT_THROW(tgCollisionShapeCache(0.0), std::invalid_argument);
+				EXPECT_THROW(tgCollisionShapeCache(-1.0), std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
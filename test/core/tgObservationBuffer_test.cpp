@@ -0,0 +1,169 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgObservationBuffer_test.cpp
+* @brief Contains a test of filling and reading a tgObservationBuffer
+* $Id$
+*/
+
+// This application
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgObservationBuffer.h"
+#include "core/tgRod.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics Library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class tgObservationBufferTest : public ::testing::Test {
+		protected:
+
+			tgObservationBufferTest() {
+				// Two rods held apart by two cables, above the ground
+				tgStructure structure;
+				structure.addNode(0.0, 2.0, 0.0);
+				structure.addNode(0.0, 6.0, 0.0);
+				structure.addNode(3.0, 2.0, 0.0);
+				structure.addNode(3.0, 6.0, 1.0);
+				structure.addPair(0, 1, "rod");
+				structure.addPair(2, 3, "rod");
+				structure.addPair(0, 2, "muscle");
+				structure.addPair(1, 3, "muscle");
+
+				tgBuildSpec spec;
+				spec.addBuilder("rod", new tgRodInfo(tgRod::Config(0.2, 0.3)));
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(
+					tgBasicActuator::Config(1000.0, 10.0, 500.0)));
+				tgStructureInfo structureInfo(structure, spec);
+				structureInfo.buildInto(model, world);
+
+				rods = tgCast::filter<tgModel, tgRod>(model.getDescendants());
+				cables = tgCast::filter<tgModel, tgBasicActuator>(model.getDescendants());
+			}
+
+			virtual ~tgObservationBufferTest() {
+				world.observations().clear();
+				model.teardown();
+			}
+
+			void expectCurrent(tgObservationBuffer& buffer) {
+				const double totalMass = rods[0]->mass() + rods[1]->mass();
+				const btVector3 center =
+					(rods[0]->centerOfMass() * rods[0]->mass() +
+					 rods[1]->centerOfMass() * rods[1]->mass()) / totalMass;
+				EXPECT_NEAR(0.0, center.distance(buffer.getVector(0)), 1.0e-12);
+
+				EXPECT_NEAR(0.0, rods[1]->centerOfMass().distance(buffer.getVector(3)),
+							1.0e-12);
+				EXPECT_NEAR(0.0, rods[1]->orientation().distance(buffer.getVector(6)),
+							1.0e-12);
+
+				EXPECT_DOUBLE_EQ(cables[0]->getCurrentLength(), buffer.get(9));
+				EXPECT_DOUBLE_EQ(cables[0]->getVelocity(), buffer.get(10));
+				EXPECT_DOUBLE_EQ(cables[0]->getTension(), buffer.get(11));
+			}
+
+			tgWorld world;
+			tgModel model;
+			vector<tgRod*> rods;
+			vector<tgBasicActuator*> cables;
+	};
+
+	TEST_F(tgObservationBufferTest, testFillAndRead) {
+
+				ASSERT_EQ(2u, rods.size());
+				ASSERT_EQ(2u, cables.size());
+				tgObservationBuffer& buffer = world.observations();
+				EXPECT_EQ(0u, buffer.size());
+
+				const vector<tgBaseRigid*> rigids(rods.begin(), rods.end());
+				EXPECT_EQ(0u, buffer.addCenterOfMass(rigids));
+				EXPECT_EQ(tgObservationBuffer::centerOfMassSize,
+						  buffer.addPose(rods[1]));
+				EXPECT_EQ(tgObservationBuffer::centerOfMassSize +
+						  tgObservationBuffer::poseSize,
+						  buffer.addCable(cables[0]));
+				EXPECT_EQ(12u, buffer.size());
+				EXPECT_EQ(buffer.size(), buffer.getValues().size());
+
+				// Read when added
+				EXPECT_EQ(0u, buffer.getNumUpdates());
+				expectCurrent(buffer);
+
+				// And again after every world step
+				model.setup(world);
+				for (int i = 0; i < 100; i++) {
+					model.step(0.001);
+					world.step(0.001);
+					expectCurrent(buffer);
+				}
+				EXPECT_EQ(100u, buffer.getNumUpdates());
+				// The rods fell
+				EXPECT_LT(buffer.get(1), 4.0);
+
+				buffer.clear();
+				EXPECT_EQ(0u, buffer.size());
+				EXPECT_EQ(0u, buffer.getNumUpdates());
+				world.step(0.001);
+				EXPECT_EQ(0u, buffer.size());
+	}
+
+	TEST_F(tgObservationBufferTest, testInvalid) {
+
+				tgObservationBuffer& buffer = world.observations();
+				EXPECT_THROW(buffer.addCenterOfMass(vector<tgBaseRigid*>()),
+							 std::invalid_argument);
+				EXPECT_THROW(buffer.addPose(NULL), std::invalid_argument);
+				EXPECT_THROW(buffer.addCable(NULL), std::invalid_argument);
+				EXPECT_EQ(0u, buffer.size());
+	}
+
+	TEST_F(tgObservationBufferTest, testClearedOnReset) {
+
+				tgObservationBuffer& buffer = world.observations();
+				buffer.addCable(cables[1]);
+				EXPECT_EQ(tgObservationBuffer::cableSize, buffer.size());
+
+				model.teardown();
+				world.reset();
+				EXPECT_EQ(0u, buffer.size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgProfiler_test.cpp
+* @brief Contains a test of reading nested BT_PROFILE scopes with
+* tgProfiler
+* $Id$
+*/
+
+// This application
+#include "core/tgProfiler.h"
+// The Bullet Physics library
+#include "LinearMath/btQuickprof.h"
+// The C++ Standard Library
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+#ifndef BT_NO_PROFILE
+
+	/** One world step as Bullet profiles it, inner is run twice */
+	void step(int outerMicroseconds, int innerMicroseconds) {
+		CProfileManager::Reset();
+		{
+			BT_PROFILE("outer");
+			usleep(outerMicroseconds);
+			for (int i = 0; i < 2; i++) {
+				BT_PROFILE("inner");
+				usleep(innerMicroseconds);
+			}
+		}
+		{
+			BT_PROFILE("other");
+		}
+	}
+
+	TEST(tgProfilerTest, testNestedScopes) {
+
+				tgProfiler profiler(2, 100);
+				for (int i = 0; i < 6; i++) {
+					step(2000 * (i + 1), 1000);
+					profiler.onStep();
+				}
+				EXPECT_EQ(3u, profiler.getNumSamples());
+
+				const tgProfiler::Scope& root = profiler.getScope("step");
+				const tgProfiler::Scope& outer = profiler.getScope("step/outer");
+				const tgProfiler::Scope& inner =
+					profiler.getScope("step/outer/inner");
+				EXPECT_EQ(0, root.depth);
+				EXPECT_EQ(1, outer.depth);
+				EXPECT_EQ(2, inner.depth);
+				EXPECT_EQ("inner", inner.name);
+				EXPECT_THROW(profiler.getScope("step/inner"),
+							 std::invalid_argument);
+
+				// Only every second step was read
+				EXPECT_EQ(3u, outer.samples);
+				EXPECT_EQ(3, outer.calls);
+				EXPECT_EQ(3u, inner.samples);
+				EXPECT_EQ(6, inner.calls);
+
+				// The sampled steps slept 4, 8 and 12 ms outside inner
+				EXPECT_GE(outer.min, 6.0);
+				EXPECT_GE(outer.max, 14.0);
+				EXPECT_LE(outer.min, outer.max);
+				EXPECT_GE(outer.exclusive, 24.0);
+				EXPECT_GE(inner.inclusive, 6.0);
+				EXPECT_NEAR(outer.inclusive, outer.exclusive + inner.inclusive,
+							1e-6);
+				EXPECT_GE(root.inclusive, outer.inclusive);
+				EXPECT_EQ(3u, outer.recent.size());
+
+				std::ostringstream trace;
+				profiler.writeChromeTrace(trace);
+				EXPECT_NE(string::npos, trace.str().find("\"name\":\"inner\""));
+				EXPECT_EQ(0u, profiler.getNumDroppedEvents());
+	}
+
+	TEST(tgProfilerTest, testReport) {
+
+				tgProfiler profiler;
+				for (int i = 0; i < 4; i++) {
+					step(0, 500);
+					profiler.onStep();
+				}
+
+				std::ostringstream csv;
+				profiler.writeCSV(csv);
+				std::istringstream lines(csv.str());
+				string line;
+				ASSERT_TRUE(getline(lines, line));
+				EXPECT_EQ(0u, line.find("scope,depth,samples,calls,"));
+
+				// Parents come before their children
+				ASSERT_TRUE(getline(lines, line));
+				EXPECT_EQ(0u, line.find("\"step\",0,4,4,"));
+				ASSERT_TRUE(getline(lines, line));
+				EXPECT_EQ(0u, line.find("\"step/outer\",1,4,4,"));
+				ASSERT_TRUE(getline(lines, line));
+				EXPECT_EQ(0u, line.find("\"step/outer/inner\",2,4,8,"));
+				ASSERT_TRUE(getline(lines, line));
+				EXPECT_EQ(0u, line.find("\"step/other\",1,4,4,"));
+				EXPECT_FALSE(getline(lines, line));
+
+				// Without maxEvents there is no trace
+				std::ostringstream trace;
+				profiler.writeChromeTrace(trace);
+				EXPECT_EQ(string::npos, trace.str().find("\"name\""));
+
+				profiler.clear();
+				EXPECT_EQ(0u, profiler.getNumSamples());
+				EXPECT_THROW(profiler.getScope("step"), std::invalid_argument);
+	}
+
+	TEST(tgProfilerTest, testBounded) {
+
+				tgProfiler profiler(1, 10);
+				const int steps = tgProfiler::recentSamples + 10;
+				for (int i = 0; i < steps; i++) {
+					step(0, 0);
+					profiler.onStep();
+				}
+
+				const tgProfiler::Scope& inner =
+					profiler.getScope("step/outer/inner");
+				EXPECT_EQ(static_cast<size_t>(steps), inner.samples);
+				EXPECT_EQ(tgProfiler::recentSamples, inner.recent.size());
+				// Four scopes a step
+				EXPECT_EQ(4u * steps - 10, profiler.getNumDroppedEvents());
+	}
+
+#endif //BT_NO_PROFILE
+
+	TEST(tgProfilerTest, testInterval) {
+
+				EXPECT_THROW(tgProfiler(0), std::invalid_argument);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgRandomStream_test.cpp
+* @brief Contains a test of the counter based random streams
+* $Id$
+*/
+
+// This application
+#include "core/tgRandomStream.h"
+// The C++ Standard Library
+#include <cmath>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	TEST(tgRandomStreamTest, testKnownAnswers) {
+
+				// From the Random123 known answer tests for philox4x32_10
+				unsigned int result[4];
+
+				const unsigned int zeros[4] = {0, 0, 0, 0};
+				tgRandomStream::philox(zeros, zeros, result);
+				EXPECT_EQ(0x6627e8d5u, result[0]);
+				EXPECT_EQ(0xe169c58du, result[1]);
+				EXPECT_EQ(0xbc57ac4cu, result[2]);
+				EXPECT_EQ(0x9b00dbd8u, result[3]);
+
+				const unsigned int counter[4] =
+					{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+				const unsigned int key[2] = {0xa4093822, 0x299f31d0};
+				tgRandomStream::philox(counter, key, result);
+				EXPECT_EQ(0xd16cfe09u, result[0]);
+				EXPECT_EQ(0x94fdccebu, result[1]);
+				EXPECT_EQ(0x5001e420u, result[2]);
+				EXPECT_EQ(0x24126ea1u, result[3]);
+
+				// The stream of seed 0 starts with the block of counter 0
+				tgRandomStream stream(0);
+				EXPECT_EQ(0x6627e8d5u, stream.next());
+				EXPECT_EQ(0xe169c58du, stream.next());
+	}
+
+	TEST(tgRandomStreamTest, testStreams) {
+
+				// Each stream only depends on its name
+				tgRandomStream a(7, 3, 2, 1);
+				tgRandomStream other(7, 3, 2, 2);
+				vector<unsigned int> first;
+				for (int i = 0; i < 10; i++) {
+					first.push_back(a.next());
+					other.next();
+				}
+				tgRandomStream again(7, 3, 2, 1);
+				bool differs = false;
+				for (int i = 0; i < 10; i++) {
+					const unsigned int value = again.next();
+					EXPECT_EQ(first[i], value);
+					differs = differs || (value != other.next());
+				}
+				EXPECT_TRUE(differs);
+
+				// Other domains and seeds are other streams
+				EXPECT_NE(first[0], tgRandomStream(7, 3, 2, 1, 1).next());
+				EXPECT_NE(first[0], tgRandomStream(8, 3, 2, 1).next());
+
+				// Seeking replays a block
+				tgRandomStream sought(7, 3, 2, 1);
+				sought.seek(2);
+				EXPECT_EQ(first[8], sought.next());
+				EXPECT_EQ(first[9], sought.next());
+	}
+
+	TEST(tgRandomStreamTest, testDistributions) {
+
+				tgRandomStream stream(42);
+				const int n = 100000;
+				double sum = 0.0;
+				double sumOfSquares = 0.0;
+				for (int i = 0; i < n; i++) {
+					const double u = stream.uniform();
+					ASSERT_GE(u, 0.0);
+					ASSERT_LT(u, 1.0);
+					sum += u;
+				}
+				EXPECT_NEAR(0.5, sum / n, 0.01);
+
+				sum = 0.0;
+				for (int i = 0; i < n; i++) {
+					const double x = stream.normal(1.0, 2.0);
+					sum += x;
+					sumOfSquares += (x - 1.0) * (x - 1.0);
+				}
+				EXPECT_NEAR(1.0, sum / n, 0.05);
+				EXPECT_NEAR(2.0, sqrt(sumOfSquares / n), 0.05);
+
+				vector<int> counts(5, 0);
+				for (int i = 0; i < n; i++) {
+					const size_t k = stream.index(5);
+					ASSERT_LT(k, 5u);
+					counts[k]++;
+				}
+				for (size_t k = 0; k < counts.size(); k++) {
+					EXPECT_NEAR(n / 5, counts[k], n / 50);
+				}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
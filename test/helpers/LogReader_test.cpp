@@ -0,0 +1,163 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file LogReader_test.cpp
+* @brief Contains a test of streaming logs through LogReader and
+* LogSummary
+* $Id$
+*/
+
+// This application
+#include "helpers/LogReader.h"
+#include "helpers/LogSummary.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class LogReaderTest : public ::testing::Test {
+		protected:
+
+			LogReaderTest() :
+				fileName("LogReader_test.csv")
+			{
+			}
+
+			virtual ~LogReaderTest() {
+				remove(fileName.c_str());
+			}
+
+			void write(const string& contents) {
+				ofstream log(fileName.c_str());
+				log << contents;
+			}
+
+			const string fileName;
+	};
+
+	/** Two concatenated episodes in the format of tgDataObserver */
+	const char* const observerLog =
+		"Time,rod 0_X,rod 0_Y,rod 0_Z,rod 0_mass,saddle 0_RL,saddle 0_AL,saddle 0_Ten,\n"
+		"0.1,1,2,3,4,10,11,5,\n"
+		"0.2,2,2,3,4,9,11,7,\n"
+		"0.3,6,2,3,4,9.5,11,6,\n"
+		"Time,rod 0_X,rod 0_Y,rod 0_Z,rod 0_mass,saddle 0_RL,saddle 0_AL,saddle 0_Ten,\n"
+		"0.1,-1,0,0,4,10,11,1,\n"
+		"0.2,-3,0,0,4,8,11,1";
+
+	TEST_F(LogReaderTest, testProjection) {
+
+				write(observerLog);
+
+				// A small chunk, so lines are split between reads
+				CSVLogReader reader(fileName, 7);
+				ASSERT_EQ(8u, reader.getColumns().size());
+				EXPECT_EQ("saddle 0_Ten", reader.getColumns()[7]);
+
+				EXPECT_EQ(1u, reader.selectTagged("saddle", "Ten"));
+				EXPECT_EQ(4u, reader.selectTagged("rod"));
+				EXPECT_EQ(0u, reader.selectColumn("saddle 0_Ten"));
+				EXPECT_THROW(reader.selectColumn("rod 1_X"), std::invalid_argument);
+				EXPECT_THROW(reader.selectTagged("rod", "RL"), std::invalid_argument);
+
+				vector<double> row;
+				ASSERT_TRUE(reader.readRow(row));
+				ASSERT_EQ(5u, row.size());
+				EXPECT_EQ(5.0, row[0]);
+				EXPECT_EQ(1.0, row[1]);
+				EXPECT_EQ(4.0, row[4]);
+
+				// The repeated header is skipped
+				int rows = 1;
+				while (reader.readRow(row)) {
+					rows++;
+				}
+				EXPECT_EQ(5, rows);
+				EXPECT_EQ(1.0, row[0]);
+				EXPECT_EQ(-3.0, row[1]);
+	}
+
+	TEST_F(LogReaderTest, testEpisodes) {
+
+				write(observerLog);
+
+				CSVLogReader reader(fileName);
+				reader.selectColumn("rod 0_X");
+				LogSummary summary(reader, "Time", true);
+				ASSERT_EQ(1u, summary.getColumns().size());
+				EXPECT_EQ(1u, summary.getNumCables());
+
+				LogSummary::Episode episode;
+				ASSERT_TRUE(summary.nextEpisode(episode));
+				EXPECT_EQ(3u, episode.rows);
+				EXPECT_EQ(0.1, episode.startTime);
+				EXPECT_EQ(0.3, episode.endTime);
+				EXPECT_EQ(3.0, episode.columns[0].mean);
+				EXPECT_EQ(1.0, episode.columns[0].min);
+				EXPECT_EQ(6.0, episode.columns[0].max);
+				EXPECT_EQ(1.0, episode.columns[0].first);
+				EXPECT_EQ(6.0, episode.columns[0].final);
+				// Only the shortening from 10 to 9, at a tension of 5
+				EXPECT_EQ(5.0, episode.energy);
+
+				ASSERT_TRUE(summary.nextEpisode(episode));
+				EXPECT_EQ(2u, episode.rows);
+				EXPECT_EQ(-3.0, episode.columns[0].final);
+				EXPECT_EQ(2.0, episode.energy);
+
+				EXPECT_FALSE(summary.nextEpisode(episode));
+	}
+
+	TEST_F(LogReaderTest, testHeaderless) {
+
+				// As scores.csv: the two scores, then the parameters
+				write("1.5,-2,0.3,0.4\n2.5,-4,,0.6\n");
+
+				CSVLogReader reader(fileName);
+				ASSERT_EQ(4u, reader.getColumns().size());
+				reader.selectColumn("0");
+				reader.selectColumn("2");
+				LogSummary summary(reader);
+
+				LogSummary::Episode episode;
+				ASSERT_TRUE(summary.nextEpisode(episode));
+				EXPECT_EQ(2u, episode.rows);
+				EXPECT_EQ(2.0, episode.columns[0].mean);
+				EXPECT_EQ(2.5, episode.columns[0].max);
+				// The empty field is left out
+				EXPECT_EQ(1u, episode.columns[1].count);
+				EXPECT_EQ(0.3, episode.columns[1].final);
+				EXPECT_FALSE(summary.nextEpisode(episode));
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
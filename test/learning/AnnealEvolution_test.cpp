@@ -0,0 +1,171 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file AnnealEvolution_test.cpp
+* @brief Contains a test of writing and resuming AnnealEvolution
+* checkpoints
+* $Id$
+*/
+
+// This application
+#include "learning/AnnealEvolution/AnnealEvolution.h"
+#include "learning/AnnealEvolution/AnnealEvoMember.h"
+#include "learning/AnnealEvolution/CheckpointIO.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// POSIX
+#include <sys/stat.h>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	const char* const suffix = "checkpointTest";
+
+	/** Four members, two of them mutated each generation */
+	void writeConfig(const string& fileName, bool resume) {
+		ofstream config(fileName.c_str());
+		config << "learning = 1\n"
+			   << "startSeed = 0\n"
+			   << "numberOfActions = 3\n"
+			   << "numberOfStates = 0\n"
+			   << "numberOfControllers = 2\n"
+			   << "coevolution = 0\n"
+			   << "populationSize = 4\n"
+			   << "numberOfElementsToMutate = 2\n"
+			   << "numberOfTestsBetweenGenerations = 0\n"
+			   << "numberOfSubtests = 1\n"
+			   << "leniencyCoef = 0.5\n"
+			   << "compareAverageScores = 0\n"
+			   << "clearScoresBetweenGenerations = 0\n"
+			   << "MonteCarlo = 0\n"
+			   << "deviation = 0.1\n"
+			   << "randomSeed = 5\n"
+			   << "checkpointInterval = 1\n"
+			   << "resumeFromCheckpoint = " << resume << "\n";
+	}
+
+	string readFile(const string& fileName) {
+		ifstream file(fileName.c_str());
+		stringstream contents;
+		contents << file.rdbuf();
+		return contents.str();
+	}
+
+	/** Score an episode by its parameters alone */
+	void runEpisodes(AnnealEvolution& evo, int episodes) {
+		for (int i = 0; i < episodes; i++) {
+			vector<AnnealEvoMember*> controllers = evo.nextSetOfControllers();
+			double sum = 0.0;
+			for (size_t j = 0; j < controllers.size(); j++) {
+				for (size_t k = 0; k < controllers[j]->statelessParameters.size(); k++) {
+					sum += controllers[j]->statelessParameters[k];
+				}
+			}
+			vector<double> scores;
+			scores.push_back(sum);
+			scores.push_back(0.0);
+			evo.updateScores(scores);
+		}
+	}
+
+	TEST(AnnealEvolutionTest, testCheckpointIO) {
+
+				stringstream file;
+				vector<double> values;
+				values.push_back(1.5);
+				values.push_back(-2.0);
+				CheckpointIO::write(file, string("magic"));
+				CheckpointIO::write(file, values);
+				CheckpointIO::write(file, 7);
+
+				string magic;
+				vector<double> readValues;
+				int number;
+				CheckpointIO::read(file, magic, 5);
+				CheckpointIO::read(file, readValues);
+				CheckpointIO::read(file, number);
+				EXPECT_EQ("magic", magic);
+				EXPECT_EQ(values, readValues);
+				EXPECT_EQ(7, number);
+				EXPECT_THROW(CheckpointIO::read(file, number), std::runtime_error);
+
+				// Sizes over the caller's limit
+				file.clear();
+				file.seekg(0);
+				EXPECT_THROW(CheckpointIO::read(file, magic, 4), std::runtime_error);
+
+				// A corrupt size throws instead of allocating it
+				stringstream corrupt;
+				CheckpointIO::write(corrupt, static_cast<size_t>(1) << 60);
+				CheckpointIO::write(corrupt, 1.0);
+				EXPECT_THROW(CheckpointIO::read(corrupt, readValues), std::runtime_error);
+	}
+
+	TEST(AnnealEvolutionTest, testResume) {
+
+				mkdir("logs", 0755);
+				const string scoresPath = "logs/scores.csv";
+				const string evolutionPath = string("logs/evolution") + suffix + ".csv";
+				const string checkpointPath = string("logs/checkpoint-") + suffix + ".bin";
+				remove(scoresPath.c_str());
+				remove(checkpointPath.c_str());
+				writeConfig("AnnealEvolution_test.ini", false);
+				writeConfig("AnnealEvolution_test_resume.ini", true);
+
+				string scores;
+				string evolution;
+				{
+					// Checkpoints at the start of each generation: after
+					// episodes 4, 6 and 8, so episode 9 is logged after the last
+					AnnealEvolution evo(suffix, "AnnealEvolution_test.ini");
+					runEpisodes(evo, 9);
+					scores = readFile(scoresPath);
+					evolution = readFile(evolutionPath);
+				}
+				{
+					// Episode 9 is run again, and only logged once
+					AnnealEvolution evo(suffix, "AnnealEvolution_test_resume.ini");
+					EXPECT_EQ(5u, evo.getSeed());
+					runEpisodes(evo, 1);
+				}
+				EXPECT_EQ(scores, readFile(scoresPath));
+				EXPECT_EQ(evolution, readFile(evolutionPath));
+
+				remove(scoresPath.c_str());
+				remove(evolutionPath.c_str());
+				remove(checkpointPath.c_str());
+				remove("AnnealEvolution_test.ini");
+				remove("AnnealEvolution_test_resume.ini");
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
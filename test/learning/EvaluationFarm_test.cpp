@@ -0,0 +1,149 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file EvaluationFarm_test.cpp
+* @brief Contains a test of running jobs in the worker processes of
+* EvaluationFarm
+* $Id$
+*/
+
+// This application
+#include "learning/EvaluationFarm/EvaluationFarm.h"
+// The C++ Standard Library
+#include <stdexcept>
+#include <vector>
+// POSIX
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	/**
+	 * Sums the parameters, unless the first is negative: -1 kills the
+	 * worker, -2 throws, -3 takes longer than the timeout and -4 explodes
+	 */
+	class SumWorker : public EvaluationFarm::Worker {
+		public:
+			virtual vector<double>
+			evaluate(const vector< vector<double> >& parameters) {
+				const double first = parameters[0][0];
+				if (first == -1.0) {
+					_exit(1);
+				}
+				else if (first == -2.0) {
+					throw std::runtime_error("Test failure");
+				}
+				else if (first == -3.0) {
+					sleep(10);
+				}
+				else if (first == -4.0) {
+					return vector<double>();
+				}
+
+				double sum = 0.0;
+				for (size_t i = 0; i < parameters.size(); i++) {
+					for (size_t j = 0; j < parameters[i].size(); j++) {
+						sum += parameters[i][j];
+					}
+				}
+				vector<double> scores;
+				scores.push_back(sum);
+				scores.push_back(getpid());
+				return scores;
+			}
+	};
+
+	vector< vector<double> > job(double first, double second) {
+		vector< vector<double> > parameters(2);
+		parameters[0].push_back(first);
+		parameters[1].push_back(second);
+		parameters[1].push_back(1.0);
+		return parameters;
+	}
+
+	TEST(EvaluationFarmTest, testEvaluate) {
+
+				SumWorker worker;
+				EvaluationFarm farm(worker, 2);
+				ASSERT_EQ(2u, farm.getNumWorkers());
+
+				vector< vector< vector<double> > > jobs;
+				for (int i = 0; i < 6; i++) {
+					jobs.push_back(job(i, 0.5));
+				}
+				vector<EvaluationFarm::Result> results = farm.evaluate(jobs);
+				ASSERT_EQ(jobs.size(), results.size());
+				for (size_t i = 0; i < results.size(); i++) {
+					EXPECT_EQ(EvaluationFarm::completed, results[i].status);
+					ASSERT_EQ(2u, results[i].scores.size());
+					EXPECT_EQ(i + 1.5, results[i].scores[0]);
+					// In a worker, not here
+					EXPECT_NE(getpid(), results[i].scores[1]);
+				}
+				EXPECT_EQ(0u, farm.getNumRespawns());
+	}
+
+	TEST(EvaluationFarmTest, testFailures) {
+
+				SumWorker worker;
+				EvaluationFarm farm(worker, 2, 0.5);
+
+				vector< vector< vector<double> > > jobs;
+				jobs.push_back(job(1.0, 0.0));
+				jobs.push_back(job(-1.0, 0.0));
+				jobs.push_back(job(-2.0, 0.0));
+				jobs.push_back(job(-3.0, 0.0));
+				jobs.push_back(job(-4.0, 0.0));
+				jobs.push_back(job(2.0, 0.0));
+				vector<EvaluationFarm::Result> results = farm.evaluate(jobs);
+				ASSERT_EQ(jobs.size(), results.size());
+
+				EXPECT_EQ(EvaluationFarm::completed, results[0].status);
+				EXPECT_EQ(2.0, results[0].scores[0]);
+				EXPECT_EQ(EvaluationFarm::crashed, results[1].status);
+				EXPECT_TRUE(results[1].scores.empty());
+				EXPECT_EQ(EvaluationFarm::failed, results[2].status);
+				EXPECT_TRUE(results[2].scores.empty());
+				EXPECT_EQ(EvaluationFarm::timedOut, results[3].status);
+				EXPECT_TRUE(results[3].scores.empty());
+				// An explosion is the worker's answer, not a failure
+				EXPECT_EQ(EvaluationFarm::completed, results[4].status);
+				EXPECT_TRUE(results[4].scores.empty());
+				EXPECT_EQ(EvaluationFarm::completed, results[5].status);
+				EXPECT_EQ(3.0, results[5].scores[0]);
+
+				// The dead and the timed out workers were replaced
+				EXPECT_EQ(2u, farm.getNumRespawns());
+				results = farm.evaluate(vector< vector< vector<double> > >(3, job(1.0, 1.0)));
+				for (size_t i = 0; i < results.size(); i++) {
+					EXPECT_EQ(EvaluationFarm::completed, results[i].status);
+					EXPECT_EQ(3.0, results[i].scores[0]);
+				}
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
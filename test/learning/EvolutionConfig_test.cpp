@@ -0,0 +1,190 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file EvolutionConfig_test.cpp
+* @brief Contains a test of parsing and checking learning configuration
+* files with EvolutionConfig
+* $Id$
+*/
+
+// This application
+#include "learning/Configuration/configuration.h"
+#include "learning/Configuration/EvolutionConfig.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	/** Every key that AnnealEvolution requires */
+	configuration annealConfig() {
+		configuration config;
+		config.data["learning"] = "1";
+		config.data["startSeed"] = "0";
+		config.data["numberOfActions"] = "4";
+		config.data["numberOfStates"] = "0";
+		config.data["numberOfControllers"] = "2";
+		config.data["coevolution"] = "0";
+		config.data["populationSize"] = "10";
+		config.data["numberOfElementsToMutate"] = "3";
+		config.data["numberOfTestsBetweenGenerations"] = "0";
+		config.data["numberOfSubtests"] = "1";
+		config.data["leniencyCoef"] = "0.25";
+		config.data["compareAverageScores"] = "0";
+		config.data["clearScoresBetweenGenerations"] = "1";
+		config.data["MonteCarlo"] = "0";
+		config.data["deviation"] = "0.1";
+		return config;
+	}
+
+	/** The message of the exception from data, empty if none */
+	string problems(const configuration& data,
+					EvolutionConfig::Algorithm algorithm) {
+		try {
+			EvolutionConfig config(data, algorithm, "test.ini");
+		}
+		catch (const std::invalid_argument& e) {
+			return e.what();
+		}
+		return "";
+	}
+
+	TEST(EvolutionConfigTest, testParse) {
+
+				const EvolutionConfig config(annealConfig(), EvolutionConfig::annealEvolution);
+				EXPECT_TRUE(config.learning);
+				EXPECT_FALSE(config.startSeed);
+				EXPECT_EQ(4, config.numberOfActions);
+				EXPECT_EQ(2, config.numberOfControllers);
+				EXPECT_EQ(10, config.populationSize);
+				EXPECT_EQ(3, config.numberOfElementsToMutate);
+				EXPECT_EQ(0.25, config.leniencyCoef);
+				EXPECT_TRUE(config.clearScoresBetweenGenerations);
+				EXPECT_EQ(0.1, config.deviation);
+				// Application specific keys are kept
+				EXPECT_EQ("10", config.data.getStringValue("populationSize"));
+	}
+
+	TEST(EvolutionConfigTest, testOptional) {
+
+				// Optional keys default to 0
+				configuration data = annealConfig();
+				const EvolutionConfig defaults(data, EvolutionConfig::annealEvolution);
+				EXPECT_FALSE(defaults.useFitnessCache);
+				EXPECT_EQ(0u, defaults.scenarioSeed);
+				EXPECT_EQ(0, defaults.checkpointInterval);
+				EXPECT_FALSE(defaults.resumeFromCheckpoint);
+				EXPECT_EQ(0u, defaults.randomSeed);
+				// NeuroEvolution's keys aren't required for AnnealEvolution
+				EXPECT_EQ(0, defaults.numberHidden);
+
+				data.data["useFitnessCache"] = "1";
+				data.data["scenarioSeed"] = "12";
+				data.data["checkpointInterval"] = "5";
+				data.data["randomSeed"] = "4294967295";
+				const EvolutionConfig set(data, EvolutionConfig::annealEvolution);
+				EXPECT_TRUE(set.useFitnessCache);
+				EXPECT_EQ(12u, set.scenarioSeed);
+				EXPECT_EQ(5, set.checkpointInterval);
+				EXPECT_EQ(4294967295ul, set.randomSeed);
+
+				// And the other way around
+				data = annealConfig();
+				data.data.erase("MonteCarlo");
+				data.data.erase("deviation");
+				data.data["numberHidden"] = "6";
+				data.data["numberOfChildren"] = "2";
+				const EvolutionConfig neuro(data, EvolutionConfig::neuroEvolution);
+				EXPECT_EQ(6, neuro.numberHidden);
+				EXPECT_EQ(2, neuro.numberOfChildren);
+				EXPECT_NE("", problems(data, EvolutionConfig::annealEvolution));
+	}
+
+	TEST(EvolutionConfigTest, testProblems) {
+
+				EXPECT_EQ("", problems(annealConfig(), EvolutionConfig::annealEvolution));
+
+				// Every problem is reported at once, with the source
+				configuration data = annealConfig();
+				data.data.erase("populationSize");
+				data.data["numberOfActions"] = "four";
+				data.data["leniencyCoef"] = "1.5";
+				data.data["randomSeed"] = "4294967296";
+				const string message = problems(data, EvolutionConfig::annealEvolution);
+				EXPECT_NE(string::npos, message.find("test.ini"));
+				EXPECT_NE(string::npos, message.find("missing key populationSize"));
+				EXPECT_NE(string::npos, message.find("numberOfActions = four"));
+				EXPECT_NE(string::npos, message.find("leniencyCoef must be"));
+				EXPECT_NE(string::npos, message.find("randomSeed does not fit"));
+
+				// Trailing junk isn't a number either
+				data = annealConfig();
+				data.data["populationSize"] = "10x";
+				EXPECT_NE(string::npos, problems(data, EvolutionConfig::annealEvolution)
+						  .find("populationSize = 10x"));
+
+				// Subtests only matter when learning
+				data = annealConfig();
+				data.data["numberOfSubtests"] = "0";
+				EXPECT_NE(string::npos, problems(data, EvolutionConfig::annealEvolution)
+						  .find("numberOfSubtests must be positive"));
+				data.data["learning"] = "0";
+				EXPECT_EQ("", problems(data, EvolutionConfig::annealEvolution));
+
+				data = annealConfig();
+				data.data["numberOfElementsToMutate"] = "11";
+				EXPECT_NE(string::npos, problems(data, EvolutionConfig::annealEvolution)
+						  .find("numberOfElementsToMutate must be"));
+	}
+
+	TEST(EvolutionConfigTest, testLoad) {
+
+				const string fileName = "EvolutionConfig_test.ini";
+				{
+					ofstream file(fileName.c_str());
+					const configuration data = annealConfig();
+					for (map<string, string>::const_iterator it = data.data.begin();
+						 it != data.data.end(); ++it) {
+						file << it->first << " = " << it->second << endl;
+					}
+				}
+
+				// Parsed once, then the same object
+				const EvolutionConfig& first =
+					EvolutionConfig::load(fileName, EvolutionConfig::annealEvolution);
+				remove(fileName.c_str());
+				const EvolutionConfig& second =
+					EvolutionConfig::load(fileName, EvolutionConfig::annealEvolution);
+				EXPECT_EQ(&first, &second);
+				EXPECT_EQ(10, second.populationSize);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
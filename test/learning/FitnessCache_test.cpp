@@ -0,0 +1,158 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file FitnessCache_test.cpp
+* @brief Contains a test of the scores cached by FitnessCache
+* $Id$
+*/
+
+// This application
+#include "learning/FitnessCache/FitnessCache.h"
+// The C++ Standard Library
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class FitnessCacheTest : public ::testing::Test {
+		protected:
+
+			FitnessCacheTest() :
+				fileName("FitnessCache_test.csv")
+			{
+				remove(fileName.c_str());
+				params.push_back(vector<double>(1, 0.25));
+				params.push_back(vector<double>(2, 0.5));
+				scores.push_back(3.0);
+				scores.push_back(-1.5);
+			}
+
+			virtual ~FitnessCacheTest() {
+				remove(fileName.c_str());
+			}
+
+			const string fileName;
+			FitnessCache::Parameters params;
+			vector<double> scores;
+	};
+
+	TEST_F(FitnessCacheTest, testHash) {
+
+				// Fixed, so the keys in a file are the same on every platform:
+				// FNV-1a of the eight zero bytes of the seed
+				EXPECT_EQ(FitnessCache::hashParameters(params, 7),
+						  FitnessCache::hashParameters(params, 7));
+				EXPECT_NE(FitnessCache::hashParameters(params, 7),
+						  FitnessCache::hashParameters(params, 8));
+				EXPECT_EQ(0xa8c7f832281a39c5ULL,
+						  FitnessCache::hashParameters(FitnessCache::Parameters(), 0));
+
+				// -0.0 and 0.0 give the same simulation
+				FitnessCache::Parameters zero(1, vector<double>(1, 0.0));
+				FitnessCache::Parameters negativeZero(1, vector<double>(1, -0.0));
+				EXPECT_EQ(FitnessCache::hashParameters(zero, 0),
+						  FitnessCache::hashParameters(negativeZero, 0));
+
+				// {a}{b,c} and {a,b}{c} are different controllers
+				FitnessCache::Parameters first(2);
+				first[0].push_back(1.0);
+				first[1].push_back(2.0);
+				first[1].push_back(3.0);
+				FitnessCache::Parameters second(2);
+				second[0].push_back(1.0);
+				second[0].push_back(2.0);
+				second[1].push_back(3.0);
+				EXPECT_NE(FitnessCache::hashParameters(first, 0),
+						  FitnessCache::hashParameters(second, 0));
+	}
+
+	TEST_F(FitnessCacheTest, testInsertLookup) {
+
+				FitnessCache cache("");
+				vector<double> found;
+				EXPECT_FALSE(cache.lookup(params, 0, found));
+
+				EXPECT_TRUE(cache.insert(params, 0, scores));
+				ASSERT_TRUE(cache.lookup(params, 0, found));
+				EXPECT_EQ(scores, found);
+
+				// The first scores are kept
+				EXPECT_FALSE(cache.insert(params, 0, vector<double>(2, 1.0)));
+				ASSERT_TRUE(cache.lookup(params, 0, found));
+				EXPECT_EQ(scores, found);
+
+				// A scenario with another seed is another entry
+				EXPECT_FALSE(cache.lookup(params, 1, found));
+
+				FitnessCache::Parameters other(params);
+				other[1][1] = 0.75;
+				EXPECT_FALSE(cache.lookup(other, 0, found));
+
+				// Failed episodes aren't cached
+				EXPECT_FALSE(cache.insert(other, 0, vector<double>()));
+				EXPECT_FALSE(cache.insert(other, 0,
+					vector<double>(2, numeric_limits<double>::quiet_NaN())));
+				EXPECT_FALSE(cache.insert(other, 0,
+					vector<double>(2, numeric_limits<double>::infinity())));
+				EXPECT_FALSE(cache.lookup(other, 0, found));
+				EXPECT_EQ(1u, cache.size());
+	}
+
+	TEST_F(FitnessCacheTest, testReload) {
+
+				FitnessCache::Parameters other(params);
+				other[0][0] = 1.0 / 3.0;
+				{
+					FitnessCache cache(fileName);
+					cache.insert(params, 0, scores);
+					cache.insert(other, 5, vector<double>(2, 0.1));
+				}
+				{
+					// A line of an older version, and a truncated one
+					ofstream file(fileName.c_str(), ios::app);
+					file << "1234abcd,0.5,0.25" << endl;
+					file << "1234abcd,0,2,1,0.25" << endl;
+				}
+
+				FitnessCache cache(fileName);
+				EXPECT_EQ(2u, cache.size());
+				EXPECT_EQ(2u, cache.getNumSkipped());
+
+				// Every bit of the values comes back
+				vector<double> found;
+				ASSERT_TRUE(cache.lookup(params, 0, found));
+				EXPECT_EQ(scores, found);
+				ASSERT_TRUE(cache.lookup(other, 5, found));
+				EXPECT_EQ(vector<double>(2, 0.1), found);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
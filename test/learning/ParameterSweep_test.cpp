@@ -0,0 +1,152 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file ParameterSweep_test.cpp
+* @brief Contains a test of the points ParameterSweep makes
+* $Id$
+*/
+
+// This application
+#include "learning/ParameterSweep/ParameterSweep.h"
+// The C++ Standard Library
+#include <cmath>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class ParameterSweepTest : public ::testing::Test {
+		protected:
+
+			ParameterSweepTest() :
+				sweep(vector<string>(1, "metric"))
+			{
+				sweep.addParameter("linear", -1.0, 3.0, 3);
+				sweep.addParameter("log", 1.0, 100.0, 2, true);
+				sweep.addParameter("fixed", 2.0, 4.0, 1);
+			}
+
+			/** Back to [0, 1], the inverse of the parameters' scales */
+			double unscale(size_t j, double value) {
+				const double min[] = {-1.0, 1.0, 2.0};
+				const double max[] = {3.0, 100.0, 4.0};
+				if (j == 1) {
+					return log(value / min[j]) / log(max[j] / min[j]);
+				}
+				return (value - min[j]) / (max[j] - min[j]);
+			}
+
+			ParameterSweep sweep;
+	};
+
+	TEST_F(ParameterSweepTest, testGrid) {
+
+				const vector< vector<double> > points =
+					sweep.makePoints(ParameterSweep::grid);
+				ASSERT_EQ(3u * 2u * 1u, points.size());
+
+				// Every combination once, the last parameter counts fastest
+				set< vector<double> > distinct(points.begin(), points.end());
+				EXPECT_EQ(points.size(), distinct.size());
+				const double linear[] = {-1.0, -1.0, 1.0, 1.0, 3.0, 3.0};
+				const double logs[] = {1.0, 100.0, 1.0, 100.0, 1.0, 100.0};
+				for (size_t i = 0; i < points.size(); i++) {
+					ASSERT_EQ(3u, points[i].size());
+					EXPECT_DOUBLE_EQ(linear[i], points[i][0]);
+					EXPECT_DOUBLE_EQ(logs[i], points[i][1]);
+					// One level is the middle of the range
+					EXPECT_DOUBLE_EQ(3.0, points[i][2]);
+				}
+
+				// The middle of a log scale is the geometric mean
+				ParameterSweep three(vector<string>(1, "metric"));
+				three.addParameter("log", 1.0, 100.0, 3, true);
+				EXPECT_DOUBLE_EQ(10.0, three.makePoints(ParameterSweep::grid)[1][0]);
+	}
+
+	TEST_F(ParameterSweepTest, testLatinHypercube) {
+
+				const size_t samples = 17;
+				const vector< vector<double> > points =
+					sweep.makePoints(ParameterSweep::latinHypercube, samples, 5);
+				ASSERT_EQ(samples, points.size());
+
+				// Each parameter draws once from each of its strata
+				for (size_t j = 0; j < 3; j++) {
+					vector<int> strata(samples, 0);
+					for (size_t i = 0; i < samples; i++) {
+						const double u = unscale(j, points[i][j]);
+						ASSERT_GE(u, 0.0);
+						ASSERT_LT(u, 1.0);
+						strata[static_cast<size_t>(u * samples)]++;
+					}
+					for (size_t k = 0; k < samples; k++) {
+						EXPECT_EQ(1, strata[k]);
+					}
+				}
+
+				EXPECT_EQ(points,
+						  sweep.makePoints(ParameterSweep::latinHypercube, samples, 5));
+				EXPECT_NE(points,
+						  sweep.makePoints(ParameterSweep::latinHypercube, samples, 6));
+	}
+
+	TEST_F(ParameterSweepTest, testMonteCarlo) {
+
+				const vector< vector<double> > points =
+					sweep.makePoints(ParameterSweep::monteCarlo, 100, 3);
+				ASSERT_EQ(100u, points.size());
+				for (size_t i = 0; i < points.size(); i++) {
+					for (size_t j = 0; j < 3; j++) {
+						const double u = unscale(j, points[i][j]);
+						EXPECT_GE(u, 0.0);
+						EXPECT_LE(u, 1.0);
+					}
+				}
+				EXPECT_EQ(points, sweep.makePoints(ParameterSweep::monteCarlo, 100, 3));
+	}
+
+	TEST_F(ParameterSweepTest, testInvalid) {
+
+				EXPECT_THROW(sweep.addParameter("backwards", 2.0, 1.0),
+							 std::invalid_argument);
+				EXPECT_THROW(sweep.addParameter("none", 1.0, 2.0, 0),
+							 std::invalid_argument);
+				EXPECT_THROW(sweep.addParameter("zero", 0.0, 1.0, 2, true),
+							 std::invalid_argument);
+				EXPECT_EQ(3u, sweep.getNumParameters());
+
+				ParameterSweep empty(vector<string>(1, "metric"));
+				EXPECT_THROW(empty.makePoints(ParameterSweep::grid),
+							 std::runtime_error);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,172 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file StateFork_test.cpp
+* @brief Contains a test of forking continuations with StateFork and of
+* the ProcessIO helpers it shares with EvaluationFarm
+* $Id$
+*/
+
+// This application
+#include "learning/StateFork/StateFork.h"
+#include "learning/EvaluationFarm/ProcessIO.h"
+// The C++ Standard Library
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+// POSIX
+#include <unistd.h>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	/**
+	 * A stand in for a warmed up simulation: its state is set before
+	 * forking, and each continuation steps it further. A first parameter
+	 * of -1 kills the child, -2 throws and -3 takes longer than the
+	 * timeout.
+	 */
+	class CountingContinuation : public StateFork::Continuation {
+		public:
+			CountingContinuation() :
+				state(0.0),
+				history(1000)
+			{
+			}
+
+			virtual vector<double>
+			run(const vector< vector<double> >& parameters) {
+				const double first = parameters[0][0];
+				if (first == -1.0) {
+					_exit(1);
+				}
+				else if (first == -2.0) {
+					throw std::runtime_error("Test failure");
+				}
+				else if (first == -3.0) {
+					sleep(10);
+				}
+
+				// Continue from the forked state
+				for (size_t i = 0; i < parameters[0].size(); i++) {
+					state += parameters[0][i];
+				}
+				vector<double> scores(history);
+				scores.push_back(state);
+				return scores;
+			}
+
+			double state;
+			vector<double> history;
+	};
+
+	vector< vector<double> > variant(double first, double second) {
+		vector< vector<double> > parameters(1);
+		parameters[0].push_back(first);
+		parameters[0].push_back(second);
+		return parameters;
+	}
+
+	TEST(StateForkTest, testRoundTrip) {
+
+				CountingContinuation continuation;
+				// Warm up, with values that only survive a bitwise copy
+				for (size_t i = 0; i < continuation.history.size(); i++) {
+					continuation.history[i] = std::sin(i + 0.1) / 3.0;
+				}
+				continuation.state = 10.0;
+
+				vector< vector< vector<double> > > variants;
+				for (int i = 0; i < 5; i++) {
+					variants.push_back(variant(i, 0.5));
+				}
+
+				StateFork fork(2);
+				const vector< vector<double> > results =
+					fork.run(continuation, variants);
+				ASSERT_EQ(variants.size(), results.size());
+				for (size_t i = 0; i < results.size(); i++) {
+					ASSERT_EQ(continuation.history.size() + 1, results[i].size());
+					for (size_t j = 0; j < continuation.history.size(); j++) {
+						ASSERT_EQ(continuation.history[j], results[i][j]);
+					}
+					EXPECT_EQ(10.5 + i, results[i].back());
+				}
+				EXPECT_EQ(0u, fork.getNumFailures());
+
+				// The parent wasn't stepped
+				EXPECT_EQ(10.0, continuation.state);
+	}
+
+	TEST(StateForkTest, testFailures) {
+
+				CountingContinuation continuation;
+				vector< vector< vector<double> > > variants;
+				variants.push_back(variant(-1.0, 0.0));
+				variants.push_back(variant(1.0, 0.0));
+				variants.push_back(variant(-2.0, 0.0));
+				variants.push_back(variant(-3.0, 0.0));
+
+				StateFork fork(4, 0.5);
+				const vector< vector<double> > results =
+					fork.run(continuation, variants);
+				ASSERT_EQ(4u, results.size());
+				EXPECT_TRUE(results[0].empty());
+				ASSERT_FALSE(results[1].empty());
+				EXPECT_EQ(1.0, results[1].back());
+				EXPECT_TRUE(results[2].empty());
+				EXPECT_TRUE(results[3].empty());
+				EXPECT_EQ(3u, fork.getNumFailures());
+
+				EXPECT_THROW(StateFork(1, -1.0), std::invalid_argument);
+	}
+
+	TEST(StateForkTest, testReadVectorLimit) {
+
+				int fds[2];
+				ASSERT_EQ(0, pipe(fds));
+
+				vector<double> values(3, 1.5);
+				ASSERT_TRUE(ProcessIO::writeVector(fds[1], values));
+				vector<double> read;
+				EXPECT_TRUE(ProcessIO::readVector(fds[0], read, 3));
+				EXPECT_EQ(values, read);
+
+				// A size over the limit fails before anything is allocated
+				ASSERT_TRUE(ProcessIO::writeVector(fds[1], values));
+				EXPECT_FALSE(ProcessIO::readVector(fds[0], read, 2));
+
+				// As does a closed pipe
+				close(fds[1]);
+				vector<double> rest(3);
+				ProcessIO::readAll(fds[0], &rest[0], 3 * sizeof(double));
+				EXPECT_FALSE(ProcessIO::readVector(fds[0], read, 3));
+				close(fds[0]);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
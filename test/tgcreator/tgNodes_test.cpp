@@ -0,0 +1,132 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgNodes_test.cpp
+* @brief Contains a test of looking nodes up by position in tgNodes
+* $Id$
+*/
+
+// This application
+#include "tgcreator/tgNodes.h"
+// The Bullet Physics Library
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class tgNodesTest : public ::testing::Test {
+		protected:
+			
+			tgNodesTest() {
+				// A 10 by 10 lattice, in units smaller and larger than a cell
+				for (int i = 0; i < 100; i++) {
+					nodes.addNode(0.5 * (i % 10), 0.005 * (i / 10), 1.0);
+				}
+			}
+			
+			tgNodes nodes;
+	};
+
+	TEST_F(tgNodesTest, testExactLookup) {
+				
+				EXPECT_EQ(0, nodes.findNode(btVector3(0.0, 0.0, 1.0)));
+				EXPECT_EQ(37, nodes.findNode(btVector3(3.5, 0.015, 1.0)));
+				
+				// Exact by default, as btVector3::operator==
+				EXPECT_EQ(-1, nodes.findNode(btVector3(3.5 + 1.0e-12, 0.015, 1.0)));
+				EXPECT_EQ(37, nodes.findNode(btVector3(3.5 + 1.0e-12, 0.015, 1.0), 1.0e-9));
+				
+				// Every node finds itself
+				const tgNodes& constNodes = nodes;
+				for (int i = 0; i < constNodes.size(); i++) {
+					EXPECT_EQ(i, constNodes.findNode(constNodes[i]));
+				}
+	}
+
+	TEST_F(tgNodesTest, testLookupAfterChanges) {
+				
+				EXPECT_EQ(1, nodes.findNode(btVector3(0.5, 0.0, 1.0)));
+				
+				// Moving everything rehashes on the next lookup
+				nodes.move(btVector3(1.0, 0.0, 0.0));
+				EXPECT_EQ(-1, nodes.findNode(btVector3(0.5, 0.0, 1.0)));
+				EXPECT_EQ(1, nodes.findNode(btVector3(1.5, 0.0, 1.0)));
+				
+				// So does moving one through a reference
+				nodes[1] += btVector3(0.0, 0.0, 5.0);
+				EXPECT_EQ(-1, nodes.findNode(btVector3(1.5, 0.0, 1.0)));
+				
+				// An added node is found without rehashing
+				nodes.addNode(1.5, 0.0, 1.0);
+				EXPECT_EQ(nodes.size() - 1, nodes.findNode(btVector3(1.5, 0.0, 1.0)));
+	}
+
+	TEST_F(tgNodesTest, testLookupAfterOperators) {
+				
+				EXPECT_EQ(2, nodes.findNode(btVector3(1.0, 0.0, 1.0)));
+				
+				// Removing a node moves the later ones down
+				nodes -= tgNode(0.5, 0.0, 1.0);
+				ASSERT_EQ(99, nodes.size());
+				EXPECT_EQ(-1, nodes.findNode(btVector3(0.5, 0.0, 1.0)));
+				EXPECT_EQ(1, nodes.findNode(btVector3(1.0, 0.0, 1.0)));
+				
+				nodes += tgNode(0.5, 0.0, 1.0);
+				EXPECT_EQ(99, nodes.findNode(btVector3(0.5, 0.0, 1.0)));
+				
+				tgNode first(0.0, 0.0, 1.0);
+				tgNode far(-1.0e9, 1.0e9, -1.0e9);
+				std::vector<tgNode*> some;
+				some.push_back(&first);
+				nodes -= some;
+				EXPECT_EQ(-1, nodes.findNode(btVector3(0.0, 0.0, 1.0)));
+				EXPECT_EQ(0, nodes.findNode(btVector3(1.0, 0.0, 1.0)));
+				
+				// Cells far from the origin hash without overflowing
+				some[0] = &far;
+				nodes += some;
+				EXPECT_EQ(99, nodes.findNode(far));
+	}
+
+	TEST_F(tgNodesTest, testToleranceLookup) {
+				
+				// Halfway between two nodes, straddling cell boundaries
+				const std::vector<int> found =
+					nodes.findNodes(btVector3(0.5, 0.0075, 1.0), 0.0025 + 1.0e-9);
+				ASSERT_EQ(2u, found.size());
+				EXPECT_EQ(11, found[0]);
+				EXPECT_EQ(21, found[1]);
+				EXPECT_EQ(11, nodes.findNode(btVector3(0.5, 0.0075, 1.0), 0.0025 + 1.0e-9));
+				
+				// A tolerance spanning many cells checks every node
+				EXPECT_EQ(100u, nodes.findNodes(btVector3(0.0, 0.0, 0.0), 1.0e6).size());
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
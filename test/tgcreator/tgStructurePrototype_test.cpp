@@ -0,0 +1,202 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgStructurePrototype_test.cpp
+* @brief Contains a test of building instances with tgStructurePrototype
+* $Id$
+*/
+
+// This application
+#include "core/tgBasicActuator.h"
+#include "core/tgCast.h"
+#include "core/tgModel.h"
+#include "core/tgRod.h"
+#include "core/tgWorld.h"
+#include "tgcreator/tgBasicActuatorInfo.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+#include "tgcreator/tgStructurePrototype.h"
+// The Bullet Physics Library
+#include "BulletDynamics/Dynamics/btRigidBody.h"
+#include "LinearMath/btTransform.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class tgStructurePrototypeTest : public ::testing::Test {
+		protected:
+
+			tgStructurePrototypeTest() :
+				rodConfig(0.2, 0.3),
+				muscleConfig(1000.0, 10.0, 500.0)
+			{
+				// The prism of the 3_prism example
+				structure.addNode(-2.5, 1.0, 0.0);
+				structure.addNode( 2.5, 1.0, 0.0);
+				structure.addNode( 0.0, 1.0, 4.0);
+				structure.addNode(-2.5, 6.0, 0.0);
+				structure.addNode( 2.5, 6.0, 0.0);
+				structure.addNode( 0.0, 6.0, 4.0);
+
+				structure.addPair(0, 4, "rod");
+				structure.addPair(1, 5, "rod");
+				structure.addPair(2, 3, "rod");
+
+				structure.addPair(0, 1, "muscle");
+				structure.addPair(1, 2, "muscle");
+				structure.addPair(2, 0, "muscle");
+				structure.addPair(3, 4, "muscle");
+				structure.addPair(4, 5, "muscle");
+				structure.addPair(5, 3, "muscle");
+				structure.addPair(0, 3, "muscle");
+				structure.addPair(1, 4, "muscle");
+				structure.addPair(2, 5, "muscle");
+
+				spec.addBuilder("rod", new tgRodInfo(rodConfig));
+				spec.addBuilder("muscle", new tgBasicActuatorInfo(muscleConfig));
+			}
+
+			/** Expect instance to be expected moved by offset */
+			void expectSame(tgModel& expected, tgModel& instance,
+							const btVector3& offset) {
+				const vector<tgRod*> expectedRods =
+					tgCast::filter<tgModel, tgRod>(expected.getDescendants());
+				const vector<tgRod*> rods =
+					tgCast::filter<tgModel, tgRod>(instance.getDescendants());
+				ASSERT_EQ(3u, expectedRods.size());
+				ASSERT_EQ(expectedRods.size(), rods.size());
+				for (size_t i = 0; i < rods.size(); i++) {
+					EXPECT_TRUE(expectedRods[i]->getTags().asSet() == rods[i]->getTags().asSet());
+					EXPECT_DOUBLE_EQ(expectedRods[i]->mass(), rods[i]->mass());
+					EXPECT_DOUBLE_EQ(expectedRods[i]->length(), rods[i]->length());
+					const btVector3 moved =
+						expectedRods[i]->centerOfMass() + offset;
+					EXPECT_NEAR(0.0, moved.distance(rods[i]->centerOfMass()), 1.0e-9);
+					EXPECT_NEAR(0.0,
+						(expectedRods[i]->orientation() -
+						 rods[i]->orientation()).length(), 1.0e-9);
+
+					const btRigidBody* expectedBody = expectedRods[i]->getPRigidBody();
+					const btRigidBody* body = rods[i]->getPRigidBody();
+					EXPECT_NE(expectedBody, body);
+					EXPECT_DOUBLE_EQ(expectedBody->getInvMass(), body->getInvMass());
+					EXPECT_NEAR(0.0, (expectedBody->getInvInertiaDiagLocal() -
+									  body->getInvInertiaDiagLocal()).length(),
+								1.0e-12);
+				}
+
+				const vector<tgBasicActuator*> expectedCables =
+					tgCast::filter<tgModel, tgBasicActuator>(expected.getDescendants());
+				const vector<tgBasicActuator*> cables =
+					tgCast::filter<tgModel, tgBasicActuator>(instance.getDescendants());
+				ASSERT_EQ(9u, expectedCables.size());
+				ASSERT_EQ(expectedCables.size(), cables.size());
+				for (size_t i = 0; i < cables.size(); i++) {
+					EXPECT_TRUE(expectedCables[i]->getTags().asSet() == cables[i]->getTags().asSet());
+					EXPECT_NEAR(expectedCables[i]->getRestLength(),
+								cables[i]->getRestLength(), 1.0e-9);
+					EXPECT_NEAR(expectedCables[i]->getCurrentLength(),
+								cables[i]->getCurrentLength(), 1.0e-9);
+					EXPECT_NEAR(expectedCables[i]->getTension(),
+								cables[i]->getTension(), 1.0e-6);
+				}
+			}
+
+			const tgRod::Config rodConfig;
+			const tgBasicActuator::Config muscleConfig;
+			tgStructure structure;
+			tgBuildSpec spec;
+	};
+
+	TEST_F(tgStructurePrototypeTest, testInstancesMatchStructureInfo) {
+
+				tgStructurePrototype prototype(structure, spec);
+				tgWorld world;
+
+				tgModel direct;
+				tgStructureInfo structureInfo(structure, spec);
+				structureInfo.buildInto(direct, world);
+
+				tgModel first;
+				prototype.instantiate(first, world);
+
+				tgModel second;
+				const btVector3 offset(10.0, 0.0, -3.0);
+				btTransform transform;
+				transform.setIdentity();
+				transform.setOrigin(offset);
+				prototype.instantiate(second, world, transform);
+				EXPECT_EQ(2u, prototype.getNumInstances());
+
+				expectSame(direct, first, btVector3(0.0, 0.0, 0.0));
+				expectSame(direct, second, offset);
+
+				// Both instances share their collision shapes
+				const vector<tgRod*> firstRods =
+					tgCast::filter<tgModel, tgRod>(first.getDescendants());
+				const vector<tgRod*> secondRods =
+					tgCast::filter<tgModel, tgRod>(second.getDescendants());
+				for (size_t i = 0; i < firstRods.size(); i++) {
+					EXPECT_EQ(firstRods[i]->getPRigidBody()->getCollisionShape(),
+							  secondRods[i]->getPRigidBody()->getCollisionShape());
+				}
+
+				direct.teardown();
+				first.teardown();
+				second.teardown();
+	}
+
+	TEST_F(tgStructurePrototypeTest, testInstancesAfterReset) {
+
+				tgStructurePrototype prototype(structure, spec);
+				tgWorld world;
+
+				tgModel direct;
+				tgStructureInfo structureInfo(structure, spec);
+				structureInfo.buildInto(direct, world);
+
+				tgModel first;
+				prototype.instantiate(first, world);
+				first.teardown();
+
+				// The shapes belong to the prototype, not the world
+				world.reset();
+				tgModel second;
+				prototype.instantiate(second, world);
+				expectSame(direct, second, btVector3(0.0, 0.0, 0.0));
+
+				direct.teardown();
+				second.teardown();
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
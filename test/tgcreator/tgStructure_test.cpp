@@ -0,0 +1,140 @@
+/*
+* Copyright © 2012, United States Government, as represented by the
+* Administrator of the National Aeronautics and Space Administration.
+* All rights reserved.
+*
+* The NASA Tensegrity Robotics Toolkit (NTRT) v1 platform is licensed
+* under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+* http://www.apache.org/licenses/LICENSE-2.0.
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+* either express or implied. See the License for the specific language
+* governing permissions and limitations under the License.
+*/
+
+/**
+* @file tgStructure_test.cpp
+* @brief Contains a test of moving and copying tgStructures
+* $Id$
+*/
+
+// This application
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgUtil.h"
+// The Bullet Physics Library
+#include "LinearMath/btQuaternion.h"
+#include "LinearMath/btVector3.h"
+// The C++ Standard Library
+#include <vector>
+// Google Test
+#include "gtest/gtest.h"
+
+
+using namespace std;
+
+namespace {
+
+	class tgStructureTest : public ::testing::Test {
+		protected:
+			
+			tgStructureTest() {
+				segment.addNode(0.0, 0.0, 0.0);
+				segment.addNode(1.0, 0.0, 0.0);
+				segment.addNode(0.0, 1.0, 0.0);
+				segment.addPair(0, 1, "rod");
+			}
+			
+			void expectNear(const btVector3& expected, const btVector3& actual) {
+				EXPECT_NEAR(expected.x(), actual.x(), 1.0e-9);
+				EXPECT_NEAR(expected.y(), actual.y(), 1.0e-9);
+				EXPECT_NEAR(expected.z(), actual.z(), 1.0e-9);
+			}
+			
+			tgStructure segment;
+	};
+
+	TEST_F(tgStructureTest, testMovesApplyInOrder) {
+				
+				tgStructure spine;
+				tgStructure* const pChild = new tgStructure(segment);
+				spine.addChild(pChild);
+				
+				const btQuaternion rotation(btVector3(0.0, 0.0, 1.0), M_PI / 2.0);
+				spine.move(btVector3(1.0, 0.0, 0.0));
+				pChild->addRotation(btVector3(0.0, 0.0, 0.0), rotation);
+				spine.move(btVector3(0.0, 0.0, 3.0));
+				
+				// (1, 0, 0) moved to (2, 0, 0), rotated to (0, 2, 0)
+				expectNear(btVector3(0.0, 2.0, 3.0), pChild->getNodes()[1]);
+				expectNear(btVector3(0.0, 2.0, 3.0),
+						   pChild->getPairs().getPairs()[0].getTo());
+				
+				// The original is untouched
+				expectNear(btVector3(1.0, 0.0, 0.0), segment.getNodes()[1]);
+				
+				// Only moves made after a child is added apply to it
+				spine.addChild(new tgStructure(segment));
+				spine.move(btVector3(0.0, 0.0, 1.0));
+				expectNear(btVector3(1.0, 0.0, 1.0), spine.getChildren()[1]->getNodes()[1]);
+				expectNear(btVector3(0.0, 2.0, 4.0), pChild->getNodes()[1]);
+	}
+
+	TEST_F(tgStructureTest, testPairsFromChildrenStayOnTheirNodes) {
+				
+				tgStructure spine;
+				for (int i = 0; i < 3; i++) {
+					tgStructure* const pChild = new tgStructure(segment);
+					pChild->move(btVector3(0.0, 0.0, 2.0 * i));
+					spine.addChild(pChild);
+				}
+				const vector<tgStructure*>& children = spine.getChildren();
+				for (int i = 1; i < 3; i++) {
+					spine.addPair(children[i - 1]->getNodes()[2],
+								  children[i]->getNodes()[2], "muscle");
+				}
+				
+				spine.addRotation(btVector3(0.0, 1.0, 0.0),
+								  btQuaternion(btVector3(1.0, 1.0, 0.0), 0.3));
+				spine.move(btVector3(5.0, 0.0, 0.0));
+				
+				// Exactly, since the rigids are matched to the connectors that way
+				const vector<tgPair>& pairs = spine.getPairs().getPairs();
+				for (int i = 1; i < 3; i++) {
+					EXPECT_TRUE(pairs[i - 1].getFrom() == children[i - 1]->getNodes()[2]);
+					EXPECT_TRUE(pairs[i - 1].getTo() == children[i]->getNodes()[2]);
+				}
+	}
+
+	TEST_F(tgStructureTest, testCopiesAreIndependent) {
+				
+				tgStructure spine;
+				spine.addChild(new tgStructure(segment));
+				spine.move(btVector3(0.0, 1.0, 0.0));
+				
+				// Copies the children too, so both can be destroyed
+				tgStructure copy(spine);
+				copy.move(btVector3(0.0, 0.0, 1.0));
+				ASSERT_EQ(1u, copy.getChildren().size());
+				expectNear(btVector3(1.0, 1.0, 1.0), copy.getChildren()[0]->getNodes()[1]);
+				expectNear(btVector3(1.0, 1.0, 0.0), spine.getChildren()[0]->getNodes()[1]);
+				
+				// Adding to one doesn't add to the other
+				copy.getChildren()[0]->addNode(0.0, 0.0, 5.0);
+				EXPECT_EQ(4, copy.getChildren()[0]->getNodes().size());
+				EXPECT_EQ(3, spine.getChildren()[0]->getNodes().size());
+				
+				tgStructure assigned;
+				assigned = copy;
+				expectNear(btVector3(1.0, 1.0, 1.0), assigned.getChildren()[0]->getNodes()[1]);
+	}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
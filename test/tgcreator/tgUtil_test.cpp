@@ -40,6 +40,17 @@ using namespace std;
 
 namespace {
 
+	// fuzzyZero allows a residual of about one epsilon, which is 1e-16 in
+	// double precision but too tight for a rotation by pi in single
+	bool nearlyEqual(const btVector3& a, const btVector3& b)
+	{
+#ifdef BT_USE_DOUBLE_PRECISION
+		return (a - b).fuzzyZero();
+#else
+		return (a - b).length() < 1.0e-5 * (1.0 + a.length());
+#endif
+	}
+
 	// The fixture for testing class FileHelpers.
 	class tgUtilTest : public ::testing::Test {
 		protected:
@@ -80,7 +91,7 @@ namespace {
 				btVector3 result = down.rotate(testQuaternion.getAxis(), testQuaternion.getAngle());				
 				
 				// Just comparing the vectors results in a floating point residual, which causes the test to fail
-				EXPECT_TRUE((up - result).fuzzyZero());
+				EXPECT_TRUE(nearlyEqual(up, result));
 				
 				// Test another arbitrary opposite vector
 				btVector3 start(1.0, -1.0, 2.0);
@@ -90,7 +101,7 @@ namespace {
 				
 				result = end.rotate(testQuaternion.getAxis(), testQuaternion.getAngle());	
 
-				EXPECT_TRUE((start - result).fuzzyZero());
+				EXPECT_TRUE(nearlyEqual(start, result));
 	}
 
 } // namespace
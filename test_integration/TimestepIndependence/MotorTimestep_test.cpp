@@ -29,6 +29,12 @@
 // This application
 #include "dev/btietz/timestepTest/tsTestRig.h"
 // This library
+#include "core/tgAdaptiveTimestep.h"
+#include "core/tgCableSubcycler.h"
+#include "core/tgCast.h"
+#include "core/tgKinematicActuator.h"
+#include "core/tgKinematicMotorGroup.h"
+#include "core/tgRod.h"
 #include "core/tgSpringCableActuator.h"
 #include "core/tgModel.h"
 #include "core/tgSimView.h"
@@ -36,9 +42,17 @@
 #include "core/tgSimulation.h"
 #include "core/tgWorld.h"
 #include "helpers/FileHelpers.h"
+#include "tgcreator/tgBuildSpec.h"
+#include "tgcreator/tgKinematicActuatorInfo.h"
+#include "tgcreator/tgRodInfo.h"
+#include "tgcreator/tgStructure.h"
+#include "tgcreator/tgStructureInfo.h"
+// The Bullet Physics library
+#include "LinearMath/btVector3.h"
 // The C++ Standard Library
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <cmath>
 // Google Test
@@ -49,6 +63,56 @@ using namespace std;
 
 namespace {
 
+	/**
+	 * Three rods hanging from fixed rods by kinematic actuators with
+	 * different motors, each reeled in with a different torque
+	 */
+	class MotorGroupRig : public tgModel {
+		public:
+			virtual void setup(tgWorld& world) {
+				tgStructure s;
+				tgBuildSpec spec;
+				spec.addBuilder("rod", new tgRodInfo(tgRod::Config(0.31, 2.0)));
+				spec.addBuilder("fixed", new tgRodInfo(tgRod::Config(0.31, 0.0)));
+				for (int i = 0; i < 3; i++) {
+					s.addNode(10.0 * i, 5.0, 0.0);
+					s.addNode(10.0 * i, 6.0, 0.0);
+					s.addNode(10.0 * i, 15.0, 0.0);
+					s.addNode(10.0 * i, 16.0, 0.0);
+					s.addPair(4 * i, 4 * i + 1, "rod");
+					s.addPair(4 * i + 2, 4 * i + 3, "fixed");
+					
+					std::stringstream tag;
+					tag << "muscle" << i;
+					s.addPair(4 * i + 1, 4 * i + 2, tag.str());
+					// Radius, friction, inertia and backdrivability differ
+					const tgKinematicActuator::Config config(1000.0, 10.0, 0.0,
+															 1.0 - 0.25 * i, 0.1 * i,
+															 1.0 + i, i == 1, true);
+					spec.addBuilder(tag.str(), new tgKinematicActuatorInfo(config));
+				}
+				tgStructureInfo structureInfo(s, spec);
+				structureInfo.buildInto(*this, world);
+				
+				actuators = tgCast::filter<tgModel, tgKinematicActuator>(getDescendants());
+				tgModel::setup(world);
+			}
+			
+			virtual void step(double dt) {
+				for (std::size_t i = 0; i < actuators.size(); i++) {
+					actuators[i]->setControlInput(-400.0 - 100.0 * i);
+				}
+				tgModel::step(dt);
+			}
+			
+			virtual void teardown() {
+				actuators.clear();
+				tgModel::teardown();
+			}
+			
+			std::vector<tgKinematicActuator*> actuators;
+	};
+
 	// The fixture for testing class FileHelpers.
 	class MotorTest : public ::testing::Test {
 		protected:
@@ -214,6 +278,164 @@ namespace {
 				EXPECT_NEAR(thirdLength, finalLength, 0.03); 
 	}
 
+	TEST_F(MotorTest, AdaptiveTimestep) {
+				// First create the world
+				const tgWorld::Config config(981); // gravity, dm/sec^2
+				tgWorld world(config); 
+
+				// Second create the view
+				const double stepSize = 1.0/1000.0; // Seconds
+				const double renderRate = 1.0/60.0; // Seconds
+				tgSimView view(world, stepSize, renderRate);
+
+				// Third create the simulation
+				tgSimulation simulation(view);
+
+				// Fourth create the models with their controllers and add the models to the
+				// simulation
+				bool useKinematic = true;
+				tsTestRig* const myModel = new tsTestRig(useKinematic);
+				
+				simulation.addModel(myModel);
+				
+				// Fixed steps are the reference
+				simulation.run(1000);
+				
+				const std::vector<tgSpringCableActuator*>& testMuscles = myModel->getAllMuscles();
+				
+				// If this fails we've changed the model in unexpected ways
+				ASSERT_EQ(testMuscles.size(), 1);
+				
+				double finalLength = testMuscles[0]->getRestLength();
+				double finalTime = myModel->getTotalTime();
+				
+				// The same second, in steps from 0.2 to 5 ms
+				tgAdaptiveTimestep stepper(tgAdaptiveTimestep::Config(1.0/5000.0, 1.0/200.0));
+				view.setAdaptiveTimestep(&stepper);
+				simulation.reset();
+				simulation.run(1000);
+				
+				const std::vector<tgSpringCableActuator*>& newTestMuscles = myModel->getAllMuscles();
+				
+				// If this fails we've changed the model in unexpected ways
+				ASSERT_EQ(newTestMuscles.size(), 1);
+				EXPECT_FLOAT_EQ(finalTime, myModel->getTotalTime());
+				EXPECT_FLOAT_EQ(finalTime, stepper.getTotalTime());
+				
+				double newLength = newTestMuscles[0]->getRestLength();
+				
+				std::cout << "Original Restlength " << finalLength << " Adaptive restlength: " << newLength
+						  << " in " << stepper.getNumSteps() << " steps" << std::endl;
+				
+				EXPECT_NEAR(finalLength, newLength, 0.03); 
+				
+				view.setAdaptiveTimestep(NULL);
+	}
+
+	TEST_F(MotorTest, SubcycledCables) {
+				// First create the world
+				const tgWorld::Config config(981); // gravity, dm/sec^2
+				tgWorld world(config); 
+
+				// Second create the view
+				const double stepSize = 1.0/1000.0; // Seconds
+				const double renderRate = 1.0/60.0; // Seconds
+				tgSimView view(world, stepSize, renderRate);
+
+				// Third create the simulation
+				tgSimulation simulation(view);
+
+				// Fourth create the models with their controllers and add the models to the
+				// simulation
+				bool useKinematic = true;
+				tsTestRig* const myModel = new tsTestRig(useKinematic);
+				
+				simulation.addModel(myModel);
+				
+				// Fixed steps are the reference
+				simulation.run(1000);
+				
+				const std::vector<tgSpringCableActuator*>& testMuscles = myModel->getAllMuscles();
+				
+				// If this fails we've changed the model in unexpected ways
+				ASSERT_EQ(testMuscles.size(), 1);
+				
+				double finalLength = testMuscles[0]->getRestLength();
+				double finalTime = myModel->getTotalTime();
+				
+				// The same second in 4 ms Bullet steps, the cable still at 1 ms
+				tgCableSubcycler subcycler(4);
+				simulation.setCableSubcycler(&subcycler);
+				simulation.reset();
+				for (int i = 0; i < 250; i++)
+				{
+					simulation.step(4.0 * stepSize);
+				}
+				
+				const std::vector<tgSpringCableActuator*>& newTestMuscles = myModel->getAllMuscles();
+				
+				// If this fails we've changed the model in unexpected ways
+				ASSERT_EQ(newTestMuscles.size(), 1);
+				EXPECT_EQ(subcycler.getNumActuators(), 1);
+				EXPECT_FLOAT_EQ(finalTime, myModel->getTotalTime());
+				
+				double newLength = newTestMuscles[0]->getRestLength();
+				
+				std::cout << "Original Restlength " << finalLength << " Subcycled restlength: " << newLength << std::endl;
+				
+				EXPECT_NEAR(finalLength, newLength, 0.03); 
+				
+				simulation.setCableSubcycler(NULL);
+				EXPECT_FALSE(newTestMuscles[0]->isSubcycled());
+	}
+
+	TEST_F(MotorTest, KinematicMotorGroup) {
+				// The same motors in two worlds, one integrated by the group
+				const double stepSize = 1.0/1000.0; // Seconds
+				const tgWorld::Config config(981); // gravity, dm/sec^2
+				
+				tgWorld world(config);
+				tgSimView view(world, stepSize);
+				tgSimulation simulation(view);
+				MotorGroupRig* const model = new MotorGroupRig();
+				simulation.addModel(model);
+				
+				tgWorld groupedWorld(config);
+				tgSimView groupedView(groupedWorld, stepSize);
+				tgSimulation groupedSimulation(groupedView);
+				MotorGroupRig* const groupedModel = new MotorGroupRig();
+				groupedSimulation.addModel(groupedModel);
+				tgKinematicMotorGroup group;
+				groupedSimulation.setKinematicMotorGroup(&group);
+				
+				// If this fails we've changed the model in unexpected ways
+				ASSERT_EQ(model->actuators.size(), 3);
+				ASSERT_EQ(groupedModel->actuators.size(), 3);
+				
+				for (int step = 0; step < 1000; step++) {
+					simulation.step(stepSize);
+					groupedSimulation.step(stepSize);
+					ASSERT_EQ(group.getNumActuators(), 3);
+					
+					// The same arithmetic in the same order, so bitwise
+					for (std::size_t i = 0; i < 3; i++) {
+						const tgKinematicActuator& actuator = *model->actuators[i];
+						const tgKinematicActuator& grouped = *groupedModel->actuators[i];
+						EXPECT_EQ(actuator.getVelocity(), grouped.getVelocity());
+						EXPECT_EQ(actuator.getRestLength(), grouped.getRestLength());
+						// The history's tension is the applied torque
+						EXPECT_EQ(actuator.getHistory().tensionHistory.back(),
+								  grouped.getHistory().tensionHistory.back());
+					}
+				}
+				
+				// The motors moved
+				EXPECT_LT(model->actuators[0]->getRestLength(), 9.0);
+				
+				groupedSimulation.setKinematicMotorGroup(NULL);
+				EXPECT_FALSE(groupedModel->actuators[0]->isGrouped());
+	}
+
 } // namespace
 
 int main(int argc, char **argv) {